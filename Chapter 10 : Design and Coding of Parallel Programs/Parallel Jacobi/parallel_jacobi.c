@@ -0,0 +1,281 @@
+/*
+ * parallel_jacobi.c
+ *
+ *  Created on: 16-Oct-2026
+ *      Author: prateek
+ *      Pg : 220
+ *      Desc : Jacobi's method for Ax = b, as chap10/parallel_jacobi.c, with the
+ *      	block rows of A in a DENSE_MATRIX_T so that n is not limited by MAX_DIM,
+ *      	and A x done by Mat_vec_ring while x is being gathered.
+ *      Input :
+ *      	n : order of the system
+ *      	tol : convergence tolerance
+ *      	max_iter : maximum number of iterations
+ *      Output :
+ *      	The no of iterations, the time per iteration, the first entries of x and
+ *      	the largest error against the exact solution, or max_iter if the method
+ *      	does not converge.
+ *
+ *      Algorithm:
+ *      1) Process r gets block row r of A and block r of b; the first n % p
+ *         processes get one row more. x starts as b, gathered on everyone.
+ *      2) In every iteration each process computes its block of
+ *            x_new = x_old + D^-1 (b - A x_old)
+ *         which is the book's update
+ *            x_new(i) = (b(i) - sum over j != i of A(i,j) x_old(j)) / A(i,i)
+ *         written so that all of A x_old is one matrix-vector product.
+ *      3) The product is Mat_vec_ring : the blocks of x_old go round a ring and
+ *         each one is multiplied while the next is on its way.
+ *      4) Stop when ||x_new - x_old|| < tol or after max_iter iterations.
+ *
+ *      NOTES:
+ *      	1. A is generated : A(i,j) = (i + 2j) % 7 - 3 off the diagonal and
+ *      	   A(i,i) = 3n + 1, so A is strongly diagonally dominant. b = A x* with
+ *      	   x*(i) = 1 + i % 3, so the error can be checked.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <mpi/mpi.h>
+#include "overlap_mat_vec.h"
+
+#define Swap(x,y) {float* temp; temp = x; x = y; y = temp;}
+
+#define PRINT_ENTRIES	8
+
+void Get_data(int *n_ptr, float *tol_ptr, int *max_iter_ptr, int my_rank);
+void Block_range(int n, int no_of_blocks, int block, int *first_ptr, int *count_ptr);
+void Generate_system(DENSE_MATRIX_T *A_local, float diagonal[], float b_local[], int first_row, int n);
+int Parallel_jacobi(const DENSE_MATRIX_T *A_local, const float diagonal[], const float b_local[], int first_row,
+		float tol, int max_iter, const int counts[], const int displacements[], float x[],
+		int *iterations_ptr);
+
+int main(int argc, char **argv)
+{
+	int my_rank;
+	int p;
+	int n;
+	float tol;
+	int max_iter;
+	int local_n, first_row;
+	int *counts, *displacements;
+	DENSE_MATRIX_T *A_local;
+	float *diagonal, *b_local, *x;
+	int converged, iterations;
+	float max_error = 0.0f;
+	double start, elapsed, seconds;
+	int ok, all_ok;
+	int rank, i;
+
+	MPI_Init(&argc, &argv);
+	MPI_Comm_size(MPI_COMM_WORLD, &p);
+	MPI_Comm_rank(MPI_COMM_WORLD, &my_rank);
+
+	Get_data(&n, &tol, &max_iter, my_rank);
+
+	Block_range(n, p, my_rank, &first_row, &local_n);
+	counts = malloc(p * sizeof(int));
+	displacements = malloc(p * sizeof(int));
+	for( rank = 0 ; rank < p ; rank++ )
+	{
+		Block_range(n, p, rank, &displacements[rank], &counts[rank]);
+	}
+
+	A_local = Dense_matrix_allocate(local_n, n);
+	diagonal = malloc((local_n + 1) * sizeof(float));
+	b_local = malloc((local_n + 1) * sizeof(float));
+	x = malloc((n + 1) * sizeof(float));
+	ok = (A_local != NULL);
+	MPI_Allreduce(&ok, &all_ok, 1, MPI_INT, MPI_MIN, MPI_COMM_WORLD);
+	if( !all_ok )
+	{
+		if( my_rank == 0 )
+		{
+			fprintf(stderr, "Cannot allocate the matrix \n");
+		}
+		MPI_Abort(MPI_COMM_WORLD, 1);
+	}
+
+	Generate_system(A_local, diagonal, b_local, first_row, n);
+
+	MPI_Barrier(MPI_COMM_WORLD);
+	start = MPI_Wtime();
+	converged = Parallel_jacobi(A_local, diagonal, b_local, first_row, tol, max_iter, counts, displacements,
+			x, &iterations);
+	elapsed = MPI_Wtime() - start;
+	MPI_Reduce(&elapsed, &seconds, 1, MPI_DOUBLE, MPI_MAX, 0, MPI_COMM_WORLD);
+
+	if( my_rank == 0 )
+	{
+		if( converged )
+		{
+			for( i = 0 ; i < n ; i++ )
+			{
+				if( fabsf(x[i] - (float) (1 + i % 3)) > max_error )
+				{
+					max_error = fabsf(x[i] - (float) (1 + i % 3));
+				}
+			}
+			printf("Converged in %d iterations , %e s per iteration \n", iterations, seconds / iterations);
+			printf("The solution starts");
+			for( i = 0 ; i < n && i < PRINT_ENTRIES ; i++ )
+			{
+				printf(" %4.3f", x[i]);
+			}
+			printf("\nLargest error = %e \n", max_error);
+		}
+		else
+		{
+			printf("Failed to converge in %d iterations\n", max_iter);
+		}
+	}
+
+	Dense_matrix_free(&A_local);
+	free(diagonal);
+	free(b_local);
+	free(x);
+	free(counts);
+	free(displacements);
+	MPI_Finalize();
+
+	return 0;
+}
+
+/*
+ * Process 0 reads n, the tolerance and max_iter and broadcasts them
+ */
+void Get_data(int *n_ptr,	/* out */
+			float *tol_ptr,	/* out */
+			int *max_iter_ptr,	/* out */
+			int my_rank		/* in */
+			)
+{
+	if( my_rank == 0 )
+	{
+		printf("Enter n, tolerance, and max number of iterations\n");
+		scanf("%d %f %d", n_ptr, tol_ptr, max_iter_ptr);
+	}
+
+	MPI_Bcast(n_ptr, 1, MPI_INT, 0, MPI_COMM_WORLD);
+	MPI_Bcast(tol_ptr, 1, MPI_FLOAT, 0, MPI_COMM_WORLD);
+	MPI_Bcast(max_iter_ptr, 1, MPI_INT, 0, MPI_COMM_WORLD);
+}
+
+/*
+ * First index and length of block number block of n split into no_of_blocks.
+ * The first n % no_of_blocks blocks get one more.
+ */
+void Block_range(int n,			/* in */
+			int no_of_blocks,	/* in */
+			int block,			/* in */
+			int *first_ptr,		/* out */
+			int *count_ptr		/* out */
+			)
+{
+	int quotient = n / no_of_blocks;
+	int remainder = n % no_of_blocks;
+
+	*count_ptr = quotient + (block < remainder ? 1 : 0);
+	*first_ptr = block * quotient + (block < remainder ? block : remainder);
+}
+
+/*
+ * My rows of A, their diagonal entries and b = A x* ( see NOTES )
+ */
+void Generate_system(DENSE_MATRIX_T *A_local,	/* out */
+			float diagonal[],				/* out */
+			float b_local[],				/* out */
+			int first_row,					/* in */
+			int n							/* in */
+			)
+{
+	double b_i;
+	int i, j, i_global;
+
+	for( i = 0 ; i < A_local->rows ; i++ )
+	{
+		i_global = first_row + i;
+		b_i = 0.0;
+		for( j = 0 ; j < n ; j++ )
+		{
+			Entry(A_local, i, j) = (j == i_global) ? (float) (3 * n + 1) : (float) ((i_global + 2 * j) % 7 - 3);
+			b_i += (double) Entry(A_local, i, j) * (1 + j % 3);
+		}
+		diagonal[i] = Entry(A_local, i, i_global);
+		b_local[i] = (float) b_i;
+	}
+}
+
+/*********************************************************************/
+/* Function Parallel_jacobi
+ * Returns 1 if the iteration converged, 0 otherwise. x is the whole
+ * solution on every process.
+ * Mat_vec_ring gathers x_old while it multiplies, so each iteration
+ * only needs my block of x_new and the squared distance, which is
+ * added up with an MPI_Allreduce of one float.
+ *********************************************************************/
+int Parallel_jacobi(const DENSE_MATRIX_T *A_local,	/* in */
+			const float diagonal[],				/* in */
+			const float b_local[],				/* in */
+			int first_row,						/* in */
+			float tol,							/* in */
+			int max_iter,						/* in */
+			const int counts[],					/* in */
+			const int displacements[],			/* in */
+			float x[],							/* out */
+			int *iterations_ptr					/* out */
+			)
+{
+	int local_n = A_local->rows;
+	float *x_temp1, *x_temp2;
+	float *x_old, *x_new;		// My blocks of x
+	float *Ax_local;
+	float local_sum, sum;
+	float distance;
+	int iter_num;
+	int i_local;
+
+	x_temp1 = malloc((local_n + 1) * sizeof(float));
+	x_temp2 = malloc((local_n + 1) * sizeof(float));
+	Ax_local = malloc((local_n + 1) * sizeof(float));
+
+	/* Initialize x */
+	for( i_local = 0 ; i_local < local_n ; i_local++ )
+	{
+		x_temp1[i_local] = b_local[i_local];
+	}
+	x_new = x_temp1;
+	x_old = x_temp2;
+
+	iter_num = 0;
+	do
+	{
+		iter_num++;
+
+		/* Interchange x_old and x_new */
+		Swap(x_old, x_new);
+
+		/* x gets all of x_old */
+		Mat_vec_ring(A_local, x_old, counts, displacements, x, Ax_local, MPI_COMM_WORLD);
+
+		local_sum = 0.0;
+		for( i_local = 0 ; i_local < local_n ; i_local++ )
+		{
+			x_new[i_local] = x[first_row + i_local]
+					+ (b_local[i_local] - Ax_local[i_local]) / diagonal[i_local];
+			local_sum = local_sum + (x_new[i_local] - x_old[i_local])*(x_new[i_local] - x_old[i_local]);
+		}
+
+		MPI_Allreduce(&local_sum, &sum, 1, MPI_FLOAT, MPI_SUM, MPI_COMM_WORLD);
+		distance = sqrt(sum);
+	} while( (iter_num < max_iter) && (distance >= tol) );
+
+	*iterations_ptr = iter_num;
+	MPI_Allgatherv(x_new, local_n, MPI_FLOAT, x, counts, displacements, MPI_FLOAT, MPI_COMM_WORLD);
+
+	free(x_temp1);
+	free(x_temp2);
+	free(Ax_local);
+
+	return distance < tol;
+}
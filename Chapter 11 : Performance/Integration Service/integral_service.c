@@ -0,0 +1,357 @@
+/*
+ * integral_service.c
+ *
+ *  Created on: 16-Oct-2026
+ *      Author: prateek
+ *      Desc : Resident integration service built on the trapezoidal rule of
+ *      	chap11/parallel_trap.c. MPI is started once and then serves a stream of jobs.
+ *      Input :
+ *      	One job per line on the standard input of process 0 (a pipe or a file) :
+ *      	a , b and n. The stream ends at end of file.
+ *      Output :
+ *      	Every integral as soon as it is done with its latency (from the time the
+ *      	job was read to the time its result came back), then the no of jobs,
+ *      	jobs/second and the mean and max latency.
+ *
+ *      Algorithm:
+ *      1) Process 0 is the manager and the I/O process. It reads the jobs with Cscanf
+ *         on io_comm, a communicator holding process 0 alone, so the workers never
+ *         take part in the reads.
+ *      2) Every pass the manager first prints the results that came back, with
+ *         MPI_Testsome, or with MPI_Waitsome when every worker is busy or the input
+ *         is used up. Cheap and expensive jobs therefore never hold each other up.
+ *      3) Then, if a worker is idle, it reads one job, sends it with MPI_Isend and
+ *         posts an MPI_Irecv for its result. While jobs are running it only reads
+ *         once poll says input is there, so a client that sends a job and waits
+ *         for its answer gets it.
+ *      4) At end of input the manager waits for the jobs still running and sends
+ *         STOP_TAG to every worker.
+ *
+ *      NOTES:
+ *      	1. f(x) is hardwired.
+ *      	2. Each job is integrated by one worker; parallelism comes from running
+ *      	   many jobs at once. With one process the manager does the jobs itself.
+ *      	3. stdin is unbuffered, so no line can sit in the stdio buffer where poll
+ *      	   does not see it. That costs a read per character, nothing next to a
+ *      	   job. A line that has started is read to its end.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stddef.h>
+#include <poll.h>
+#include <mpi/mpi.h>
+#include "cio.h"
+
+#define JOB_TAG		1
+#define RESULT_TAG	2
+#define STOP_TAG	3
+
+#define POLL_MS		1	/* Longest wait for input while jobs are running */
+
+/* One integration request */
+typedef struct {
+	float a;
+	float b;
+	int n;
+	int id;
+} JOB_T;
+
+/* What the manager remembers about a job that is running */
+typedef struct {
+	JOB_T job;
+	double read_time;		// When the job was read
+	float result;			// Filled in by MPI_Irecv
+	MPI_Request send_request;
+	MPI_Request recv_request;
+} RUNNING_JOB_T;
+
+void Build_job_type(MPI_Datatype *job_mpi_t_ptr);
+void Manager(MPI_Comm io_comm, int no_of_process, MPI_Datatype job_mpi_t);
+void Worker(MPI_Datatype job_mpi_t);
+int Read_job(MPI_Comm io_comm, JOB_T *job);
+int Input_ready(int timeout_ms);
+void Report_job(JOB_T *job, float result, double latency);
+float Trap(float local_a, float local_b, int local_n, float h);
+float f(float x);
+
+int main(int argc, char **argv)
+{
+	int my_rank;			// My process rank
+	int no_of_process;		// No of processes
+	MPI_Comm io_comm;		// Process 0 alone
+	MPI_Datatype job_mpi_t;
+
+	MPI_Init(&argc, &argv);
+	MPI_Comm_rank(MPI_COMM_WORLD, &my_rank);
+	MPI_Comm_size(MPI_COMM_WORLD, &no_of_process);
+
+	/* Only process 0 reads, so give it a communicator of its own */
+	MPI_Comm_split(MPI_COMM_WORLD, (my_rank == 0) ? 0 : MPI_UNDEFINED, 0, &io_comm);
+
+	Build_job_type(&job_mpi_t);
+
+	if( my_rank == 0 )
+	{
+		Cache_io_rank(MPI_COMM_WORLD, io_comm);
+		Manager(io_comm, no_of_process, job_mpi_t);
+		MPI_Comm_free(&io_comm);
+	}
+	else
+	{
+		Worker(job_mpi_t);
+	}
+
+	MPI_Type_free(&job_mpi_t);
+	MPI_Finalize();
+
+	return 0;
+}
+
+/********************************************************************/
+/* Function Build_job_type
+ * Builds a derived datatype matching JOB_T
+ ********************************************************************/
+void Build_job_type(MPI_Datatype *job_mpi_t_ptr	/* out */)
+{
+	int block_lengths[4] = { 1, 1, 1, 1 };
+	MPI_Datatype typelist[4] = { MPI_FLOAT, MPI_FLOAT, MPI_INT, MPI_INT };
+	MPI_Aint displacements[4] = { offsetof(JOB_T, a), offsetof(JOB_T, b),
+			offsetof(JOB_T, n), offsetof(JOB_T, id) };
+	MPI_Datatype struct_mpi_t;
+
+	MPI_Type_create_struct(4, block_lengths, displacements, typelist, &struct_mpi_t);
+	MPI_Type_create_resized(struct_mpi_t, 0, sizeof(JOB_T), job_mpi_t_ptr);
+	MPI_Type_commit(job_mpi_t_ptr);
+	MPI_Type_free(&struct_mpi_t);
+}
+
+/********************************************************************/
+/* Function Manager
+ * Reads jobs until end of input and keeps every worker busy with them.
+ * Prints every result as it arrives and the throughput at the end.
+ ********************************************************************/
+void Manager(MPI_Comm io_comm,		/* in */
+			int no_of_process,		/* in */
+			MPI_Datatype job_mpi_t	/* in */
+			)
+{
+	int no_of_workers = no_of_process - 1;
+	RUNNING_JOB_T *running = NULL;		// running[w-1] is the job of worker w
+	MPI_Request *recv_requests = NULL;	// Result requests, indexed like running[]
+	int *idle = NULL;
+	int *finished = NULL;				// Workers whose results came back
+	int no_finished;
+	int busy = 0;
+	int input_left = 1;
+	int jobs_done = 0;
+	double latency;
+	double total_latency = 0.0;
+	double max_latency = 0.0;
+	double start, now;
+	float result;
+	JOB_T job;
+	int w, k;
+
+	start = MPI_Wtime();
+
+	if( no_of_workers == 0 )
+	{
+		/* Nobody to hand the jobs to */
+		while( Read_job(io_comm, &job) )
+		{
+			now = MPI_Wtime();
+			result = Trap(job.a, job.b, job.n, (job.b - job.a) / job.n);
+			latency = MPI_Wtime() - now;
+			Report_job(&job, result, latency);
+			total_latency += latency;
+			max_latency = (latency > max_latency) ? latency : max_latency;
+			jobs_done++;
+		}
+	}
+	else
+	{
+		running = malloc(no_of_workers * sizeof(RUNNING_JOB_T));
+		recv_requests = malloc(no_of_workers * sizeof(MPI_Request));
+		idle = malloc(no_of_workers * sizeof(int));
+		finished = malloc(no_of_workers * sizeof(int));
+		for( w = 0 ; w < no_of_workers ; w++ )
+		{
+			idle[w] = 1;
+			recv_requests[w] = MPI_REQUEST_NULL;
+		}
+
+		/* No hidden read ahead, so poll on the descriptor sees every line
+		 * Read_job has not taken yet */
+		setvbuf(stdin, NULL, _IONBF, 0);
+
+		while( input_left || busy > 0 )
+		{
+			/* Report what has finished : without waiting while a worker is
+			 * idle and there may be more input, else wait for one */
+			no_finished = 0;
+			if( busy > 0 )
+			{
+				if( input_left && busy < no_of_workers )
+				{
+					MPI_Testsome(no_of_workers, recv_requests, &no_finished, finished, MPI_STATUSES_IGNORE);
+				}
+				else
+				{
+					MPI_Waitsome(no_of_workers, recv_requests, &no_finished, finished, MPI_STATUSES_IGNORE);
+				}
+			}
+			for( k = 0 ; k < no_finished ; k++ )
+			{
+				w = finished[k];
+				MPI_Wait(&running[w].send_request, MPI_STATUS_IGNORE);
+				latency = MPI_Wtime() - running[w].read_time;
+				Report_job(&running[w].job, running[w].result, latency);
+				total_latency += latency;
+				max_latency = (latency > max_latency) ? latency : max_latency;
+				jobs_done++;
+				idle[w] = 1;
+				busy--;
+			}
+
+			/* At most one new job per pass. Block on the input only when no
+			 * job is running, or a line is on its way */
+			if( !input_left || busy == no_of_workers || (busy > 0 && !Input_ready(POLL_MS)) )
+			{
+				continue;
+			}
+			for( w = 0 ; !idle[w] ; w++ )
+				;
+			if( !Read_job(io_comm, &running[w].job) )
+			{
+				input_left = 0;
+				continue;
+			}
+			running[w].read_time = MPI_Wtime();
+			MPI_Isend(&running[w].job, 1, job_mpi_t, w + 1, JOB_TAG, MPI_COMM_WORLD, &running[w].send_request);
+			MPI_Irecv(&running[w].result, 1, MPI_FLOAT, w + 1, RESULT_TAG, MPI_COMM_WORLD, &recv_requests[w]);
+			idle[w] = 0;
+			busy++;
+		}
+
+		/* No more jobs : let the workers go */
+		for( w = 1 ; w <= no_of_workers ; w++ )
+		{
+			MPI_Send(&job, 0, job_mpi_t, w, STOP_TAG, MPI_COMM_WORLD);
+		}
+
+		free(running);
+		free(recv_requests);
+		free(idle);
+		free(finished);
+	}
+
+	now = MPI_Wtime();
+	printf("Jobs done = %d in %e seconds , %f jobs/second \n", jobs_done, now - start,
+			(now > start) ? jobs_done / (now - start) : 0.0);
+	if( jobs_done > 0 )
+	{
+		printf("Latency in seconds : mean = %e , max = %e \n", total_latency / jobs_done, max_latency);
+	}
+}
+
+/********************************************************************/
+/* Function Worker
+ * Integrates the jobs it is sent until it gets STOP_TAG.
+ ********************************************************************/
+void Worker(MPI_Datatype job_mpi_t	/* in */)
+{
+	JOB_T job;
+	float result;
+	MPI_Status status;
+
+	while( 1 )
+	{
+		MPI_Recv(&job, 1, job_mpi_t, 0, MPI_ANY_TAG, MPI_COMM_WORLD, &status);
+		if( status.MPI_TAG == STOP_TAG )
+		{
+			break;
+		}
+
+		result = Trap(job.a, job.b, job.n, (job.b - job.a) / job.n);
+		MPI_Send(&result, 1, MPI_FLOAT, 0, RESULT_TAG, MPI_COMM_WORLD);
+	}
+}
+
+/*
+ * Read the next valid job. Lines that are not "a b n" with n > 0,
+ * blank ones included, are skipped. Returns 0 at end of input.
+ */
+int Read_job(MPI_Comm io_comm,	/* in */
+			JOB_T *job			/* out */
+			)
+{
+	static int next_id = 0;
+	int count;
+
+	while( (count = Cscanf(io_comm, NULL, "%f %f %d", &job->a, &job->b, &job->n)) != EOF )
+	{
+		if( count == 3 && job->n > 0 )
+		{
+			job->id = next_id++;
+			return 1;
+		}
+	}
+
+	return 0;
+}
+
+/*
+ * 1 if a line ( or the end of input ) is there to read on stdin, waiting
+ * at most timeout_ms for it. Errors count as ready : Read_job meets them
+ */
+int Input_ready(int timeout_ms	/* in */)
+{
+	struct pollfd input = { fileno(stdin), POLLIN, 0 };
+
+	return poll(&input, 1, timeout_ms) != 0;
+}
+
+/*
+ * Write one result back
+ */
+void Report_job(JOB_T *job,	/* in */
+			float result,	/* in */
+			double latency	/* in */
+			)
+{
+	printf("Job %d : integral from %f to %f with n = %d = %f , latency = %e s \n",
+			job->id, job->a, job->b, job->n, result, latency);
+	fflush(stdout);
+}
+
+/*
+ * Serial trapezoidal rule, as in chap11/parallel_trap.c
+ */
+float Trap(float local_a,	/* in */
+			float local_b,	/* in */
+			int local_n,	/* in */
+			float h			/* in */
+			)
+{
+	float integral;		// Store result of integral
+	float x;
+	int i;
+
+	integral = ( f(local_a) + f(local_b)) / 2.0;
+	x = local_a;
+
+	for( i = 1 ; i <= local_n-1 ; i++ )
+	{
+		x = x+h;
+		integral = integral + f(x);
+	}
+
+	integral = integral * h;
+	return integral;
+}
+
+// f(x) = x^2
+float f(float x)
+{
+	return (x*x);
+}
@@ -0,0 +1,179 @@
+/*
+ * mat_vec_overlap.c
+ *
+ *  Created on: 16-Oct-2026
+ *      Author: prateek
+ *      Desc : Times the row panel matrix-vector product with a blocking
+ *      	MPI_Allgatherv of x against the two overlapped versions of
+ *      	overlap_mat_vec.c.
+ *      Input :
+ *      	m, n : order of the matrix
+ *      Output :
+ *      	For each version the time of one product (slowest process) and whether
+ *      	its y matches the blocking version.
+ *
+ *      NOTES:
+ *      	1. A(i,j) = (i + 2j) % 7 - 3 and x(j) = j % 5 - 2, so every sum is an
+ *      	   integer, exact in float in any order.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <mpi/mpi.h>
+#include "overlap_mat_vec.h"
+
+#define REPS	20
+
+typedef void (*MAT_VEC_FN)(const DENSE_MATRIX_T *, const float [], const int [], const int [], float [], float [],
+		MPI_Comm);
+
+static const struct {
+	char name[16];
+	MAT_VEC_FN mat_vec;
+} methods[] = {
+	{ "blocking",	Mat_vec_blocking },
+	{ "iallgather",	Mat_vec_iallgather },
+	{ "ring",		Mat_vec_ring },
+};
+#define NO_OF_METHODS	((int) (sizeof(methods) / sizeof(methods[0])))
+
+void Get_data(int *m_ptr, int *n_ptr, int my_rank);
+void Block_range(int n, int no_of_blocks, int block, int *first_ptr, int *count_ptr);
+
+int main(int argc, char **argv)
+{
+	int my_rank;
+	int no_of_process;
+	int m, n;
+	int local_m, first_row, local_n, first_col;
+	int *counts, *displacements;
+	DENSE_MATRIX_T *local_A;
+	float *local_x, *global_x, *y_reference, *local_y;
+	double start, elapsed, seconds;
+	int ok, all_ok;
+	int method, rank, rep, i, j;
+
+	MPI_Init(&argc, &argv);
+	MPI_Comm_rank(MPI_COMM_WORLD, &my_rank);
+	MPI_Comm_size(MPI_COMM_WORLD, &no_of_process);
+
+	Get_data(&m, &n, my_rank);
+
+	Block_range(m, no_of_process, my_rank, &first_row, &local_m);
+	Block_range(n, no_of_process, my_rank, &first_col, &local_n);
+	counts = malloc(no_of_process * sizeof(int));
+	displacements = malloc(no_of_process * sizeof(int));
+	for( rank = 0 ; rank < no_of_process ; rank++ )
+	{
+		Block_range(n, no_of_process, rank, &displacements[rank], &counts[rank]);
+	}
+
+	local_A = Dense_matrix_allocate(local_m, n);
+	local_x = malloc((local_n + 1) * sizeof(float));
+	global_x = malloc((n + 1) * sizeof(float));
+	y_reference = malloc((local_m + 1) * sizeof(float));
+	local_y = malloc((local_m + 1) * sizeof(float));
+	ok = (local_A != NULL);
+	MPI_Allreduce(&ok, &all_ok, 1, MPI_INT, MPI_MIN, MPI_COMM_WORLD);
+	if( !all_ok )
+	{
+		if( my_rank == 0 )
+		{
+			fprintf(stderr, "Cannot allocate the matrix \n");
+		}
+		MPI_Abort(MPI_COMM_WORLD, 1);
+	}
+
+	for( i = 0 ; i < local_m ; i++ )
+	{
+		for( j = 0 ; j < n ; j++ )
+		{
+			Entry(local_A, i, j) = (float) ((first_row + i + 2 * j) % 7 - 3);
+		}
+	}
+	for( j = 0 ; j < local_n ; j++ )
+	{
+		local_x[j] = (float) ((first_col + j) % 5 - 2);
+	}
+
+	Mat_vec_blocking(local_A, local_x, counts, displacements, global_x, y_reference, MPI_COMM_WORLD);
+
+	if( my_rank == 0 )
+	{
+		printf("m = %d , n = %d , p = %d \n", m, n, no_of_process);
+	}
+	for( method = 0 ; method < NO_OF_METHODS ; method++ )
+	{
+		MPI_Barrier(MPI_COMM_WORLD);
+		start = MPI_Wtime();
+		for( rep = 0 ; rep < REPS ; rep++ )
+		{
+			methods[method].mat_vec(local_A, local_x, counts, displacements, global_x, local_y, MPI_COMM_WORLD);
+		}
+		elapsed = (MPI_Wtime() - start) / REPS;
+		MPI_Reduce(&elapsed, &seconds, 1, MPI_DOUBLE, MPI_MAX, 0, MPI_COMM_WORLD);
+
+		ok = 1;
+		for( i = 0 ; i < local_m ; i++ )
+		{
+			ok &= (local_y[i] == y_reference[i]);
+		}
+		for( j = 0 ; j < n ; j++ )
+		{
+			ok &= (global_x[j] == (float) (j % 5 - 2));
+		}
+		MPI_Reduce(&ok, &all_ok, 1, MPI_INT, MPI_MIN, 0, MPI_COMM_WORLD);
+
+		if( my_rank == 0 )
+		{
+			printf("%-10s : %e s per product , y %s \n", methods[method].name, seconds,
+					all_ok ? "matches" : "DIFFERS");
+		}
+	}
+
+	Dense_matrix_free(&local_A);
+	free(local_x);
+	free(global_x);
+	free(y_reference);
+	free(local_y);
+	free(counts);
+	free(displacements);
+	MPI_Finalize();
+
+	return 0;
+}
+
+/*
+ * Process 0 reads the order of the matrix and broadcasts it
+ */
+void Get_data(int *m_ptr,	/* out */
+			int *n_ptr,		/* out */
+			int my_rank		/* in */
+			)
+{
+	if( my_rank == 0 )
+	{
+		printf("Enter the order of the matrix (m x n)\n");
+		scanf("%d %d", m_ptr, n_ptr);
+	}
+
+	MPI_Bcast(m_ptr, 1, MPI_INT, 0, MPI_COMM_WORLD);
+	MPI_Bcast(n_ptr, 1, MPI_INT, 0, MPI_COMM_WORLD);
+}
+
+/*
+ * First index and length of block number block of n split into no_of_blocks.
+ * The first n % no_of_blocks blocks get one more.
+ */
+void Block_range(int n,			/* in */
+			int no_of_blocks,	/* in */
+			int block,			/* in */
+			int *first_ptr,		/* out */
+			int *count_ptr		/* out */
+			)
+{
+	int quotient = n / no_of_blocks;
+	int remainder = n % no_of_blocks;
+
+	*count_ptr = quotient + (block < remainder ? 1 : 0);
+	*first_ptr = block * quotient + (block < remainder ? block : remainder);
+}
@@ -0,0 +1,184 @@
+/*
+ * overlap_mat_vec.c
+ *
+ *  Created on: 16-Oct-2026
+ *      Author: prateek
+ *      Desc : Row panel matrix-vector products that hide the gather of x.
+ *      	In Parallel_matrix_vector_prod ( chap05/parallel_mat_vect.c ) every
+ *      	process waits in MPI_Allgather before it multiplies anything. But the
+ *      	product splits by the blocks of x :
+ *
+ *      		local_y = sum over q of ( columns of block q of local_A ) * ( block q of x )
+ *
+ *      	so each block of x can be used as soon as it is here.
+ *
+ *      	Mat_vec_iallgather starts an MPI_Iallgatherv and multiplies by my own
+ *      	block of x ( the diagonal block of the panel ) while it runs.
+ *
+ *      	Mat_vec_ring passes the blocks round a ring as in chap13/ag_ring_nblk.c.
+ *      	In step i process r sends block r-i to r+1 and receives block r-i-1 from
+ *      	r-1, and meanwhile multiplies by block r-i, which it already has :
+ *
+ *      		step 0 : multiply by x_r      , receive x_(r-1)
+ *      		step 1 : multiply by x_(r-1)  , receive x_(r-2)
+ *      		...
+ *      		last   : multiply by x_(r+1)
+ *
+ *      NOTES:
+ *      	1. Without a progress thread an MPI implementation moves nonblocking
+ *      	   messages on only inside MPI calls, so the multiplications are cut into
+ *      	   pieces of OVERLAP_ROWS rows by OVERLAP_COLS columns with an MPI_Testall
+ *      	   after each one.
+ */
+#include <string.h>
+#include "overlap_mat_vec.h"
+
+#define OVERLAP_ROWS	256		/* Rows per piece of work */
+#define OVERLAP_COLS	2048	/* Columns per piece of work : 8 KB of x */
+
+/********************************************************************/
+/* Function Multiply_columns
+ * local_y += columns col_start .. col_start + no_of_cols - 1 of local_A
+ * times x_block, in pieces, testing the requests after each piece.
+ ********************************************************************/
+static void Multiply_columns(const DENSE_MATRIX_T *local_A,	/* in */
+			int col_start,					/* in */
+			int no_of_cols,					/* in */
+			const float x_block[],			/* in */
+			float local_y[],				/* in/out */
+			int no_of_requests,				/* in */
+			MPI_Request requests[]			/* in/out */
+			)
+{
+	DENSE_MATRIX_T rows;	// Rows first_row .. of local_A, sharing its entries
+	int first_row, first_col, cols;
+	int flag;
+
+	rows = *local_A;
+	for( first_col = 0 ; first_col < no_of_cols ; first_col += OVERLAP_COLS )
+	{
+		cols = (no_of_cols - first_col < OVERLAP_COLS) ? no_of_cols - first_col : OVERLAP_COLS;
+		for( first_row = 0 ; first_row < local_A->rows ; first_row += OVERLAP_ROWS )
+		{
+			rows.rows = (local_A->rows - first_row < OVERLAP_ROWS) ? local_A->rows - first_row : OVERLAP_ROWS;
+			rows.entries = Row(local_A, first_row);
+			Dense_gemv_block(&rows, col_start + first_col, cols, &x_block[first_col], &local_y[first_row]);
+
+			if( no_of_requests > 0 )
+			{
+				MPI_Testall(no_of_requests, requests, &flag, MPI_STATUSES_IGNORE);
+			}
+		}
+	}
+}
+
+/*
+ * MPI_Allgatherv, then the whole product
+ */
+void Mat_vec_blocking(const DENSE_MATRIX_T *local_A,	/* in */
+			const float local_x[],			/* in */
+			const int counts[],				/* in */
+			const int displacements[],		/* in */
+			float global_x[],				/* out */
+			float local_y[],				/* out */
+			MPI_Comm comm					/* in */
+			)
+{
+	int my_rank;
+
+	MPI_Comm_rank(comm, &my_rank);
+	MPI_Allgatherv(local_x, counts[my_rank], MPI_FLOAT, global_x, counts, displacements, MPI_FLOAT, comm);
+	Dense_gemv(local_A, global_x, local_y);
+}
+
+/********************************************************************/
+/* Function Mat_vec_iallgather
+ * Algorithm:
+ *     1.  Start the MPI_Iallgatherv of x.
+ *     2.  Multiply by my own block of x, straight from local_x.
+ *     3.  Wait for the gather, then multiply by the blocks before and
+ *         after mine.
+ ********************************************************************/
+void Mat_vec_iallgather(const DENSE_MATRIX_T *local_A,	/* in */
+			const float local_x[],			/* in */
+			const int counts[],				/* in */
+			const int displacements[],		/* in */
+			float global_x[],				/* out */
+			float local_y[],				/* out */
+			MPI_Comm comm					/* in */
+			)
+{
+	int my_rank;
+	int my_first, my_end;
+	MPI_Request request;
+
+	MPI_Comm_rank(comm, &my_rank);
+	my_first = displacements[my_rank];
+	my_end = my_first + counts[my_rank];
+
+	MPI_Iallgatherv(local_x, counts[my_rank], MPI_FLOAT, global_x, counts, displacements, MPI_FLOAT, comm,
+			&request);
+
+	memset(local_y, 0, local_A->rows * sizeof(float));
+	Multiply_columns(local_A, my_first, counts[my_rank], local_x, local_y, 1, &request);
+
+	MPI_Wait(&request, MPI_STATUS_IGNORE);
+	Multiply_columns(local_A, 0, my_first, global_x, local_y, 0, NULL);
+	Multiply_columns(local_A, my_end, local_A->cols - my_end, &global_x[my_end], local_y, 0, NULL);
+}
+
+/********************************************************************/
+/* Function Mat_vec_ring
+ * Algorithm:
+ *     1.  Copy my block of x into global_x.
+ *     2.  For i = 0 .. p-2 :
+ *             send block r-i to r+1 and receive block r-i-1 from r-1,
+ *             multiply by block r-i while they are on their way,
+ *             wait for both.
+ *     3.  Multiply by the last block received, r+1.
+ ********************************************************************/
+void Mat_vec_ring(const DENSE_MATRIX_T *local_A,	/* in */
+			const float local_x[],			/* in */
+			const int counts[],				/* in */
+			const int displacements[],		/* in */
+			float global_x[],				/* out */
+			float local_y[],				/* out */
+			MPI_Comm comm					/* in */
+			)
+{
+	int p, my_rank;
+	int successor, predecessor;
+	int send_block, recv_block;
+	MPI_Request requests[2];
+	int i;
+
+	MPI_Comm_size(comm, &p);
+	MPI_Comm_rank(comm, &my_rank);
+
+	memcpy(&global_x[displacements[my_rank]], local_x, counts[my_rank] * sizeof(float));
+	memset(local_y, 0, local_A->rows * sizeof(float));
+
+	successor = (my_rank + 1) % p;
+	predecessor = (my_rank - 1 + p) % p;
+
+	for( i = 0 ; i < p - 1 ; i++ )
+	{
+		send_block = (my_rank - i + p) % p;
+		recv_block = (my_rank - i - 1 + p) % p;
+
+		MPI_Isend(&global_x[displacements[send_block]], counts[send_block], MPI_FLOAT, successor, RING_TAG, comm,
+				&requests[0]);
+		MPI_Irecv(&global_x[displacements[recv_block]], counts[recv_block], MPI_FLOAT, predecessor, RING_TAG, comm,
+				&requests[1]);
+
+		Multiply_columns(local_A, displacements[send_block], counts[send_block],
+				&global_x[displacements[send_block]], local_y, 2, requests);
+
+		MPI_Waitall(2, requests, MPI_STATUSES_IGNORE);
+	}
+
+	/* The last block received, or mine if p = 1 */
+	send_block = (my_rank + 1) % p;
+	Multiply_columns(local_A, displacements[send_block], counts[send_block], &global_x[displacements[send_block]],
+			local_y, 0, NULL);
+}
@@ -0,0 +1,57 @@
+/*
+ * overlap_mat_vec.h
+ *
+ *  Created on: 16-Oct-2026
+ *      Author: prateek
+ *      Desc : Header for overlap_mat_vec.c -- row panel matrix-vector products
+ *      	that multiply while x is still being gathered.
+ */
+#ifndef OVERLAP_MAT_VEC_H
+#define OVERLAP_MAT_VEC_H
+
+#include <mpi/mpi.h>
+#include "dense_matrix.h"
+
+/* Tag of the ring messages */
+#define RING_TAG		7301
+
+/* All three compute local_y = local_A x, where x is block distributed :
+ * process r holds counts[r] elements, starting at displacements[r], in
+ * local_x. On return global_x holds all of x. local_A is my row panel,
+ * local_A->cols = the order of x. Collective over comm */
+
+/* MPI_Allgatherv, then Dense_gemv ( parallel_mat_vect.c ) */
+void Mat_vec_blocking(
+		const DENSE_MATRIX_T *local_A,	/* in */
+		const float local_x[],			/* in */
+		const int counts[],				/* in */
+		const int displacements[],		/* in */
+		float global_x[],				/* out */
+		float local_y[],				/* out */
+		MPI_Comm comm					/* in */
+		);
+
+/* Start MPI_Iallgatherv, multiply by my own block of x, then finish */
+void Mat_vec_iallgather(
+		const DENSE_MATRIX_T *local_A,	/* in */
+		const float local_x[],			/* in */
+		const int counts[],				/* in */
+		const int displacements[],		/* in */
+		float global_x[],				/* out */
+		float local_y[],				/* out */
+		MPI_Comm comm					/* in */
+		);
+
+/* Ring allgather ( chap13/ag_ring_nblk.c ); each block of x is multiplied
+ * while the next one is on its way */
+void Mat_vec_ring(
+		const DENSE_MATRIX_T *local_A,	/* in */
+		const float local_x[],			/* in */
+		const int counts[],				/* in */
+		const int displacements[],		/* in */
+		float global_x[],				/* out */
+		float local_y[],				/* out */
+		MPI_Comm comm					/* in */
+		);
+
+#endif /* OVERLAP_MAT_VEC_H */
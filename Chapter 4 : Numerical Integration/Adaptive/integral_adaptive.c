@@ -0,0 +1,386 @@
+/*
+ * integral_adaptive.c
+ *
+ *  Created on: 16-Oct-2026
+ *      Author: prateek
+ *      Desc : Adaptive parallel quadrature with dynamic load balancing.
+ *      Input :
+ *      	a, b : Limits of integration
+ *      	tol  : Target absolute error of the integral
+ *      Output :
+ *      	Estimate of the integral from a to b of f(x), its error estimate,
+ *      	no of f(x) evaluations done by every process and the elapsed time.
+ *
+ *      Algorithm:
+ *      1) Process 0 is the manager. It keeps a queue of subintervals which still
+ *         have to be integrated. Initially [a,b] is cut into a few equal pieces.
+ *      2) Every other process is a worker. Whenever a worker is idle the manager
+ *         pops a subinterval off the queue and sends it to that worker.
+ *      3) The worker integrates its subinterval with adaptive Simpson's rule. A piece
+ *         is accepted when |S(left) + S(right) - S(whole)| / 15 is below its share of
+ *         tol ( tol * piece length / (b-a) ), else it is bisected. Only LOCAL_DEPTH
+ *         bisections are done locally; pieces that still are not accurate enough are
+ *         sent back to the manager along with the accepted integral.
+ *      4) The manager puts the returned pieces back on the queue, so the hard parts of
+ *         the domain get spread over all idle workers instead of one straggler.
+ *      5) When the queue is empty and no worker is busy, the manager stops the workers.
+ *
+ *      NOTES:
+ *      	1. f(x) is hardwired. It has a sharp peak near x = 0.3, so most of the work
+ *      	   is needed in a small part of [a,b].
+ *      	2. With one process the manager does all the work itself.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <mpi/mpi.h>
+
+#define WORK_TAG		1
+#define RESULT_TAG		2
+#define STOP_TAG		3
+
+#define LOCAL_DEPTH		6			/* Max bisections a worker does before giving work back */
+#define MAX_PENDING		(1 << LOCAL_DEPTH)
+#define RESULT_SIZE		(3 + 2 * MAX_PENDING)	/* integral, error, evals, pending pieces */
+#define MIN_WIDTH		1.0e-12		/* Pieces smaller than this are always accepted */
+
+/* Stack of subintervals still to be integrated */
+typedef struct {
+	double *left;
+	double *right;
+	int size;
+	int capacity;
+} INTERVAL_QUEUE_T;
+
+void Get_data(double *a_ptr, double *b_ptr, double *tol_ptr, int my_rank);
+double Manager(double a, double b, double tol, int no_of_process, double *error_ptr, long *evals_ptr);
+long Worker(double tol_density);
+int Refine_interval(double left, double right, double tol_density, double result[]);
+void Push_interval(INTERVAL_QUEUE_T *queue, double left, double right);
+double f(double x);
+
+int main(int argc, char **argv)
+{
+	int my_rank;			// My process rank
+	int no_of_process;		// No of processes
+	double a;				// Left endpoint
+	double b;				// Right endpoint
+	double tol;				// Target absolute error
+	double tol_density;		// Allowed error per unit length
+	double total = 0.0;		// Total integral
+	double error = 0.0;		// Error estimate of total
+	long evals = 0;			// f(x) evaluations done by me
+	long *all_evals = NULL;	// f(x) evaluations done by every process
+	double start, finish;
+	int process;
+
+	MPI_Init(&argc, &argv);
+	MPI_Comm_rank(MPI_COMM_WORLD, &my_rank);
+	MPI_Comm_size(MPI_COMM_WORLD, &no_of_process);
+
+	Get_data(&a, &b, &tol, my_rank);
+	tol_density = tol / (b - a);
+
+	MPI_Barrier(MPI_COMM_WORLD);
+	start = MPI_Wtime();
+
+	if( my_rank == 0 )
+	{
+		total = Manager(a, b, tol, no_of_process, &error, &evals);
+	}
+	else
+	{
+		evals = Worker(tol_density);
+	}
+
+	MPI_Barrier(MPI_COMM_WORLD);
+	finish = MPI_Wtime();
+
+	/* Collect the work done by each process to show how evenly it was shared */
+	if( my_rank == 0 )
+	{
+		all_evals = malloc(no_of_process * sizeof(long));
+	}
+	MPI_Gather(&evals, 1, MPI_LONG, all_evals, 1, MPI_LONG, 0, MPI_COMM_WORLD);
+
+	if( my_rank == 0 )
+	{
+		printf("Our estimate of the integral from %f to %f = %.12f \n", a, b, total);
+		printf("Estimated error = %e (tolerance %e) \n", error, tol);
+		for( process = 0 ; process < no_of_process ; process++ )
+		{
+			printf("Process %d ==> %ld evaluations of f(x) \n", process, all_evals[process]);
+		}
+		printf("Elapsed time in seconds = %e \n", finish - start);
+		free(all_evals);
+	}
+
+	MPI_Finalize();
+
+	return 0;
+}
+
+/*
+ * Process 0 reads a, b and tol and broadcasts them to everyone
+ */
+void Get_data(double *a_ptr,	/* out */
+			double *b_ptr,		/* out */
+			double *tol_ptr,	/* out */
+			int my_rank			/* in */
+			)
+{
+	if( my_rank == 0 )
+	{
+		printf("Enter a , b and tolerance \n");
+		scanf("%lf %lf %lf", a_ptr, b_ptr, tol_ptr);
+	}
+
+	MPI_Bcast(a_ptr, 1, MPI_DOUBLE, 0, MPI_COMM_WORLD);
+	MPI_Bcast(b_ptr, 1, MPI_DOUBLE, 0, MPI_COMM_WORLD);
+	MPI_Bcast(tol_ptr, 1, MPI_DOUBLE, 0, MPI_COMM_WORLD);
+}
+
+/********************************************************************/
+/* Function Manager
+ * Hands out subintervals to idle workers until every piece of [a,b]
+ * has been integrated to the required accuracy.
+ * Returns the integral and stores its error estimate in error_ptr and
+ * the f(x) evaluations done by process 0 in evals_ptr.
+ ********************************************************************/
+double Manager(double a,			/* in */
+			double b,				/* in */
+			double tol,				/* in */
+			int no_of_process,		/* in */
+			double *error_ptr,		/* out */
+			long *evals_ptr			/* out */
+			)
+{
+	INTERVAL_QUEUE_T queue = { NULL, NULL, 0, 0 };
+	double result[RESULT_SIZE];
+	double work[2];
+	double tol_density = tol / (b - a);
+	double total = 0.0;
+	int *idle;				// idle[w] = 1 if worker w waits for work
+	int busy = 0;			// No of workers currently working
+	int no_of_pieces;
+	int count;
+	int worker;
+	int i;
+	MPI_Status status;
+
+	*error_ptr = 0.0;
+	*evals_ptr = 0;
+
+	/* Start with a few pieces per worker so everyone has something to do */
+	no_of_pieces = (no_of_process > 1) ? 4 * (no_of_process - 1) : 1;
+	for( i = no_of_pieces - 1 ; i >= 0 ; i-- )
+	{
+		Push_interval(&queue, a + i * (b - a) / no_of_pieces, a + (i + 1) * (b - a) / no_of_pieces);
+	}
+
+	/* No workers : do all the refinement here */
+	if( no_of_process == 1 )
+	{
+		while( queue.size > 0 )
+		{
+			queue.size--;
+			count = Refine_interval(queue.left[queue.size], queue.right[queue.size], tol_density, result);
+			total += result[0];
+			*error_ptr += result[1];
+			*evals_ptr += (long) result[2];
+			for( i = 0 ; i < count ; i++ )
+			{
+				Push_interval(&queue, result[3 + 2 * i], result[4 + 2 * i]);
+			}
+		}
+		free(queue.left);
+		free(queue.right);
+		return total;
+	}
+
+	idle = malloc(no_of_process * sizeof(int));
+	for( worker = 1 ; worker < no_of_process ; worker++ )
+	{
+		idle[worker] = 1;
+	}
+
+	do
+	{
+		/* Give a piece to every idle worker while there are pieces left */
+		for( worker = 1 ; worker < no_of_process && queue.size > 0 ; worker++ )
+		{
+			if( idle[worker] )
+			{
+				queue.size--;
+				work[0] = queue.left[queue.size];
+				work[1] = queue.right[queue.size];
+				MPI_Send(work, 2, MPI_DOUBLE, worker, WORK_TAG, MPI_COMM_WORLD);
+				idle[worker] = 0;
+				busy++;
+			}
+		}
+
+		/* Wait for any worker to finish, and queue what it could not resolve */
+		MPI_Recv(result, RESULT_SIZE, MPI_DOUBLE, MPI_ANY_SOURCE, RESULT_TAG, MPI_COMM_WORLD, &status);
+		MPI_Get_count(&status, MPI_DOUBLE, &count);
+		idle[status.MPI_SOURCE] = 1;
+		busy--;
+
+		total += result[0];
+		*error_ptr += result[1];
+		for( i = 3 ; i + 1 < count ; i += 2 )
+		{
+			Push_interval(&queue, result[i], result[i + 1]);
+		}
+	} while( busy > 0 || queue.size > 0 );
+
+	/* Everything is integrated, let the workers go */
+	for( worker = 1 ; worker < no_of_process ; worker++ )
+	{
+		MPI_Send(work, 0, MPI_DOUBLE, worker, STOP_TAG, MPI_COMM_WORLD);
+	}
+
+	free(idle);
+	free(queue.left);
+	free(queue.right);
+	return total;
+}
+
+/********************************************************************/
+/* Function Worker
+ * Receives subintervals from process 0 until it is told to stop.
+ * Returns the no of f(x) evaluations done by this process.
+ ********************************************************************/
+long Worker(double tol_density	/* in */)
+{
+	double work[2];
+	double result[RESULT_SIZE];
+	long evals = 0;
+	int count;
+	MPI_Status status;
+
+	while( 1 )
+	{
+		MPI_Recv(work, 2, MPI_DOUBLE, 0, MPI_ANY_TAG, MPI_COMM_WORLD, &status);
+		if( status.MPI_TAG == STOP_TAG )
+		{
+			break;
+		}
+
+		count = Refine_interval(work[0], work[1], tol_density, result);
+		evals += (long) result[2];
+
+		/* Send back integral, error, evaluations and the pieces still to do */
+		MPI_Send(result, 3 + 2 * count, MPI_DOUBLE, 0, RESULT_TAG, MPI_COMM_WORLD);
+	}
+
+	return evals;
+}
+
+/*
+ * Adaptive Simpson's rule over [left,right]. Accepted parts are added to
+ * *integral_ptr and *error_ptr. Parts that are still too coarse after
+ * depth bisections are appended to pending[].
+ */
+static void Simpson_recursive(double left, double right,
+			double f_left, double f_mid, double f_right,
+			double whole,			/* Simpson's rule over [left,right] */
+			double tol_density,
+			int depth,
+			double *integral_ptr,	/* in/out */
+			double *error_ptr,		/* in/out */
+			long *evals_ptr,		/* in/out */
+			double pending[],		/* out */
+			int *pending_ptr		/* in/out */
+			)
+{
+	double mid = (left + right) / 2.0;
+	double f_left_mid = f((left + mid) / 2.0);
+	double f_mid_right = f((mid + right) / 2.0);
+	double left_half = (mid - left) / 6.0 * (f_left + 4.0 * f_left_mid + f_mid);
+	double right_half = (right - mid) / 6.0 * (f_mid + 4.0 * f_mid_right + f_right);
+	double difference = left_half + right_half - whole;
+	double error = fabs(difference) / 15.0;
+
+	*evals_ptr += 2;
+
+	if( error <= tol_density * (right - left) || (right - left) < MIN_WIDTH )
+	{
+		/* Accurate enough : keep the Richardson extrapolated value */
+		*integral_ptr += left_half + right_half + difference / 15.0;
+		*error_ptr += error;
+	}
+	else if( depth == 0 )
+	{
+		/* Give the piece back to the manager so someone else may take it */
+		pending[2 * *pending_ptr] = left;
+		pending[2 * *pending_ptr + 1] = right;
+		(*pending_ptr)++;
+	}
+	else
+	{
+		Simpson_recursive(left, mid, f_left, f_left_mid, f_mid, left_half, tol_density,
+				depth - 1, integral_ptr, error_ptr, evals_ptr, pending, pending_ptr);
+		Simpson_recursive(mid, right, f_mid, f_mid_right, f_right, right_half, tol_density,
+				depth - 1, integral_ptr, error_ptr, evals_ptr, pending, pending_ptr);
+	}
+}
+
+/********************************************************************/
+/* Function Refine_interval
+ * Integrates [left,right] with at most LOCAL_DEPTH levels of bisection.
+ * Output : result[0] = integral over the accepted parts
+ *          result[1] = error estimate of result[0]
+ *          result[2] = no of f(x) evaluations done
+ *          result[3 ...] = (left, right) pairs of the pieces still to do
+ * Returns the no of pieces still to do.
+ ********************************************************************/
+int Refine_interval(double left,	/* in */
+			double right,			/* in */
+			double tol_density,		/* in */
+			double result[]			/* out */
+			)
+{
+	double f_left = f(left);
+	double f_mid = f((left + right) / 2.0);
+	double f_right = f(right);
+	double whole = (right - left) / 6.0 * (f_left + 4.0 * f_mid + f_right);
+	double integral = 0.0;
+	double error = 0.0;
+	long evals = 3;
+	int pending = 0;
+
+	Simpson_recursive(left, right, f_left, f_mid, f_right, whole, tol_density, LOCAL_DEPTH,
+			&integral, &error, &evals, &result[3], &pending);
+
+	result[0] = integral;
+	result[1] = error;
+	result[2] = (double) evals;
+	return pending;
+}
+
+/*
+ * Push [left,right] on the queue, growing it when full
+ */
+void Push_interval(INTERVAL_QUEUE_T *queue,	/* in/out */
+			double left,					/* in */
+			double right					/* in */
+			)
+{
+	if( queue->size == queue->capacity )
+	{
+		queue->capacity = (queue->capacity == 0) ? 64 : 2 * queue->capacity;
+		queue->left = realloc(queue->left, queue->capacity * sizeof(double));
+		queue->right = realloc(queue->right, queue->capacity * sizeof(double));
+	}
+
+	queue->left[queue->size] = left;
+	queue->right[queue->size] = right;
+	queue->size++;
+}
+
+// f(x) = x^2 + 1 / ( (x - 0.3)^2 + 10^-4 )
+double f(double x)
+{
+	return (x*x + 1.0 / ((x - 0.3) * (x - 0.3) + 1.0e-4));
+}
@@ -0,0 +1,394 @@
+/*
+ * integral_rules.c
+ *
+ *  Created on: 16-Oct-2026
+ *      Author: prateek
+ *      Desc : Parallel numerical integration with a choice of quadrature rule
+ *      Input :
+ *      	a, b : Limits of integration
+ *      	n    : no of panels (64 bit)
+ *      	rule : trap, simpson, gauss2, gauss3, gauss4, gauss5 or romberg
+ *      Output :
+ *      	Estimate of the integral from a to b of f(x), its error estimate,
+ *      	the no of f(x) evaluations and the elapsed time.
+ *
+ *      Algorithm:
+ *      1) Process 0 reads the input and looks the rule up in rule_table[]. Every
+ *         rule has the same call shape as Trap(local_a, local_b, local_n, h) plus
+ *         an output for its error estimate.
+ *      2) n is rounded up so that every process gets the same local_n and local_n
+ *         is a multiple of what the rule needs (e.g. 4 for Simpson).
+ *      3) Each process integrates its interval and estimates its error by comparing
+ *         with the same rule on panels twice as wide.
+ *      4) Integral, error estimate and evaluation count go to process 0 in one
+ *         MPI_Reduce.
+ *
+ *      NOTES:
+ *      	1. f(x) is hardwired. Its integral over [0,1] is pi.
+ *      	2. Everything is done in double, the higher order rules would be limited
+ *      	   by float round off long before they run out of accuracy.
+ */
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include <mpi/mpi.h>
+
+#define ROMBERG_LEVELS		5		/* Extrapolation levels of the Romberg rule */
+#define MAX_RULE_NAME		16
+
+/* Every rule integrates local_n panels of width h starting at local_a.
+ * The error estimate goes to *error_ptr and the f(x) evaluations done
+ * are added to *evals_ptr. */
+typedef double (*RULE_FN_T)(double local_a, double local_b, long long local_n,
+			double h, double *error_ptr, long long *evals_ptr);
+
+typedef struct {
+	char name[MAX_RULE_NAME];
+	long long granularity;		/* local_n must be a multiple of this */
+	RULE_FN_T integrate;
+} RULE_T;
+
+double Trap(double local_a, double local_b, long long local_n, double h, double *error_ptr, long long *evals_ptr);
+double Simpson(double local_a, double local_b, long long local_n, double h, double *error_ptr, long long *evals_ptr);
+double Gauss2(double local_a, double local_b, long long local_n, double h, double *error_ptr, long long *evals_ptr);
+double Gauss3(double local_a, double local_b, long long local_n, double h, double *error_ptr, long long *evals_ptr);
+double Gauss4(double local_a, double local_b, long long local_n, double h, double *error_ptr, long long *evals_ptr);
+double Gauss5(double local_a, double local_b, long long local_n, double h, double *error_ptr, long long *evals_ptr);
+double Romberg(double local_a, double local_b, long long local_n, double h, double *error_ptr, long long *evals_ptr);
+void Get_data(double *a_ptr, double *b_ptr, long long *n_ptr, int *rule_ptr, int my_rank);
+double f(double x);
+
+static const RULE_T rule_table[] = {
+	{ "trap",		2,						Trap },
+	{ "simpson",	4,						Simpson },
+	{ "gauss2",		2,						Gauss2 },
+	{ "gauss3",		2,						Gauss3 },
+	{ "gauss4",		2,						Gauss4 },
+	{ "gauss5",		2,						Gauss5 },
+	{ "romberg",	1 << ROMBERG_LEVELS,	Romberg },
+};
+#define NO_OF_RULES		((int) (sizeof(rule_table) / sizeof(rule_table[0])))
+
+/* Gauss-Legendre nodes and weights on [-1,1], row k is the (k+2)-point rule */
+static const double gauss_nodes[4][5] = {
+	{ -0.5773502691896257, 0.5773502691896257 },
+	{ -0.7745966692414834, 0.0, 0.7745966692414834 },
+	{ -0.8611363115940526, -0.3399810435848563, 0.3399810435848563, 0.8611363115940526 },
+	{ -0.9061798459386640, -0.5384693101056831, 0.0, 0.5384693101056831, 0.9061798459386640 },
+};
+static const double gauss_weights[4][5] = {
+	{ 1.0, 1.0 },
+	{ 0.5555555555555556, 0.8888888888888888, 0.5555555555555556 },
+	{ 0.3478548451374538, 0.6521451548625461, 0.6521451548625461, 0.3478548451374538 },
+	{ 0.2369268850561891, 0.4786286704993665, 0.5688888888888889, 0.4786286704993665, 0.2369268850561891 },
+};
+
+int main(int argc, char **argv)
+{
+	int my_rank;			// My process rank
+	int no_of_process;		// No of processes
+	double a;				// Left endpoint
+	double b;				// Right endpoint
+	long long n;			// No of panels
+	int rule;				// Index in rule_table
+	double h;				// Panel width
+	double local_a;			// Left endpoint my process
+	double local_b;			// Right endpoint my process
+	long long local_n;		// No of panels for my calculation
+	long long granularity;
+	long long local_evals = 0;
+	double local_result[3];	// integral, error estimate, evaluations
+	double result[3];
+	double start, finish;
+
+	MPI_Init(&argc, &argv);
+	MPI_Comm_rank(MPI_COMM_WORLD, &my_rank);
+	MPI_Comm_size(MPI_COMM_WORLD, &no_of_process);
+
+	Get_data(&a, &b, &n, &rule, my_rank);
+	if( rule < 0 )
+	{
+		if( my_rank == 0 )
+		{
+			fprintf(stderr, "Unknown rule \n");
+		}
+		MPI_Finalize();
+		return 1;
+	}
+
+	MPI_Barrier(MPI_COMM_WORLD);
+	start = MPI_Wtime();
+
+	/* Same local_n everywhere, rounded up to what the rule needs */
+	granularity = rule_table[rule].granularity;
+	local_n = (n + no_of_process - 1) / no_of_process;
+	local_n = (local_n + granularity - 1) / granularity * granularity;
+	n = local_n * no_of_process;
+
+	h = (b - a) / n;
+	local_a = a + my_rank * local_n * h;
+	local_b = local_a + local_n * h;
+
+	local_result[0] = rule_table[rule].integrate(local_a, local_b, local_n, h, &local_result[1], &local_evals);
+	local_result[2] = (double) local_evals;
+
+	/* Integral and error estimate travel together */
+	MPI_Reduce(local_result, result, 3, MPI_DOUBLE, MPI_SUM, 0, MPI_COMM_WORLD);
+
+	MPI_Barrier(MPI_COMM_WORLD);
+	finish = MPI_Wtime();
+
+	if( my_rank == 0 )
+	{
+		printf("Rule %s with n = %lld panels , our estimate \n", rule_table[rule].name, n);
+		printf("of the integral from %f to %f = %.15f \n", a, b, result[0]);
+		printf("Estimated error = %e , evaluations of f(x) = %.0f \n", result[1], result[2]);
+		printf("Elapsed time in seconds = %e \n", finish - start);
+	}
+
+	MPI_Finalize();
+
+	return 0;
+}
+
+/*
+ * Process 0 reads a, b, n and the rule name and broadcasts them.
+ * *rule_ptr is -1 if the rule is unknown.
+ */
+void Get_data(double *a_ptr,	/* out */
+			double *b_ptr,		/* out */
+			long long *n_ptr,	/* out */
+			int *rule_ptr,		/* out */
+			int my_rank			/* in */
+			)
+{
+	char name[MAX_RULE_NAME] = {0};
+	int i;
+
+	if( my_rank == 0 )
+	{
+		printf("Enter a , b , n and rule (trap, simpson, gauss2..gauss5, romberg) \n");
+		scanf("%lf %lf %lld %15s", a_ptr, b_ptr, n_ptr, name);
+
+		*rule_ptr = -1;
+		for( i = 0 ; i < NO_OF_RULES ; i++ )
+		{
+			if( strcmp(name, rule_table[i].name) == 0 )
+			{
+				*rule_ptr = i;
+			}
+		}
+	}
+
+	MPI_Bcast(a_ptr, 1, MPI_DOUBLE, 0, MPI_COMM_WORLD);
+	MPI_Bcast(b_ptr, 1, MPI_DOUBLE, 0, MPI_COMM_WORLD);
+	MPI_Bcast(n_ptr, 1, MPI_LONG_LONG, 0, MPI_COMM_WORLD);
+	MPI_Bcast(rule_ptr, 1, MPI_INT, 0, MPI_COMM_WORLD);
+}
+
+/********************************************************************/
+/* Composite trapezoidal rule. The estimate with panels of width 2h
+ * uses every other point, so the error estimate costs no extra f(x)
+ * evaluations : error = |T(h) - T(2h)| / 3
+ ********************************************************************/
+double Trap(double local_a,		/* in */
+			double local_b,		/* in */
+			long long local_n,	/* in */
+			double h,			/* in */
+			double *error_ptr,	/* out */
+			long long *evals_ptr	/* in/out */
+			)
+{
+	double ends = (f(local_a) + f(local_b)) / 2.0;
+	double odd_sum = 0.0;		// Points only in the fine rule
+	double even_sum = 0.0;		// Points in both rules
+	double fine, coarse;
+	long long i;
+
+	for( i = 1 ; i < local_n ; i++ )
+	{
+		if( i % 2 )
+		{
+			odd_sum += f(local_a + i * h);
+		}
+		else
+		{
+			even_sum += f(local_a + i * h);
+		}
+	}
+	*evals_ptr += local_n + 1;
+
+	fine = h * (ends + odd_sum + even_sum);
+	coarse = 2.0 * h * (ends + even_sum);
+	*error_ptr = fabs(fine - coarse) / 3.0;
+	return fine;
+}
+
+/********************************************************************/
+/* Composite Simpson's rule over local_n panels (a multiple of 4).
+ * error = |S(h) - S(2h)| / 15 , S(2h) reuses the points of S(h).
+ ********************************************************************/
+double Simpson(double local_a,	/* in */
+			double local_b,		/* in */
+			long long local_n,	/* in */
+			double h,			/* in */
+			double *error_ptr,	/* out */
+			long long *evals_ptr	/* in/out */
+			)
+{
+	double ends = f(local_a) + f(local_b);
+	double sum[4] = {0};		// sum[k] = sum of f at points i with i % 4 == k
+	double fine, coarse;
+	long long i;
+
+	for( i = 1 ; i < local_n ; i++ )
+	{
+		sum[i % 4] += f(local_a + i * h);
+	}
+	*evals_ptr += local_n + 1;
+
+	fine = h / 3.0 * (ends + 4.0 * (sum[1] + sum[3]) + 2.0 * (sum[0] + sum[2]));
+	coarse = 2.0 * h / 3.0 * (ends + 4.0 * sum[2] + 2.0 * sum[0]);
+	*error_ptr = fabs(fine - coarse) / 15.0;
+	return fine;
+}
+
+/********************************************************************/
+/* Composite Gauss-Legendre rule with points nodes per panel.
+ * The nodes are not nested, so the rule over panels of width 2h costs
+ * half as many extra evaluations again.
+ * error = |G(h) - G(2h)| / (2^(2 points) - 1)
+ ********************************************************************/
+static double Gauss_legendre(double local_a,	/* in */
+			long long local_n,		/* in */
+			double h,				/* in */
+			int points,				/* in */
+			double *error_ptr,		/* out */
+			long long *evals_ptr	/* in/out */
+			)
+{
+	const double *node = gauss_nodes[points - 2];
+	const double *weight = gauss_weights[points - 2];
+	double fine = 0.0;
+	double coarse = 0.0;
+	double center;
+	long long i;
+	int k;
+
+	for( i = 0 ; i < local_n ; i++ )
+	{
+		center = local_a + (i + 0.5) * h;
+		for( k = 0 ; k < points ; k++ )
+		{
+			fine += weight[k] * f(center + 0.5 * h * node[k]);
+		}
+	}
+
+	for( i = 0 ; i < local_n / 2 ; i++ )
+	{
+		center = local_a + (2 * i + 1) * h;
+		for( k = 0 ; k < points ; k++ )
+		{
+			coarse += weight[k] * f(center + h * node[k]);
+		}
+	}
+	*evals_ptr += points * (local_n + local_n / 2);
+
+	fine *= 0.5 * h;
+	coarse *= h;
+	*error_ptr = fabs(fine - coarse) / ((1 << (2 * points)) - 1);
+	return fine;
+}
+
+double Gauss2(double local_a, double local_b, long long local_n, double h, double *error_ptr, long long *evals_ptr)
+{
+	(void) local_b;
+	return Gauss_legendre(local_a, local_n, h, 2, error_ptr, evals_ptr);
+}
+
+double Gauss3(double local_a, double local_b, long long local_n, double h, double *error_ptr, long long *evals_ptr)
+{
+	(void) local_b;
+	return Gauss_legendre(local_a, local_n, h, 3, error_ptr, evals_ptr);
+}
+
+double Gauss4(double local_a, double local_b, long long local_n, double h, double *error_ptr, long long *evals_ptr)
+{
+	(void) local_b;
+	return Gauss_legendre(local_a, local_n, h, 4, error_ptr, evals_ptr);
+}
+
+double Gauss5(double local_a, double local_b, long long local_n, double h, double *error_ptr, long long *evals_ptr)
+{
+	(void) local_b;
+	return Gauss_legendre(local_a, local_n, h, 5, error_ptr, evals_ptr);
+}
+
+/********************************************************************/
+/* Romberg extrapolation. Starts with the trapezoidal rule over
+ * local_n / 2^ROMBERG_LEVELS panels and halves the panels ROMBERG_LEVELS
+ * times, reusing all previous points. Ends on local_n panels of width h.
+ * error = |R(L,L) - R(L,L-1)|
+ ********************************************************************/
+double Romberg(double local_a,	/* in */
+			double local_b,		/* in */
+			long long local_n,	/* in */
+			double h,			/* in */
+			double *error_ptr,	/* out */
+			long long *evals_ptr	/* in/out */
+			)
+{
+	double previous[ROMBERG_LEVELS + 1];
+	double current[ROMBERG_LEVELS + 1];
+	long long panels = local_n >> ROMBERG_LEVELS;
+	double step = h * (1 << ROMBERG_LEVELS);
+	double sum;
+	double factor;
+	long long i;
+	int level, j;
+
+	/* Coarsest trapezoidal rule */
+	sum = (f(local_a) + f(local_b)) / 2.0;
+	for( i = 1 ; i < panels ; i++ )
+	{
+		sum += f(local_a + i * step);
+	}
+	previous[0] = step * sum;
+	*evals_ptr += panels + 1;
+
+	for( level = 1 ; level <= ROMBERG_LEVELS ; level++ )
+	{
+		/* Add the midpoints of the current panels */
+		sum = 0.0;
+		for( i = 0 ; i < panels ; i++ )
+		{
+			sum += f(local_a + (i + 0.5) * step);
+		}
+		*evals_ptr += panels;
+		current[0] = previous[0] / 2.0 + step / 2.0 * sum;
+
+		/* Richardson extrapolation along the row */
+		factor = 1.0;
+		for( j = 1 ; j <= level ; j++ )
+		{
+			factor *= 4.0;
+			current[j] = current[j - 1] + (current[j - 1] - previous[j - 1]) / (factor - 1.0);
+		}
+
+		for( j = 0 ; j <= level ; j++ )
+		{
+			previous[j] = current[j];
+		}
+		panels *= 2;
+		step /= 2.0;
+	}
+
+	*error_ptr = fabs(previous[ROMBERG_LEVELS] - previous[ROMBERG_LEVELS - 1]);
+	return previous[ROMBERG_LEVELS];
+}
+
+// f(x) = 4 / (1 + x^2)
+double f(double x)
+{
+	return (4.0 / (1.0 + x*x));
+}
@@ -0,0 +1,193 @@
+/*
+ * integral_hybrid.c
+ *
+ *  Created on: 16-Oct-2026
+ *      Author: prateek
+ *      Desc : Parallel Trapezoidal Rule, hybrid MPI + OpenMP threads
+ *      Input :
+ *      	a, b : Limits of integration
+ *      	n : no of trapezoids
+ *      Output :
+ *      	Estimate of the integral from a to b of f(x), the no of processes and
+ *      	threads used, and the elapsed time.
+ *
+ *      Algorithm:
+ *      1) Start MPI with MPI_Init_thread. Only the master thread makes MPI calls,
+ *         so MPI_THREAD_FUNNELED is enough.
+ *      2) Each process works out its interval [local_a, local_b] as usual.
+ *      3) The local_n trapezoids of the process are split among the threads of the
+ *         process. Each thread writes its partial sum to its own padded slot.
+ *      4) The master thread adds the partial sums and the processes add their
+ *         results with MPI_Reduce, which now runs over processes only.
+ *
+ *      NOTES:
+ *      	1. f(x) is hardwired.
+ *      	2. Start one process per node or socket and set OMP_NUM_THREADS to the
+ *      	   cores it owns. With OMP_NUM_THREADS=1 and one process per core the
+ *      	   program is the flat MPI version, so both can be timed for the same n.
+ *      	3. The no of processes should evenly divide the no of trapezoids.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <omp.h>
+#include <mpi/mpi.h>
+
+#define CACHE_LINE		64
+
+/* One partial sum per cache line so the threads do not share lines */
+typedef struct {
+	float value;
+	char pad[CACHE_LINE - sizeof(float)];
+} PARTIAL_SUM_T;
+
+void Get_data(float *a_ptr, float *b_ptr, int *n_ptr, int my_rank);
+float calculate_integral_threaded( float local_a, int local_n , float h , int no_of_threads );
+float calculate_integral( float local_a, float local_b , int local_n , float h );
+float f(float x);
+
+int main(int argc, char **argv)
+{
+	int my_rank;			// My process rank
+	int no_of_process;		// No of processes
+	int provided;			// Thread support given by MPI
+	int no_of_threads;		// Threads per process
+	float a;				// Left endpoint
+	float b;				// Right endpoint
+	int n;					// No of trapezoids
+	float h;				// Trapezoids base length
+	float local_a;			// Left endpoint my process
+	int local_n;			// No of trapezoids for my calculation
+	float integral;			// Integral over my interval
+	float total;			// Total integral
+	double start, finish;
+
+	MPI_Init_thread(&argc, &argv, MPI_THREAD_FUNNELED, &provided);
+	MPI_Comm_rank(MPI_COMM_WORLD, &my_rank);
+	MPI_Comm_size(MPI_COMM_WORLD, &no_of_process);
+
+	if( provided < MPI_THREAD_FUNNELED )
+	{
+		if( my_rank == 0 )
+		{
+			fprintf(stderr, "MPI library does not support MPI_THREAD_FUNNELED \n");
+		}
+		MPI_Abort(MPI_COMM_WORLD, 1);
+	}
+
+	Get_data(&a, &b, &n, my_rank);
+	no_of_threads = omp_get_max_threads();
+
+	MPI_Barrier(MPI_COMM_WORLD);
+	start = MPI_Wtime();
+
+	h = (b - a) / n;
+	local_n = n / no_of_process;
+	local_a = a + my_rank * local_n * h;
+
+	integral = calculate_integral_threaded(local_a, local_n, h, no_of_threads);
+
+	/* Only one contribution per process goes into the reduction */
+	MPI_Reduce(&integral, &total, 1, MPI_FLOAT, MPI_SUM, 0, MPI_COMM_WORLD);
+
+	MPI_Barrier(MPI_COMM_WORLD);
+	finish = MPI_Wtime();
+
+	if( my_rank == 0 )
+	{
+		printf("With n = %d trapezoids , our estimate \n", n);
+		printf("of the integral from %f to %f = %f \n", a, b, total);
+		printf("Processes = %d , threads per process = %d \n", no_of_process, no_of_threads);
+		printf("Elapsed time in seconds = %e \n", finish - start);
+	}
+
+	MPI_Finalize();
+
+	return 0;
+}
+
+/*
+ * Process 0 reads a, b and n and broadcasts them to everyone
+ */
+void Get_data(float *a_ptr,	/* out */
+			float *b_ptr,	/* out */
+			int *n_ptr,		/* out */
+			int my_rank		/* in */
+			)
+{
+	if( my_rank == 0 )
+	{
+		printf("Enter a , b and n \n");
+		scanf("%f %f %d", a_ptr, b_ptr, n_ptr);
+	}
+
+	MPI_Bcast(a_ptr, 1, MPI_FLOAT, 0, MPI_COMM_WORLD);
+	MPI_Bcast(b_ptr, 1, MPI_FLOAT, 0, MPI_COMM_WORLD);
+	MPI_Bcast(n_ptr, 1, MPI_INT, 0, MPI_COMM_WORLD);
+}
+
+/********************************************************************/
+/* Function calculate_integral_threaded
+ * Splits the local_n trapezoids starting at local_a among no_of_threads
+ * threads. The first local_n % no_of_threads threads get one extra
+ * trapezoid. Returns the sum of the per-thread integrals.
+ ********************************************************************/
+float calculate_integral_threaded( float local_a,	/* in */
+			int local_n,							/* in */
+			float h,								/* in */
+			int no_of_threads						/* in */
+			)
+{
+	PARTIAL_SUM_T *partial;
+	float integral = 0.0;
+	int thread;
+
+	partial = aligned_alloc(CACHE_LINE, no_of_threads * sizeof(PARTIAL_SUM_T));
+
+#pragma omp parallel num_threads(no_of_threads)
+	{
+		int my_thread = omp_get_thread_num();
+		int quotient = local_n / no_of_threads;
+		int remainder = local_n % no_of_threads;
+		int my_n = quotient + (my_thread < remainder ? 1 : 0);
+		int my_first = my_thread * quotient + (my_thread < remainder ? my_thread : remainder);
+		float my_a = local_a + my_first * h;
+		float my_b = my_a + my_n * h;
+
+		partial[my_thread].value = (my_n > 0) ? calculate_integral(my_a, my_b, my_n, h) : 0.0;
+	}
+
+	/* Combine the thread results before any communication */
+	for( thread = 0 ; thread < no_of_threads ; thread++ )
+	{
+		integral += partial[thread].value;
+	}
+
+	free(partial);
+	return integral;
+}
+
+/* Function to calculate integral */
+float calculate_integral( float local_a, float local_b , int local_n , float h )
+{
+	float integral;		// Store result of integral
+	float x ;
+	int i;
+
+	integral = ( f(local_a) + f(local_b)) / 2.0;
+	x = local_a;
+
+	for( i = 1 ; i <= local_n-1 ; i++ )
+	{
+		x = x+h;
+		integral = integral + f(x);
+	}
+
+	integral = integral * h;
+	return integral;
+}
+
+// f(x) = x^2
+float f(float x)
+{
+	return (x*x);
+}
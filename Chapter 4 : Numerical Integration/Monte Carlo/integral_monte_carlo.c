@@ -0,0 +1,300 @@
+/*
+ * integral_monte_carlo.c
+ *
+ *  Created on: 16-Oct-2026
+ *      Author: prateek
+ *      Desc : Parallel Monte Carlo integration over the unit hypercube [0,1]^DIM
+ *      	with MPI processes and OpenMP threads.
+ *      Input :
+ *      	target : standard error at which to stop
+ *      	max_samples : stop anyway after this many samples (all processes together)
+ *      Output :
+ *      	Estimate of the integral, its standard error, the no of samples, the exact
+ *      	value and the elapsed time.
+ *
+ *      Algorithm:
+ *      1) Every thread of every process owns a random stream. The generator is
+ *         counter based : number c of stream s is Mix64(c + key(s)), where key(s) is a
+ *         hashed stream id. So any number of any stream is computed directly, without
+ *         stepping through the ones before it (skip ahead for free), and no state
+ *         is shared between threads.
+ *      2) Samples are made BATCH_SIZE at a time : fill the coordinates from the
+ *         counters, evaluate f on the batch, then add the batch to the thread's
+ *         (count, mean, M2) with Chan's formula. All three loops vectorize : the
+ *         batch is kept one coordinate after the other, so each loop reads with
+ *         unit stride, and f has an omp declare simd clone.
+ *      3) After every round of ROUND_BATCHES batches per thread the (count, mean, M2)
+ *         of all threads and processes are combined with MPI_Allreduce and a user
+ *         defined MPI_Op. Everyone gets the same standard error, so everyone stops
+ *         in the same round.
+ *
+ *      NOTES:
+ *      	1. f is hardwired : f(x) = exp(-(x_1^2 + ... + x_DIM^2)). Its integral is
+ *      	   (sqrt(pi)/2 * erf(1))^DIM.
+ *      	2. Change SEED to get another set of streams.
+ *      	3. The Makefile builds with -march=native and -ffast-math so that exp()
+ *      	   in the simd clone of f can use the vector math library.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <math.h>
+#include <omp.h>
+#include <mpi/mpi.h>
+
+#define DIM				6
+#define BATCH_SIZE		512
+#define ROUND_BATCHES	64
+#define SEED			20261016ULL
+
+/* Running statistics of a set of samples */
+typedef struct {
+	double count;
+	double mean;
+	double M2;		// Sum of squared deviations from the mean
+} STATS_T;
+
+void Get_data(double *target_ptr, double *max_samples_ptr, int my_rank);
+void Build_stats_type(MPI_Datatype *stats_mpi_t_ptr);
+void Stats_merge(STATS_T *inout, const STATS_T *in);
+void Stats_merge_op(void *in, void *inout, int *len, MPI_Datatype *datatype);
+void Sample_batch(uint64_t key, uint64_t first_sample, STATS_T *stats);
+uint64_t Mix64(uint64_t z);
+#pragma omp declare simd linear(x) uniform(stride)
+double f(const double x[], int stride);
+
+int main(int argc, char **argv)
+{
+	int my_rank;				// My process rank
+	int no_of_process;			// No of processes
+	int provided;				// Thread support given by MPI
+	int no_of_threads;			// Threads per process
+	double target;				// Standard error wanted
+	double max_samples;			// Sample budget
+	STATS_T *thread_stats;		// Statistics of every thread
+	STATS_T local_stats;		// Statistics of my process
+	STATS_T global_stats;		// Statistics of everyone
+	MPI_Datatype stats_mpi_t;
+	MPI_Op stats_merge;
+	double std_error = INFINITY;
+	double exact;
+	double start, finish;
+	long round = 0;
+	int done = 0;
+
+	MPI_Init_thread(&argc, &argv, MPI_THREAD_FUNNELED, &provided);
+	MPI_Comm_rank(MPI_COMM_WORLD, &my_rank);
+	MPI_Comm_size(MPI_COMM_WORLD, &no_of_process);
+
+	Get_data(&target, &max_samples, my_rank);
+
+	Build_stats_type(&stats_mpi_t);
+	MPI_Op_create(Stats_merge_op, 1, &stats_merge);
+
+	no_of_threads = omp_get_max_threads();
+	thread_stats = calloc(no_of_threads, sizeof(STATS_T));
+
+	MPI_Barrier(MPI_COMM_WORLD);
+	start = MPI_Wtime();
+
+	while( !done )
+	{
+#pragma omp parallel num_threads(no_of_threads)
+		{
+			int my_thread = omp_get_thread_num();
+			/* One stream per (process, thread) */
+			uint64_t key = Mix64(SEED ^ Mix64((uint64_t) my_rank * no_of_threads + my_thread));
+			uint64_t first_sample = (uint64_t) round * ROUND_BATCHES * BATCH_SIZE;
+			int batch;
+
+			for( batch = 0 ; batch < ROUND_BATCHES ; batch++ )
+			{
+				Sample_batch(key, first_sample + (uint64_t) batch * BATCH_SIZE, &thread_stats[my_thread]);
+			}
+		}
+		round++;
+
+		/* Combine the threads, then the processes */
+		local_stats = thread_stats[0];
+		for( int thread = 1 ; thread < no_of_threads ; thread++ )
+		{
+			Stats_merge(&local_stats, &thread_stats[thread]);
+		}
+		MPI_Allreduce(&local_stats, &global_stats, 1, stats_mpi_t, stats_merge, MPI_COMM_WORLD);
+
+		std_error = sqrt(global_stats.M2 / (global_stats.count - 1.0) / global_stats.count);
+		done = (std_error <= target) || (global_stats.count >= max_samples);
+	}
+
+	MPI_Barrier(MPI_COMM_WORLD);
+	finish = MPI_Wtime();
+
+	if( my_rank == 0 )
+	{
+		exact = pow(sqrt(M_PI) / 2.0 * erf(1.0), DIM);
+		printf("Dimension %d , processes = %d , threads per process = %d \n", DIM, no_of_process, no_of_threads);
+		printf("Estimate = %.10f +- %.3e (%.0f samples) \n", global_stats.mean, std_error, global_stats.count);
+		printf("Exact    = %.10f , error = %.3e \n", exact, fabs(global_stats.mean - exact));
+		printf("Elapsed time in seconds = %e (%e samples/s) \n", finish - start,
+				global_stats.count / (finish - start));
+	}
+
+	free(thread_stats);
+	MPI_Op_free(&stats_merge);
+	MPI_Type_free(&stats_mpi_t);
+	MPI_Finalize();
+
+	return 0;
+}
+
+/*
+ * Process 0 reads the target standard error and the sample budget
+ */
+void Get_data(double *target_ptr,	/* out */
+			double *max_samples_ptr,	/* out */
+			int my_rank					/* in */
+			)
+{
+	if( my_rank == 0 )
+	{
+		printf("Enter target standard error and max no of samples \n");
+		scanf("%lf %lf", target_ptr, max_samples_ptr);
+	}
+
+	MPI_Bcast(target_ptr, 1, MPI_DOUBLE, 0, MPI_COMM_WORLD);
+	MPI_Bcast(max_samples_ptr, 1, MPI_DOUBLE, 0, MPI_COMM_WORLD);
+}
+
+/*
+ * Datatype of a STATS_T : three contiguous doubles
+ */
+void Build_stats_type(MPI_Datatype *stats_mpi_t_ptr	/* out */)
+{
+	MPI_Type_contiguous(3, MPI_DOUBLE, stats_mpi_t_ptr);
+	MPI_Type_commit(stats_mpi_t_ptr);
+}
+
+/********************************************************************/
+/* Function Stats_merge
+ * inout = statistics of the union of the samples of inout and in,
+ * by Chan's parallel formula for the mean and M2.
+ ********************************************************************/
+void Stats_merge(STATS_T *inout,	/* in/out */
+			const STATS_T *in		/* in */
+			)
+{
+	double count = inout->count + in->count;
+	double delta = in->mean - inout->mean;
+
+	if( in->count == 0.0 )
+	{
+		return;
+	}
+	if( inout->count == 0.0 )
+	{
+		*inout = *in;
+		return;
+	}
+
+	inout->mean += delta * in->count / count;
+	inout->M2 += in->M2 + delta * delta * inout->count * in->count / count;
+	inout->count = count;
+}
+
+/*
+ * The MPI_Op : merge len statistics of in into inout
+ */
+void Stats_merge_op(void *in,		/* in */
+			void *inout,			/* in/out */
+			int *len,				/* in */
+			MPI_Datatype *datatype	/* in */
+			)
+{
+	STATS_T *in_stats = (STATS_T *) in;
+	STATS_T *inout_stats = (STATS_T *) inout;
+	int i;
+
+	(void) datatype;
+	for( i = 0 ; i < *len ; i++ )
+	{
+		Stats_merge(&inout_stats[i], &in_stats[i]);
+	}
+}
+
+/********************************************************************/
+/* Function Sample_batch
+ * Draws samples first_sample .. first_sample + BATCH_SIZE - 1 of the
+ * stream with the given key, evaluates f on them and adds them to stats.
+ * Coordinate d of sample i is number i*DIM + d of the stream.
+ ********************************************************************/
+void Sample_batch(uint64_t key,		/* in */
+			uint64_t first_sample,	/* in */
+			STATS_T *stats			/* in/out */
+			)
+{
+	double x[DIM * BATCH_SIZE];		// Coordinate d of sample i is x[d*BATCH_SIZE + i]
+	double y[BATCH_SIZE];
+	uint64_t first_counter = first_sample * DIM;
+	STATS_T batch_stats;
+	double sum = 0.0;
+	double M2 = 0.0;
+	int i, d;
+
+	/* Coordinates in [0,1) from the top 53 bits */
+	for( d = 0 ; d < DIM ; d++ )
+	{
+#pragma omp simd
+		for( i = 0 ; i < BATCH_SIZE ; i++ )
+		{
+			x[d * BATCH_SIZE + i] = (double) (Mix64(key + first_counter + (uint64_t) i * DIM + d) >> 11) * 0x1.0p-53;
+		}
+	}
+
+#pragma omp simd
+	for( i = 0 ; i < BATCH_SIZE ; i++ )
+	{
+		y[i] = f(&x[i], BATCH_SIZE);
+	}
+
+	/* Two passes over the batch : mean, then squared deviations */
+	for( i = 0 ; i < BATCH_SIZE ; i++ )
+	{
+		sum += y[i];
+	}
+	batch_stats.count = BATCH_SIZE;
+	batch_stats.mean = sum / BATCH_SIZE;
+	for( i = 0 ; i < BATCH_SIZE ; i++ )
+	{
+		M2 += (y[i] - batch_stats.mean) * (y[i] - batch_stats.mean);
+	}
+	batch_stats.M2 = M2;
+
+	Stats_merge(stats, &batch_stats);
+}
+
+/*
+ * SplitMix64 finalizer : a bijective 64 bit mixing function
+ */
+uint64_t Mix64(uint64_t z)
+{
+	z += 0x9e3779b97f4a7c15ULL;
+	z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+	z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+	return z ^ (z >> 31);
+}
+
+// f(x) = exp(-(x_1^2 + ... + x_DIM^2)), x_d is x[(d-1)*stride]
+#pragma omp declare simd linear(x) uniform(stride)
+double f(const double x[],	/* in */
+			int stride		/* in */
+			)
+{
+	double r2 = 0.0;
+	int d;
+
+	for( d = 0 ; d < DIM ; d++ )
+	{
+		r2 += x[d * stride] * x[d * stride];
+	}
+	return exp(-r2);
+}
@@ -0,0 +1,346 @@
+/*
+ * integral_vectorized.c
+ *
+ *  Created on: 16-Oct-2026
+ *      Author: prateek
+ *      Desc : Parallel Trapezoidal Rule with a batched, SIMD integrand kernel
+ *      Input :
+ *      	a, b : Limits of integration
+ *      	n : no of trapezoids
+ *      Output :
+ *      	Estimate of the integral from a to b of f(x) computed by the plain
+ *      	scalar kernel and by the vectorized kernel, with the time taken by each.
+ *
+ *      Algorithm:
+ *      1) Each process works out its interval [local_a, local_b] as usual.
+ *      2) Instead of calling f(x) once per point with x = x + h, the interior points
+ *         are handled in blocks of BATCH_SIZE:
+ *         a) x[j] = local_a + i*h is computed from the index i, so there is no loop
+ *            carried dependency and no rounding drift along the interval.
+ *         b) f_batch() evaluates f on the whole block at once.
+ *         c) The block is summed into several independent SIMD accumulators.
+ *      3) The partial results are added up with MPI_Reduce.
+ *
+ *      NOTES:
+ *      	1. f(x) is hardwired, both as f() and as f_batch().
+ *      	2. The AVX-512 or AVX2 kernel is picked at run time from what the CPU
+ *      	   supports. Other machines use the portable kernel with NO_OF_ACCUMULATORS
+ *      	   scalar accumulators.
+ */
+#include <stdio.h>
+#include <mpi/mpi.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define HAVE_X86_SIMD
+#endif
+
+#define BATCH_SIZE			1024	/* Points per call of f_batch, fits easily in L1 */
+#define NO_OF_ACCUMULATORS	8		/* Independent partial sums of the portable kernel */
+
+typedef float (*SUM_KERNEL_T)(const float y[], int count);
+
+void Get_data(float *a_ptr, float *b_ptr, int *n_ptr, int my_rank);
+float calculate_integral( float local_a, float local_b , int local_n , float h );
+float calculate_integral_batched( float local_a, float local_b , int local_n , float h );
+SUM_KERNEL_T Select_sum_kernel(const char **name_ptr);
+float Sum_generic(const float y[], int count);
+float f(float x);
+void f_batch(const float x[], float y[], int count);
+
+/* Kernel picked by Select_sum_kernel() */
+static SUM_KERNEL_T sum_kernel = Sum_generic;
+
+int main(int argc, char **argv)
+{
+	int my_rank;			// My process rank
+	int no_of_process;		// No of processes
+	float a;				// Left endpoint
+	float b;				// Right endpoint
+	int n;					// No of trapezoids
+	float h;				// Trapezoids base length
+	float local_a;			// Left endpoint my process
+	float local_b;			// Right endpoint my process
+	int local_n;			// No of trapezoids for my calculation
+	float integral;			// Integral over my interval
+	float total;			// Total integral
+	const char *kernel_name;
+	double start, scalar_time, batched_time;
+
+	MPI_Init(&argc, &argv);
+	MPI_Comm_rank(MPI_COMM_WORLD, &my_rank);
+	MPI_Comm_size(MPI_COMM_WORLD, &no_of_process);
+
+	Get_data(&a, &b, &n, my_rank);
+	sum_kernel = Select_sum_kernel(&kernel_name);
+
+	h = (b - a) / n;
+	local_n = n / no_of_process;
+	local_a = a + my_rank * local_n * h;
+	local_b = local_a + local_n * h;
+
+	/* Scalar kernel, one f(x) call per point */
+	MPI_Barrier(MPI_COMM_WORLD);
+	start = MPI_Wtime();
+	integral = calculate_integral(local_a, local_b, local_n, h);
+	MPI_Reduce(&integral, &total, 1, MPI_FLOAT, MPI_SUM, 0, MPI_COMM_WORLD);
+	scalar_time = MPI_Wtime() - start;
+
+	if( my_rank == 0 )
+	{
+		printf("Scalar kernel : estimate of integral from %f to %f = %f \n", a, b, total);
+	}
+
+	/* Batched kernel */
+	MPI_Barrier(MPI_COMM_WORLD);
+	start = MPI_Wtime();
+	integral = calculate_integral_batched(local_a, local_b, local_n, h);
+	MPI_Reduce(&integral, &total, 1, MPI_FLOAT, MPI_SUM, 0, MPI_COMM_WORLD);
+	batched_time = MPI_Wtime() - start;
+
+	if( my_rank == 0 )
+	{
+		printf("%s kernel : estimate of integral from %f to %f = %f \n", kernel_name, a, b, total);
+		printf("Elapsed time in seconds : scalar = %e , batched = %e (speedup %.2f) \n",
+				scalar_time, batched_time, scalar_time / batched_time);
+	}
+
+	MPI_Finalize();
+
+	return 0;
+}
+
+/*
+ * Process 0 reads a, b and n and broadcasts them to everyone
+ */
+void Get_data(float *a_ptr,	/* out */
+			float *b_ptr,	/* out */
+			int *n_ptr,		/* out */
+			int my_rank		/* in */
+			)
+{
+	if( my_rank == 0 )
+	{
+		printf("Enter a , b and n \n");
+		scanf("%f %f %d", a_ptr, b_ptr, n_ptr);
+	}
+
+	MPI_Bcast(a_ptr, 1, MPI_FLOAT, 0, MPI_COMM_WORLD);
+	MPI_Bcast(b_ptr, 1, MPI_FLOAT, 0, MPI_COMM_WORLD);
+	MPI_Bcast(n_ptr, 1, MPI_INT, 0, MPI_COMM_WORLD);
+}
+
+/* Function to calculate integral, one f(x) call per point */
+float calculate_integral( float local_a, float local_b , int local_n , float h )
+{
+	float integral;		// Store result of integral
+	float x ;
+	int i;
+
+	integral = ( f(local_a) + f(local_b)) / 2.0;
+	x = local_a;
+
+	for( i = 1 ; i <= local_n-1 ; i++ )
+	{
+		x = x+h;
+		integral = integral + f(x);
+	}
+
+	integral = integral * h;
+	return integral;
+}
+
+/********************************************************************/
+/* Function calculate_integral_batched
+ * Same result as calculate_integral(), but the interior points are
+ * generated from their index and evaluated BATCH_SIZE at a time.
+ ********************************************************************/
+float calculate_integral_batched( float local_a,	/* in */
+			float local_b,							/* in */
+			int local_n,							/* in */
+			float h									/* in */
+			)
+{
+	float x[BATCH_SIZE] __attribute__((aligned(64)));
+	float y[BATCH_SIZE] __attribute__((aligned(64)));
+	float ends[2] = { local_a, local_b };
+	float integral = 0.0;
+	int first;			// Index of the first point in the block
+	int count;			// No of points in the block
+	int j;
+
+	/* Interior points 1 .. local_n-1 */
+	for( first = 1 ; first <= local_n - 1 ; first += BATCH_SIZE )
+	{
+		count = local_n - first;
+		if( count > BATCH_SIZE )
+		{
+			count = BATCH_SIZE;
+		}
+
+		for( j = 0 ; j < count ; j++ )
+		{
+			x[j] = local_a + (float) (first + j) * h;
+		}
+
+		f_batch(x, y, count);
+		integral += sum_kernel(y, count);
+	}
+
+	/* End points count half */
+	f_batch(ends, y, 2);
+	integral += (y[0] + y[1]) / 2.0;
+
+	return integral * h;
+}
+
+/*
+ * Portable sum : NO_OF_ACCUMULATORS independent partial sums so that the
+ * additions do not wait on each other
+ */
+float Sum_generic(const float y[],	/* in */
+			int count				/* in */
+			)
+{
+	float partial[NO_OF_ACCUMULATORS] = {0};
+	float sum = 0.0;
+	int i, k;
+
+	for( i = 0 ; i + NO_OF_ACCUMULATORS <= count ; i += NO_OF_ACCUMULATORS )
+	{
+		for( k = 0 ; k < NO_OF_ACCUMULATORS ; k++ )
+		{
+			partial[k] += y[i + k];
+		}
+	}
+	for( ; i < count ; i++ )
+	{
+		partial[0] += y[i];
+	}
+
+	for( k = 0 ; k < NO_OF_ACCUMULATORS ; k++ )
+	{
+		sum += partial[k];
+	}
+	return sum;
+}
+
+#ifdef HAVE_X86_SIMD
+/*
+ * AVX2 sum : 4 accumulators of 8 floats
+ */
+__attribute__((target("avx2")))
+float Sum_avx2(const float y[],	/* in */
+			int count				/* in */
+			)
+{
+	__m256 acc0 = _mm256_setzero_ps();
+	__m256 acc1 = _mm256_setzero_ps();
+	__m256 acc2 = _mm256_setzero_ps();
+	__m256 acc3 = _mm256_setzero_ps();
+	__m128 low;
+	float sum;
+	int i;
+
+	for( i = 0 ; i + 32 <= count ; i += 32 )
+	{
+		acc0 = _mm256_add_ps(acc0, _mm256_loadu_ps(&y[i]));
+		acc1 = _mm256_add_ps(acc1, _mm256_loadu_ps(&y[i + 8]));
+		acc2 = _mm256_add_ps(acc2, _mm256_loadu_ps(&y[i + 16]));
+		acc3 = _mm256_add_ps(acc3, _mm256_loadu_ps(&y[i + 24]));
+	}
+
+	acc0 = _mm256_add_ps(_mm256_add_ps(acc0, acc1), _mm256_add_ps(acc2, acc3));
+	low = _mm_add_ps(_mm256_castps256_ps128(acc0), _mm256_extractf128_ps(acc0, 1));
+	low = _mm_add_ps(low, _mm_movehl_ps(low, low));
+	low = _mm_add_ss(low, _mm_movehdup_ps(low));
+	sum = _mm_cvtss_f32(low);
+
+	for( ; i < count ; i++ )
+	{
+		sum += y[i];
+	}
+	return sum;
+}
+
+/*
+ * AVX-512 sum : 4 accumulators of 16 floats
+ */
+__attribute__((target("avx512f")))
+float Sum_avx512(const float y[],	/* in */
+			int count				/* in */
+			)
+{
+	__m512 acc0 = _mm512_setzero_ps();
+	__m512 acc1 = _mm512_setzero_ps();
+	__m512 acc2 = _mm512_setzero_ps();
+	__m512 acc3 = _mm512_setzero_ps();
+	float sum;
+	int i;
+
+	for( i = 0 ; i + 64 <= count ; i += 64 )
+	{
+		acc0 = _mm512_add_ps(acc0, _mm512_loadu_ps(&y[i]));
+		acc1 = _mm512_add_ps(acc1, _mm512_loadu_ps(&y[i + 16]));
+		acc2 = _mm512_add_ps(acc2, _mm512_loadu_ps(&y[i + 32]));
+		acc3 = _mm512_add_ps(acc3, _mm512_loadu_ps(&y[i + 48]));
+	}
+
+	acc0 = _mm512_add_ps(_mm512_add_ps(acc0, acc1), _mm512_add_ps(acc2, acc3));
+	sum = _mm512_reduce_add_ps(acc0);
+
+	for( ; i < count ; i++ )
+	{
+		sum += y[i];
+	}
+	return sum;
+}
+#endif
+
+/*
+ * Pick the widest sum kernel the CPU can run
+ */
+SUM_KERNEL_T Select_sum_kernel(const char **name_ptr	/* out */)
+{
+#ifdef HAVE_X86_SIMD
+	__builtin_cpu_init();
+	if( __builtin_cpu_supports("avx512f") )
+	{
+		*name_ptr = "AVX-512";
+		return Sum_avx512;
+	}
+	if( __builtin_cpu_supports("avx2") )
+	{
+		*name_ptr = "AVX2";
+		return Sum_avx2;
+	}
+#endif
+	*name_ptr = "Generic";
+	return Sum_generic;
+}
+
+// f(x) = x^2
+float f(float x)
+{
+	return (x*x);
+}
+
+/*
+ * f(x) applied to count abscissae at once. Built for several instruction
+ * sets, the loader picks the best one for this CPU.
+ */
+#ifdef HAVE_X86_SIMD
+__attribute__((target_clones("avx512f", "avx2", "default")))
+#endif
+void f_batch(const float x[],	/* in */
+			float y[],			/* out */
+			int count			/* in */
+			)
+{
+	int i;
+
+	for( i = 0 ; i < count ; i++ )
+	{
+		y[i] = x[i] * x[i];
+	}
+}
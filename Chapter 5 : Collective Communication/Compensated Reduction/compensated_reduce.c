@@ -0,0 +1,347 @@
+/*
+ * compensated_reduce.c
+ *
+ *  Created on: 16-Oct-2026
+ *      Author: prateek
+ *      Desc : Trapezoidal rule and dot product in float with compensated
+ *      	(Kahan / Neumaier) summation and a matching MPI_Reduce operator.
+ *      Input :
+ *      	a, b : Limits of integration
+ *      	n : no of trapezoids , also the order of the vectors
+ *      Output :
+ *      	The integral and the dot product computed three ways : plain float with
+ *      	MPI_SUM, float with compensation, and double as the reference.
+ *
+ *      Algorithm:
+ *      1) Every sum is kept as a (sum, comp) pair of floats. comp holds the low
+ *         order bits that were lost when values were added to sum.
+ *      2) The trapezoid kernel adds f(x) to the pair with Neumaier's variant of
+ *         Kahan summation. The dot kernel also keeps the rounding error of each
+ *         product, recovered exactly with fmaf. Every COMP_BLOCK terms the pair is
+ *         merged into a running total, so comp itself never grows large enough to
+ *         lose bits.
+ *      3) The pairs are reduced with a committed datatype of two floats and a user
+ *         defined MPI_Op which adds two pairs with an error free TwoSum, so the
+ *         result hardly depends on p or on the order of the reduction.
+ *
+ *      NOTES:
+ *      	1. f(x) and the vectors are hardwired; x(i) = 1/(i+1) and y(i) = (-1)^i,
+ *      	   so the dot product is an alternating series with a lot of cancellation.
+ *      	2. Abscissae are computed from the global index, so every p uses the same
+ *      	   points and only the summation differs.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <mpi/mpi.h>
+
+#define COMP_BLOCK	1024	/* Terms added to a pair before it is merged into the total */
+
+/* Compensated float : the value is sum + comp */
+typedef struct {
+	float sum;
+	float comp;
+} COMP_FLOAT_T;
+
+void Get_data(float *a_ptr, float *b_ptr, int *n_ptr, int my_rank);
+void Build_comp_float_type(MPI_Datatype *comp_mpi_t_ptr);
+void Comp_add(COMP_FLOAT_T *acc, float value);
+void Comp_merge(COMP_FLOAT_T *inout, const COMP_FLOAT_T *in);
+void Comp_sum_op(void *in, void *inout, int *len, MPI_Datatype *datatype);
+COMP_FLOAT_T Comp_trap(float a, float h, int first, int local_n, int n);
+COMP_FLOAT_T Comp_dot(float x[], float y[], int local_n);
+float Plain_trap(float a, float h, int first, int local_n, int n);
+float Plain_dot(float x[], float y[], int local_n);
+float f(float x);
+
+int main(int argc, char **argv)
+{
+	int my_rank;				// My process rank
+	int no_of_process;			// No of processes
+	float a;					// Left endpoint
+	float b;					// Right endpoint
+	int n;						// No of trapezoids and order of vectors
+	float h;					// Trapezoids base length
+	int local_n;				// My no of trapezoids / vector elements
+	int first;					// Global index of my first one
+	float *local_x, *local_y;	// My blocks of the vectors
+	float plain[2];				// My plain integral and dot
+	float plain_total[2];
+	COMP_FLOAT_T comp[2];		// My compensated integral and dot
+	COMP_FLOAT_T comp_total[2];
+	MPI_Datatype comp_mpi_t;
+	MPI_Op comp_sum;
+	double reference_integral = 0.0;
+	double reference_dot = 0.0;
+	int i;
+
+	MPI_Init(&argc, &argv);
+	MPI_Comm_rank(MPI_COMM_WORLD, &my_rank);
+	MPI_Comm_size(MPI_COMM_WORLD, &no_of_process);
+
+	Get_data(&a, &b, &n, my_rank);
+	h = (b - a) / n;
+
+	/* Block distribution, the first n % p processes get one more */
+	local_n = n / no_of_process + (my_rank < n % no_of_process ? 1 : 0);
+	first = my_rank * (n / no_of_process) + (my_rank < n % no_of_process ? my_rank : n % no_of_process);
+
+	local_x = malloc(local_n * sizeof(float));
+	local_y = malloc(local_n * sizeof(float));
+	for( i = 0 ; i < local_n ; i++ )
+	{
+		local_x[i] = 1.0f / (float) (first + i + 1);
+		local_y[i] = ((first + i) % 2) ? -1.0f : 1.0f;
+	}
+
+	/* Plain float with MPI_SUM */
+	plain[0] = Plain_trap(a, h, first, local_n, n);
+	plain[1] = Plain_dot(local_x, local_y, local_n);
+	MPI_Reduce(plain, plain_total, 2, MPI_FLOAT, MPI_SUM, 0, MPI_COMM_WORLD);
+
+	/* Compensated float with the pair operator */
+	Build_comp_float_type(&comp_mpi_t);
+	MPI_Op_create(Comp_sum_op, 1, &comp_sum);
+
+	comp[0] = Comp_trap(a, h, first, local_n, n);
+	comp[1] = Comp_dot(local_x, local_y, local_n);
+	MPI_Reduce(comp, comp_total, 2, comp_mpi_t, comp_sum, 0, MPI_COMM_WORLD);
+
+	MPI_Op_free(&comp_sum);
+	MPI_Type_free(&comp_mpi_t);
+
+	if( my_rank == 0 )
+	{
+		/* Reference in double on the same float abscissae and vectors */
+		reference_integral = ((double) f(a) + (double) f(a + n * h)) / 2.0;
+		for( i = 1 ; i < n ; i++ )
+		{
+			reference_integral += (double) f(a + (float) i * h);
+		}
+		reference_integral *= h;
+		for( i = 0 ; i < n ; i++ )
+		{
+			reference_dot += (double) (1.0f / (float) (i + 1)) * ((i % 2) ? -1.0 : 1.0);
+		}
+
+		printf("With n = %d and p = %d \n", n, no_of_process);
+		printf("Integral : plain = %.9f , compensated = %.9f , double = %.9f \n", plain_total[0],
+				(double) comp_total[0].sum + comp_total[0].comp, reference_integral);
+		printf("Dot      : plain = %.9f , compensated = %.9f , double = %.9f \n", plain_total[1],
+				(double) comp_total[1].sum + comp_total[1].comp, reference_dot);
+	}
+
+	free(local_x);
+	free(local_y);
+	MPI_Finalize();
+
+	return 0;
+}
+
+/*
+ * Process 0 reads a, b and n and broadcasts them to everyone
+ */
+void Get_data(float *a_ptr,	/* out */
+			float *b_ptr,	/* out */
+			int *n_ptr,		/* out */
+			int my_rank		/* in */
+			)
+{
+	if( my_rank == 0 )
+	{
+		printf("Enter a , b and n \n");
+		scanf("%f %f %d", a_ptr, b_ptr, n_ptr);
+	}
+
+	MPI_Bcast(a_ptr, 1, MPI_FLOAT, 0, MPI_COMM_WORLD);
+	MPI_Bcast(b_ptr, 1, MPI_FLOAT, 0, MPI_COMM_WORLD);
+	MPI_Bcast(n_ptr, 1, MPI_INT, 0, MPI_COMM_WORLD);
+}
+
+/*
+ * Datatype of a COMP_FLOAT_T : two contiguous floats
+ */
+void Build_comp_float_type(MPI_Datatype *comp_mpi_t_ptr	/* out */)
+{
+	MPI_Type_contiguous(2, MPI_FLOAT, comp_mpi_t_ptr);
+	MPI_Type_commit(comp_mpi_t_ptr);
+}
+
+/*
+ * Neumaier's summation : add value to acc, keeping the rounding error in comp
+ */
+void Comp_add(COMP_FLOAT_T *acc,	/* in/out */
+			float value				/* in */
+			)
+{
+	float t = acc->sum + value;
+
+	if( fabsf(acc->sum) >= fabsf(value) )
+	{
+		acc->comp += (acc->sum - t) + value;
+	}
+	else
+	{
+		acc->comp += (value - t) + acc->sum;
+	}
+	acc->sum = t;
+}
+
+/********************************************************************/
+/* Function Comp_merge
+ * inout = inout + in. The two sums are added with TwoSum, which gives
+ * the exact rounding error, and the result is renormalized so that
+ * sum holds as much of the value as a float can.
+ ********************************************************************/
+void Comp_merge(COMP_FLOAT_T *inout,	/* in/out */
+			const COMP_FLOAT_T *in		/* in */
+			)
+{
+	float s = inout->sum + in->sum;
+	float bb = s - inout->sum;
+	float error = (inout->sum - (s - bb)) + (in->sum - bb);
+	float comp = inout->comp + in->comp + error;
+	float renormalized = s + comp;
+
+	inout->comp = comp - (renormalized - s);
+	inout->sum = renormalized;
+}
+
+/*
+ * The MPI_Op : merge len pairs of in into inout
+ */
+void Comp_sum_op(void *in,			/* in */
+			void *inout,			/* in/out */
+			int *len,				/* in */
+			MPI_Datatype *datatype	/* in */
+			)
+{
+	COMP_FLOAT_T *in_pairs = (COMP_FLOAT_T *) in;
+	COMP_FLOAT_T *inout_pairs = (COMP_FLOAT_T *) inout;
+	int i;
+
+	(void) datatype;
+	for( i = 0 ; i < *len ; i++ )
+	{
+		Comp_merge(&inout_pairs[i], &in_pairs[i]);
+	}
+}
+
+/********************************************************************/
+/* Function Comp_trap
+ * Trapezoidal rule over the points first .. first+local_n of the global
+ * mesh a + i*h. The end points of [a,b] count half; the point shared by
+ * two processes is counted by the one on its left, and b only by the
+ * process with the last trapezoid, not by those with none.
+ ********************************************************************/
+COMP_FLOAT_T Comp_trap(float a,	/* in */
+			float h,			/* in */
+			int first,			/* in */
+			int local_n,		/* in */
+			int n				/* in */
+			)
+{
+	COMP_FLOAT_T acc = { 0.0f, 0.0f };
+	COMP_FLOAT_T total = { 0.0f, 0.0f };
+	COMP_FLOAT_T result;
+	float product;
+	int i;
+
+	for( i = first ; i < first + local_n ; i++ )
+	{
+		Comp_add(&acc, (i == 0) ? f(a) / 2.0f : f(a + (float) i * h));
+		if( (i - first + 1) % COMP_BLOCK == 0 )
+		{
+			Comp_merge(&total, &acc);
+			acc.sum = acc.comp = 0.0f;
+		}
+	}
+	if( local_n > 0 && first + local_n == n )
+	{
+		Comp_add(&acc, f(a + (float) n * h) / 2.0f);
+	}
+	Comp_merge(&total, &acc);
+
+	/* Multiply by h, keeping the rounding error of the product */
+	product = total.sum * h;
+	result.sum = product;
+	result.comp = fmaf(total.sum, h, -product) + total.comp * h;
+	return result;
+}
+
+/*
+ * Dot product of two blocks. TwoProduct with fmaf gives each product's
+ * rounding error, which goes into comp with the summation errors.
+ */
+COMP_FLOAT_T Comp_dot(float x[],	/* in */
+			float y[],				/* in */
+			int local_n				/* in */
+			)
+{
+	COMP_FLOAT_T acc = { 0.0f, 0.0f };
+	COMP_FLOAT_T total = { 0.0f, 0.0f };
+	float product;
+	int i;
+
+	for( i = 0 ; i < local_n ; i++ )
+	{
+		product = x[i] * y[i];
+		acc.comp += fmaf(x[i], y[i], -product);
+		Comp_add(&acc, product);
+		if( (i + 1) % COMP_BLOCK == 0 )
+		{
+			Comp_merge(&total, &acc);
+			acc.sum = acc.comp = 0.0f;
+		}
+	}
+	Comp_merge(&total, &acc);
+	return total;
+}
+
+/*
+ * Same trapezoidal rule with a plain float sum
+ */
+float Plain_trap(float a,	/* in */
+			float h,		/* in */
+			int first,		/* in */
+			int local_n,	/* in */
+			int n			/* in */
+			)
+{
+	float integral = 0.0;
+	int i;
+
+	for( i = first ; i < first + local_n ; i++ )
+	{
+		integral += (i == 0) ? f(a) / 2.0f : f(a + (float) i * h);
+	}
+	if( local_n > 0 && first + local_n == n )
+	{
+		integral += f(a + (float) n * h) / 2.0f;
+	}
+	return integral * h;
+}
+
+/*
+ * Dot product of two blocks with a plain float sum
+ */
+float Plain_dot(float x[],	/* in */
+			float y[],		/* in */
+			int local_n		/* in */
+			)
+{
+	float sum = 0.0;
+	int i;
+
+	for( i = 0 ; i < local_n ; i++ )
+	{
+		sum += x[i] * y[i];
+	}
+	return sum;
+}
+
+// f(x) = x^2
+float f(float x)
+{
+	return (x*x);
+}
@@ -0,0 +1,238 @@
+/*
+ * dense_matrix.c
+ *
+ *  Created on: 16-Oct-2026
+ *      Author: prateek
+ *      Desc : Dense local matrices and a fast y = Ax.
+ *      	The entries are one aligned allocation, row after row. A row takes
+ *      	cols floats rounded up to a whole cache line, not MAX_ORDER, so a
+ *      	1000 x 10 block takes 16 KB instead of 1000 x MAX_ORDER floats, and every
+ *      	row starts on a cache line.
+ *
+ *      	Dense_gemv is blocked two ways :
+ *      	1) Columns are done GEMV_COL_BLOCK at a time, so that piece of x stays in
+ *      	   L1 while every row goes past it.
+ *      	2) GEMV_ROW_BLOCK rows are done together. Each x(j) that is loaded is used
+ *      	   for all of them, and their sums are independent SIMD accumulators.
+ *
+ *      	Dense_gemm multiplies A by k vectors at once, the rows of an n x k panel X.
+ *      	A 4 x GEMM_LANES block of Y stays in registers while the loop runs down a
+ *      	block of GEMM_COL_BLOCK rows of X, so each A(i,j) is loaded once for
+ *      	GEMM_LANES vectors instead of once per vector.
+ */
+#include <stdlib.h>
+#include <string.h>
+#include "dense_matrix.h"
+
+#define GEMV_ROW_BLOCK	4		/* Rows sharing each load of x */
+#define GEMV_COL_BLOCK	2048	/* Columns per pass : 8 KB of x */
+#define GEMM_LANES		16		/* Vectors per register block : one cache line of X */
+#define GEMM_COL_BLOCK	256		/* Rows of X per pass : 16 KB of X */
+
+/*
+ * Allocate a rows x cols matrix, entries and padding set to 0
+ */
+DENSE_MATRIX_T *Dense_matrix_allocate(int rows,	/* in */
+			int cols							/* in */
+			)
+{
+	DENSE_MATRIX_T *A = malloc(sizeof(DENSE_MATRIX_T));
+	size_t bytes;
+
+	if( A == NULL )
+	{
+		return NULL;
+	}
+	A->rows = rows;
+	A->cols = cols;
+	A->stride = (cols + DENSE_ALIGN / sizeof(float) - 1) / (DENSE_ALIGN / sizeof(float))
+			* (DENSE_ALIGN / sizeof(float));
+
+	bytes = (size_t) rows * A->stride * sizeof(float);
+	A->entries = aligned_alloc(DENSE_ALIGN, bytes > 0 ? bytes : DENSE_ALIGN);
+	if( A->entries == NULL )
+	{
+		free(A);
+		return NULL;
+	}
+	memset(A->entries, 0, bytes);
+	return A;
+}
+
+void Dense_matrix_free(DENSE_MATRIX_T **A	/* in/out */)
+{
+	if( *A != NULL )
+	{
+		free((*A)->entries);
+		free(*A);
+		*A = NULL;
+	}
+}
+
+/********************************************************************/
+/* Function Dense_gemv_block
+ * y += columns col_start .. col_start + no_of_cols - 1 of A times
+ * x_block. GEMV_ROW_BLOCK rows share one pass over x_block; the rows
+ * that are left over go one at a time.
+ ********************************************************************/
+void Dense_gemv_block(const DENSE_MATRIX_T *A,	/* in */
+			int col_start,						/* in */
+			int no_of_cols,						/* in */
+			const float x_block[],				/* in */
+			float y[]							/* in/out */
+			)
+{
+	const float *row_0, *row_1, *row_2, *row_3;
+	float sum_0, sum_1, sum_2, sum_3;
+	int i, j;
+
+	for( i = 0 ; i + GEMV_ROW_BLOCK <= A->rows ; i += GEMV_ROW_BLOCK )
+	{
+		row_0 = Row(A, i) + col_start;
+		row_1 = Row(A, i + 1) + col_start;
+		row_2 = Row(A, i + 2) + col_start;
+		row_3 = Row(A, i + 3) + col_start;
+		sum_0 = sum_1 = sum_2 = sum_3 = 0.0f;
+
+#pragma omp simd reduction(+:sum_0,sum_1,sum_2,sum_3)
+		for( j = 0 ; j < no_of_cols ; j++ )
+		{
+			sum_0 += row_0[j] * x_block[j];
+			sum_1 += row_1[j] * x_block[j];
+			sum_2 += row_2[j] * x_block[j];
+			sum_3 += row_3[j] * x_block[j];
+		}
+
+		y[i] += sum_0;
+		y[i + 1] += sum_1;
+		y[i + 2] += sum_2;
+		y[i + 3] += sum_3;
+	}
+
+	for( ; i < A->rows ; i++ )
+	{
+		row_0 = Row(A, i) + col_start;
+		sum_0 = 0.0f;
+
+#pragma omp simd reduction(+:sum_0)
+		for( j = 0 ; j < no_of_cols ; j++ )
+		{
+			sum_0 += row_0[j] * x_block[j];
+		}
+		y[i] += sum_0;
+	}
+}
+
+/*
+ * y = A x , GEMV_COL_BLOCK columns at a time
+ */
+void Dense_gemv(const DENSE_MATRIX_T *A,	/* in */
+			const float x[],				/* in */
+			float y[]						/* out */
+			)
+{
+	int col_start, count;
+
+	memset(y, 0, A->rows * sizeof(float));
+
+	for( col_start = 0 ; col_start < A->cols ; col_start += GEMV_COL_BLOCK )
+	{
+		count = (A->cols - col_start < GEMV_COL_BLOCK) ? A->cols - col_start : GEMV_COL_BLOCK;
+		Dense_gemv_block(A, col_start, count, &x[col_start], y);
+	}
+}
+
+/********************************************************************/
+/* Function Dense_gemm
+ * Y = A X. The stride of X is a multiple of GEMM_LANES, so every row
+ * of X can be read in whole blocks of GEMM_LANES; the padding of X is
+ * 0 and the padding of Y gets whatever comes out.
+ * Algorithm:
+ *     1.  Y = 0.
+ *     2.  For every block of GEMM_COL_BLOCK rows of X ( columns of A ),
+ *         for every 4 rows i of A and every GEMM_LANES columns l of X :
+ *             load the 4 x GEMM_LANES block of Y,
+ *             for every j of the block : Y(i,l) += A(i,j) * X(j,l),
+ *             store it back.
+ *         Rows of A left over are done one at a time.
+ ********************************************************************/
+void Dense_gemm(const DENSE_MATRIX_T *A,	/* in */
+			const DENSE_MATRIX_T *X,		/* in */
+			DENSE_MATRIX_T *Y				/* out */
+			)
+{
+	float acc_0[GEMM_LANES], acc_1[GEMM_LANES], acc_2[GEMM_LANES], acc_3[GEMM_LANES];
+	const float *x_row;
+	float a_0, a_1, a_2, a_3;
+	float *y_0, *y_1, *y_2, *y_3;
+	int j_start, j_end;
+	int i, j, l, lane;
+
+	memset(Y->entries, 0, (size_t) Y->rows * Y->stride * sizeof(float));
+
+	for( j_start = 0 ; j_start < A->cols ; j_start += GEMM_COL_BLOCK )
+	{
+		j_end = (A->cols - j_start < GEMM_COL_BLOCK) ? A->cols : j_start + GEMM_COL_BLOCK;
+
+		for( i = 0 ; i + 4 <= A->rows ; i += 4 )
+		{
+			for( l = 0 ; l < X->cols ; l += GEMM_LANES )
+			{
+				y_0 = Row(Y, i) + l;
+				y_1 = Row(Y, i + 1) + l;
+				y_2 = Row(Y, i + 2) + l;
+				y_3 = Row(Y, i + 3) + l;
+				for( lane = 0 ; lane < GEMM_LANES ; lane++ )
+				{
+					acc_0[lane] = y_0[lane];
+					acc_1[lane] = y_1[lane];
+					acc_2[lane] = y_2[lane];
+					acc_3[lane] = y_3[lane];
+				}
+
+				for( j = j_start ; j < j_end ; j++ )
+				{
+					a_0 = Entry(A, i, j);
+					a_1 = Entry(A, i + 1, j);
+					a_2 = Entry(A, i + 2, j);
+					a_3 = Entry(A, i + 3, j);
+					x_row = Row(X, j) + l;
+#pragma omp simd
+					for( lane = 0 ; lane < GEMM_LANES ; lane++ )
+					{
+						acc_0[lane] += a_0 * x_row[lane];
+						acc_1[lane] += a_1 * x_row[lane];
+						acc_2[lane] += a_2 * x_row[lane];
+						acc_3[lane] += a_3 * x_row[lane];
+					}
+				}
+
+				for( lane = 0 ; lane < GEMM_LANES ; lane++ )
+				{
+					y_0[lane] = acc_0[lane];
+					y_1[lane] = acc_1[lane];
+					y_2[lane] = acc_2[lane];
+					y_3[lane] = acc_3[lane];
+				}
+			}
+		}
+
+		for( ; i < A->rows ; i++ )
+		{
+			for( l = 0 ; l < X->cols ; l += GEMM_LANES )
+			{
+				y_0 = Row(Y, i) + l;
+				for( j = j_start ; j < j_end ; j++ )
+				{
+					a_0 = Entry(A, i, j);
+					x_row = Row(X, j) + l;
+#pragma omp simd
+					for( lane = 0 ; lane < GEMM_LANES ; lane++ )
+					{
+						y_0[lane] += a_0 * x_row[lane];
+					}
+				}
+			}
+		}
+	}
+}
@@ -0,0 +1,61 @@
+/*
+ * dense_matrix.h
+ *
+ *  Created on: 16-Oct-2026
+ *      Author: prateek
+ *      Desc : Header for dense_matrix.c -- a local block of a matrix with its
+ *      	dimensions chosen at runtime, in place of the MAX_ORDER x MAX_ORDER
+ *      	arrays of LOCAL_MATRIX_T and MATRIX_T, and y = Ax on it.
+ */
+#ifndef DENSE_MATRIX_H
+#define DENSE_MATRIX_H
+
+/* Rows start on a cache line : the stride is a multiple of 16 floats */
+#define DENSE_ALIGN		64
+
+typedef struct {
+	int rows;
+	int cols;
+	int stride;			/* Floats from one row to the next : cols rounded up */
+	float *entries;		/* rows * stride floats, DENSE_ALIGN aligned */
+} DENSE_MATRIX_T;
+
+#define Entry(A,i,j)	((A)->entries[(size_t) (i) * (A)->stride + (j)])
+#define Row(A,i)		(&(A)->entries[(size_t) (i) * (A)->stride])
+
+/* Entries and padding set to 0. Returns NULL if there is not enough memory */
+DENSE_MATRIX_T *Dense_matrix_allocate(
+		int rows,					/* in */
+		int cols					/* in */
+		);
+
+void Dense_matrix_free(
+		DENSE_MATRIX_T **A			/* in/out */
+		);
+
+/* y = A x , x has A->cols elements and y has A->rows */
+void Dense_gemv(
+		const DENSE_MATRIX_T *A,	/* in */
+		const float x[],			/* in */
+		float y[]					/* out */
+		);
+
+/* y += columns col_start .. col_start + no_of_cols - 1 of A times x_block,
+ * for a product whose pieces of x arrive one at a time */
+void Dense_gemv_block(
+		const DENSE_MATRIX_T *A,	/* in */
+		int col_start,				/* in */
+		int no_of_cols,				/* in */
+		const float x_block[],		/* in */
+		float y[]					/* in/out */
+		);
+
+/* Y = A X for k vectors at once : X is A->cols x k, Y is A->rows x k.
+ * Each row of X holds element j of all k vectors */
+void Dense_gemm(
+		const DENSE_MATRIX_T *A,	/* in */
+		const DENSE_MATRIX_T *X,	/* in */
+		DENSE_MATRIX_T *Y			/* out */
+		);
+
+#endif /* DENSE_MATRIX_H */
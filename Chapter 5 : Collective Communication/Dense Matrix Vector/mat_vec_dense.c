@@ -0,0 +1,220 @@
+/*
+ * mat_vec_dense.c
+ *
+ *  Created on: 16-Oct-2026
+ *      Author: prateek
+ *      Desc : The row panel matrix-vector product of chap05/parallel_mat_vect.c
+ *      	on DENSE_MATRIX_T blocks of any size, with the plain loop of the book and
+ *      	with Dense_gemv.
+ *      Input :
+ *      	m, n : order of the matrix
+ *      Output :
+ *      	The time of one product and the rate at which each process streams its
+ *      	block of A, for both kernels, and whether their y agree.
+ *
+ *      Algorithm:
+ *      1) Process r gets row block r of A and block r of x. The first m % p
+ *         (n % p) processes get one row (element) more.
+ *      2) MPI_Allgatherv gives everyone all of x.
+ *      3) Each process multiplies its rows by x, with the plain loop of the book
+ *         or with Dense_gemv.
+ *
+ *      NOTES:
+ *      	1. A(i,j) = (i + 2j) % 7 - 3 and x(j) = j % 5 - 2, so every sum is an
+ *      	   integer, exact in float in any order, and both kernels must agree.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <mpi/mpi.h>
+#include "dense_matrix.h"
+
+#define REPS	20
+
+void Get_data(int *m_ptr, int *n_ptr, int my_rank);
+void Block_range(int n, int no_of_blocks, int block, int *first_ptr, int *count_ptr);
+void Plain_mat_vec(const DENSE_MATRIX_T *A, const float x[], float y[]);
+double Time_product(int use_gemv, const DENSE_MATRIX_T *local_A, const float local_x[], int local_n,
+		const int x_counts[], const int x_displacements[], float global_x[], float local_y[]);
+
+int main(int argc, char **argv)
+{
+	int my_rank;
+	int no_of_process;
+	int m, n;
+	int local_m, first_row, local_n, first_col;
+	int *x_counts, *x_displacements;
+	DENSE_MATRIX_T *local_A;
+	float *local_x, *global_x, *y_plain, *y_gemv;
+	double seconds[2];
+	int ok, all_ok;
+	int rank, i, j;
+
+	MPI_Init(&argc, &argv);
+	MPI_Comm_rank(MPI_COMM_WORLD, &my_rank);
+	MPI_Comm_size(MPI_COMM_WORLD, &no_of_process);
+
+	Get_data(&m, &n, my_rank);
+
+	Block_range(m, no_of_process, my_rank, &first_row, &local_m);
+	Block_range(n, no_of_process, my_rank, &first_col, &local_n);
+	x_counts = malloc(no_of_process * sizeof(int));
+	x_displacements = malloc(no_of_process * sizeof(int));
+	for( rank = 0 ; rank < no_of_process ; rank++ )
+	{
+		Block_range(n, no_of_process, rank, &x_displacements[rank], &x_counts[rank]);
+	}
+
+	local_A = Dense_matrix_allocate(local_m, n);
+	local_x = malloc((local_n + 1) * sizeof(float));
+	global_x = malloc((n + 1) * sizeof(float));
+	y_plain = malloc((local_m + 1) * sizeof(float));
+	y_gemv = malloc((local_m + 1) * sizeof(float));
+	ok = (local_A != NULL);
+	MPI_Allreduce(&ok, &all_ok, 1, MPI_INT, MPI_MIN, MPI_COMM_WORLD);
+	if( !all_ok )
+	{
+		if( my_rank == 0 )
+		{
+			fprintf(stderr, "Cannot allocate the matrix \n");
+		}
+		MPI_Abort(MPI_COMM_WORLD, 1);
+	}
+
+	for( i = 0 ; i < local_m ; i++ )
+	{
+		for( j = 0 ; j < n ; j++ )
+		{
+			Entry(local_A, i, j) = (float) ((first_row + i + 2 * j) % 7 - 3);
+		}
+	}
+	for( j = 0 ; j < local_n ; j++ )
+	{
+		local_x[j] = (float) ((first_col + j) % 5 - 2);
+	}
+
+	seconds[0] = Time_product(0, local_A, local_x, local_n, x_counts, x_displacements, global_x, y_plain);
+	seconds[1] = Time_product(1, local_A, local_x, local_n, x_counts, x_displacements, global_x, y_gemv);
+
+	ok = 1;
+	for( i = 0 ; i < local_m ; i++ )
+	{
+		ok &= (y_plain[i] == y_gemv[i]);
+	}
+	MPI_Reduce(&ok, &all_ok, 1, MPI_INT, MPI_MIN, 0, MPI_COMM_WORLD);
+
+	if( my_rank == 0 )
+	{
+		printf("m = %d , n = %d , p = %d \n", m, n, no_of_process);
+		printf("Plain loop : %e s per product , %8.2f GB/s of A per process \n", seconds[0],
+				(double) local_m * n * sizeof(float) / seconds[0] / 1.0e9);
+		printf("Dense_gemv : %e s per product , %8.2f GB/s of A per process \n", seconds[1],
+				(double) local_m * n * sizeof(float) / seconds[1] / 1.0e9);
+		printf("Both give the same y : %s \n", all_ok ? "yes" : "no");
+	}
+
+	Dense_matrix_free(&local_A);
+	free(local_x);
+	free(global_x);
+	free(y_plain);
+	free(y_gemv);
+	free(x_counts);
+	free(x_displacements);
+	MPI_Finalize();
+
+	return 0;
+}
+
+/*
+ * Process 0 reads the order of the matrix and broadcasts it
+ */
+void Get_data(int *m_ptr,	/* out */
+			int *n_ptr,		/* out */
+			int my_rank		/* in */
+			)
+{
+	if( my_rank == 0 )
+	{
+		printf("Enter the order of the matrix (m x n)\n");
+		scanf("%d %d", m_ptr, n_ptr);
+	}
+
+	MPI_Bcast(m_ptr, 1, MPI_INT, 0, MPI_COMM_WORLD);
+	MPI_Bcast(n_ptr, 1, MPI_INT, 0, MPI_COMM_WORLD);
+}
+
+/*
+ * First index and length of block number block of n split into no_of_blocks.
+ * The first n % no_of_blocks blocks get one more.
+ */
+void Block_range(int n,			/* in */
+			int no_of_blocks,	/* in */
+			int block,			/* in */
+			int *first_ptr,		/* out */
+			int *count_ptr		/* out */
+			)
+{
+	int quotient = n / no_of_blocks;
+	int remainder = n % no_of_blocks;
+
+	*count_ptr = quotient + (block < remainder ? 1 : 0);
+	*first_ptr = block * quotient + (block < remainder ? block : remainder);
+}
+
+/*
+ * The loop of Parallel_matrix_vector_prod in parallel_mat_vect.c
+ */
+void Plain_mat_vec(const DENSE_MATRIX_T *A,	/* in */
+			const float x[],				/* in */
+			float y[]						/* out */
+			)
+{
+	int i, j;
+
+	for( i = 0 ; i < A->rows ; i++ )
+	{
+		y[i] = 0.0;
+		for( j = 0 ; j < A->cols ; j++ )
+		{
+			y[i] = y[i] + Entry(A, i, j) * x[j];
+		}
+	}
+}
+
+/********************************************************************/
+/* Function Time_product
+ * Slowest process's time for one MPI_Allgatherv of x followed by the
+ * local product, averaged over REPS products.
+ ********************************************************************/
+double Time_product(int use_gemv,		/* in */
+			const DENSE_MATRIX_T *local_A,	/* in */
+			const float local_x[],		/* in */
+			int local_n,				/* in */
+			const int x_counts[],		/* in */
+			const int x_displacements[],	/* in */
+			float global_x[],			/* scratch */
+			float local_y[]				/* out */
+			)
+{
+	double start, elapsed, max_elapsed;
+	int rep;
+
+	MPI_Barrier(MPI_COMM_WORLD);
+	start = MPI_Wtime();
+	for( rep = 0 ; rep < REPS ; rep++ )
+	{
+		MPI_Allgatherv(local_x, local_n, MPI_FLOAT, global_x, x_counts, x_displacements, MPI_FLOAT,
+				MPI_COMM_WORLD);
+		if( use_gemv )
+		{
+			Dense_gemv(local_A, global_x, local_y);
+		}
+		else
+		{
+			Plain_mat_vec(local_A, global_x, local_y);
+		}
+	}
+	elapsed = (MPI_Wtime() - start) / REPS;
+
+	MPI_Allreduce(&elapsed, &max_elapsed, 1, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+	return max_elapsed;
+}
@@ -0,0 +1,186 @@
+/*
+ * dist_dot.c
+ *
+ *  Created on: 16-Oct-2026
+ *      Author: prateek
+ *      Desc : Distributed dot products without the MAX_LOCAL_ORDER limit of
+ *      	parellel_dot_mpi_all_reduce.c. The blocks live on the heap, start on a
+ *      	cache line and may hold more than 2^31 elements.
+ *
+ *      	The local kernel works on cache blocks of DOT_BLOCK elements. Inside a
+ *      	block it keeps LANES float partial sums, which the compiler turns into
+ *      	several independent SIMD accumulators, so consecutive multiply-adds do not
+ *      	wait for each other. Each block's sum is then added in double, so the
+ *      	float partial sums never get long enough to lose much.
+ *
+ *      	Parallel_dots does several dot products in the same sweep : for every
+ *      	cache block it does all the pairs, so a vector used in several pairs is
+ *      	read from memory once, and the results go in one MPI_Allreduce. An
+ *      	iterative solver needing x . y and x . x pays one latency instead of two.
+ */
+#include <stdlib.h>
+#include <string.h>
+#include "dist_dot.h"
+
+#define LANES		32		/* Float partial sums : 4 AVX registers of 8 */
+#define DOT_BLOCK	2048	/* Elements per cache block, a multiple of LANES */
+
+/*
+ * Allocate my block of a vector of order global_n
+ */
+int Vector_alloc(DIST_VECTOR_T *v,	/* out */
+			int64_t global_n,		/* in */
+			MPI_Comm comm			/* in */
+			)
+{
+	int my_rank, p;
+	int64_t quotient, remainder;
+	size_t bytes;
+
+	MPI_Comm_rank(comm, &my_rank);
+	MPI_Comm_size(comm, &p);
+
+	quotient = global_n / p;
+	remainder = global_n % p;
+	v->global_n = global_n;
+	v->local_n = quotient + (my_rank < remainder ? 1 : 0);
+	v->first = my_rank * quotient + (my_rank < remainder ? my_rank : remainder);
+
+	/* aligned_alloc wants a whole number of cache lines */
+	bytes = (size_t) v->local_n * sizeof(float);
+	bytes = (bytes + CACHE_LINE - 1) / CACHE_LINE * CACHE_LINE;
+	if( bytes == 0 )
+	{
+		bytes = CACHE_LINE;
+	}
+	v->data = aligned_alloc(CACHE_LINE, bytes);
+
+	return v->data != NULL;
+}
+
+void Vector_free(DIST_VECTOR_T *v	/* in/out */)
+{
+	free(v->data);
+	v->data = NULL;
+	v->local_n = 0;
+}
+
+/********************************************************************/
+/* Function Block_dot
+ * Dot product of at most DOT_BLOCK elements. Lane j of acc sums the
+ * products j, j + LANES, j + 2*LANES, ... The inner loop is one SIMD
+ * multiply-add per register of acc, all of them independent.
+ ********************************************************************/
+static double Block_dot(const float *x,	/* in */
+			const float *y,				/* in */
+			int n						/* in */
+			)
+{
+	float acc[LANES];
+	float tail = 0.0f;
+	double sum = 0.0;
+	int i, j;
+
+	memset(acc, 0, sizeof(acc));
+	for( i = 0 ; i + LANES <= n ; i += LANES )
+	{
+#pragma omp simd
+		for( j = 0 ; j < LANES ; j++ )
+		{
+			acc[j] += x[i + j] * y[i + j];
+		}
+	}
+	for( ; i < n ; i++ )
+	{
+		tail += x[i] * y[i];
+	}
+
+	for( j = 0 ; j < LANES ; j++ )
+	{
+		sum += acc[j];
+	}
+	return sum + tail;
+}
+
+/*
+ * Dot product of two local blocks, one cache block at a time
+ */
+double Local_dot(const float *x,	/* in */
+			const float *y,			/* in */
+			int64_t n				/* in */
+			)
+{
+	double sum = 0.0;
+	int64_t start;
+
+	for( start = 0 ; start < n ; start += DOT_BLOCK )
+	{
+		sum += Block_dot(&x[start], &y[start], (n - start < DOT_BLOCK) ? (int) (n - start) : DOT_BLOCK);
+	}
+	return sum;
+}
+
+/*
+ * x . y : local dot, then MPI_Allreduce
+ */
+double Parallel_dot(const DIST_VECTOR_T *x,	/* in */
+			const DIST_VECTOR_T *y,			/* in */
+			MPI_Comm comm					/* in */
+			)
+{
+	double local_dot;
+	double dot;
+
+	local_dot = Local_dot(x->data, y->data, x->local_n);
+	MPI_Allreduce(&local_dot, &dot, 1, MPI_DOUBLE, MPI_SUM, comm);
+
+	return dot;
+}
+
+/********************************************************************/
+/* Function Parallel_dots
+ * Algorithm:
+ *     For each group of up to MAX_DOTS pairs :
+ *     1.  For every cache block of the local vectors, add the block's dot
+ *         product of every pair to local_dots. The pairs of one block
+ *         share the vectors while they are in cache.
+ *     2.  One MPI_Allreduce of the group's sums.
+ * All the vectors must have the same distribution.
+ ********************************************************************/
+void Parallel_dots(int no_of_dots,	/* in */
+			const DIST_VECTOR_T *xs[],	/* in */
+			const DIST_VECTOR_T *ys[],	/* in */
+			double dots[],			/* out */
+			MPI_Comm comm			/* in */
+			)
+{
+	double local_dots[MAX_DOTS];
+	int64_t local_n, start;
+	int first, group;
+	int count;
+	int k;
+
+	local_n = (no_of_dots > 0) ? xs[0]->local_n : 0;
+
+	for( first = 0 ; first < no_of_dots ; first += MAX_DOTS )
+	{
+		group = (no_of_dots - first < MAX_DOTS) ? no_of_dots - first : MAX_DOTS;
+
+		/* 1. */
+		for( k = 0 ; k < group ; k++ )
+		{
+			local_dots[k] = 0.0;
+		}
+		for( start = 0 ; start < local_n ; start += DOT_BLOCK )
+		{
+			count = (local_n - start < DOT_BLOCK) ? (int) (local_n - start) : DOT_BLOCK;
+			for( k = 0 ; k < group ; k++ )
+			{
+				local_dots[k] += Block_dot(&xs[first + k]->data[start], &ys[first + k]->data[start], count);
+			}
+		}
+
+		/* 2. */
+		MPI_Allreduce(local_dots, &dots[first], group, MPI_DOUBLE, MPI_SUM, comm);
+	}
+}
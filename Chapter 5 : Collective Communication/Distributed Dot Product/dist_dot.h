@@ -0,0 +1,69 @@
+/*
+ * dist_dot.h
+ *
+ *  Created on: 16-Oct-2026
+ *      Author: prateek
+ *      Desc : Header for dist_dot.c -- block distributed float vectors of any
+ *      	(64 bit) order on the heap, and dot products over them with one
+ *      	MPI_Allreduce for any number of pairs.
+ */
+#ifndef DIST_DOT_H
+#define DIST_DOT_H
+
+#include <stdint.h>
+#include <mpi/mpi.h>
+
+/* Vectors start on a cache line */
+#define CACHE_LINE		64
+
+/* Most pairs Parallel_dots does in one pass and one MPI_Allreduce */
+#define MAX_DOTS		16
+
+/* My block of a vector of order global_n */
+typedef struct {
+	int64_t global_n;	/* Order of the whole vector         */
+	int64_t local_n;	/* No of elements I hold             */
+	int64_t first;		/* Global index of my first element  */
+	float *data;		/* CACHE_LINE aligned, local_n long  */
+} DIST_VECTOR_T;
+
+/* Allocate my block of a vector of order global_n distributed over comm.
+ * The first global_n % p processes get one element more. Returns 0 if
+ * the allocation failed */
+int Vector_alloc(
+		DIST_VECTOR_T *v,			/* out */
+		int64_t global_n,			/* in */
+		MPI_Comm comm				/* in */
+		);
+
+void Vector_free(
+		DIST_VECTOR_T *v			/* in/out */
+		);
+
+/* Dot product of two local blocks of n elements, in double */
+double Local_dot(
+		const float *x,				/* in */
+		const float *y,				/* in */
+		int64_t n					/* in */
+		);
+
+/* x . y over comm; every process gets the result */
+double Parallel_dot(
+		const DIST_VECTOR_T *x,		/* in */
+		const DIST_VECTOR_T *y,		/* in */
+		MPI_Comm comm				/* in */
+		);
+
+/* dots[k] = xs[k] . ys[k] for k < no_of_dots, with a single pass over
+ * each cache block of the vectors and a single MPI_Allreduce for every
+ * MAX_DOTS pairs. The same vector may appear in several pairs, e.g.
+ * x . y and x . x */
+void Parallel_dots(
+		int no_of_dots,				/* in */
+		const DIST_VECTOR_T *xs[],	/* in */
+		const DIST_VECTOR_T *ys[],	/* in */
+		double dots[],				/* out */
+		MPI_Comm comm				/* in */
+		);
+
+#endif /* DIST_DOT_H */
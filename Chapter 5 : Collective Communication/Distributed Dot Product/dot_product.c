@@ -0,0 +1,215 @@
+/*
+ * dot_product.c
+ *
+ *  Created on: 16-Oct-2026
+ *      Author: prateek
+ *      Desc : Distributed dot product of vectors of any order with dist_dot.c,
+ *      	timed against the single accumulator loop of parellel_dot_mpi_all_reduce.c.
+ *      Input :
+ *      	n : order of the vectors (may be more than 2^31)
+ *      Output :
+ *      	x . y and x . x with their exact values, and the time per call and the
+ *      	bandwidth per process of :
+ *      		scalar : one float accumulator ( serial_dot ) and MPI_Allreduce
+ *      		simd   : Parallel_dot
+ *      		2 dots : Parallel_dot for x . y, then for x . x
+ *      		fused  : Parallel_dots for both, one MPI_Allreduce
+ *
+ *      Algorithm:
+ *      1) Every process allocates its block and fills it from the global index,
+ *         so no input has to be read for the vectors.
+ *      2) Each method is run REPS times between two barriers; the time is the max
+ *         over processes.
+ *
+ *      NOTES:
+ *      	1. x(i) = 1 + (i % 3) / 2 and y(i) = (i % 8) - 3.5. Every product and every
+ *      	   partial sum of a cache block is exact in float, so the simd results must
+ *      	   match the exact values to the last digit.
+ *      	2. The Makefile builds without -ffast-math, so the scalar loop really has a
+ *      	   single accumulator; the simd kernel needs no reassociation.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <mpi/mpi.h>
+#include "dist_dot.h"
+
+#define REPS	10
+
+void Get_data(int64_t *n_ptr, int my_rank);
+void Fill_vectors(DIST_VECTOR_T *x, DIST_VECTOR_T *y);
+void Exact_dots(int64_t n, double *xy_ptr, double *xx_ptr);
+float serial_dot(const float x[], const float y[], int64_t n);
+
+int main(int argc, char **argv)
+{
+	int my_rank;
+	int no_of_process;
+	int64_t n;
+	DIST_VECTOR_T x, y;
+	const DIST_VECTOR_T *xs[2];
+	const DIST_VECTOR_T *ys[2];
+	double dots[2];
+	double xy = 0.0, xx = 0.0;
+	double exact_xy, exact_xx;
+	float local_scalar, scalar_xy = 0.0f;
+	double start, elapsed, seconds[4];
+	int ok, all_ok;
+	int method, rep;
+	const char *names[4] = { "scalar", "simd", "2 dots", "fused" };
+	const int vectors_read[4] = { 2, 2, 3, 2 };
+
+	MPI_Init(&argc, &argv);
+	MPI_Comm_rank(MPI_COMM_WORLD, &my_rank);
+	MPI_Comm_size(MPI_COMM_WORLD, &no_of_process);
+
+	Get_data(&n, my_rank);
+
+	ok = Vector_alloc(&x, n, MPI_COMM_WORLD) && Vector_alloc(&y, n, MPI_COMM_WORLD);
+	MPI_Allreduce(&ok, &all_ok, 1, MPI_INT, MPI_MIN, MPI_COMM_WORLD);
+	if( !all_ok )
+	{
+		if( my_rank == 0 )
+		{
+			fprintf(stderr, "Cannot allocate vectors of order %lld \n", (long long) n);
+		}
+		MPI_Abort(MPI_COMM_WORLD, 1);
+	}
+	Fill_vectors(&x, &y);
+
+	xs[0] = &x;
+	ys[0] = &y;
+	xs[1] = &x;
+	ys[1] = &x;
+
+	for( method = 0 ; method < 4 ; method++ )
+	{
+		MPI_Barrier(MPI_COMM_WORLD);
+		start = MPI_Wtime();
+		for( rep = 0 ; rep < REPS ; rep++ )
+		{
+			switch( method )
+			{
+			case 0:
+				local_scalar = serial_dot(x.data, y.data, x.local_n);
+				MPI_Allreduce(&local_scalar, &scalar_xy, 1, MPI_FLOAT, MPI_SUM, MPI_COMM_WORLD);
+				break;
+			case 1:
+				xy = Parallel_dot(&x, &y, MPI_COMM_WORLD);
+				break;
+			case 2:
+				xy = Parallel_dot(&x, &y, MPI_COMM_WORLD);
+				xx = Parallel_dot(&x, &x, MPI_COMM_WORLD);
+				break;
+			case 3:
+				Parallel_dots(2, xs, ys, dots, MPI_COMM_WORLD);
+				break;
+			}
+		}
+		elapsed = (MPI_Wtime() - start) / REPS;
+		MPI_Reduce(&elapsed, &seconds[method], 1, MPI_DOUBLE, MPI_MAX, 0, MPI_COMM_WORLD);
+	}
+
+	if( my_rank == 0 )
+	{
+		Exact_dots(n, &exact_xy, &exact_xx);
+		printf("With n = %lld and p = %d \n", (long long) n, no_of_process);
+		printf("x . y : scalar = %.1f , simd = %.1f , fused = %.1f , exact = %.1f \n", scalar_xy, xy, dots[0],
+				exact_xy);
+		printf("x . x : two dots = %.1f , fused = %.1f , exact = %.1f \n", xx, dots[1], exact_xx);
+		for( method = 0 ; method < 4 ; method++ )
+		{
+			printf("%-8s : %e s per call , %8.2f GB/s per process \n", names[method], seconds[method],
+					vectors_read[method] * (double) x.local_n * sizeof(float) / seconds[method] / 1.0e9);
+		}
+	}
+
+	Vector_free(&x);
+	Vector_free(&y);
+	MPI_Finalize();
+
+	return 0;
+}
+
+/*
+ * Process 0 reads the order of the vectors and broadcasts it
+ */
+void Get_data(int64_t *n_ptr,	/* out */
+			int my_rank			/* in */
+			)
+{
+	long long n = 0;
+
+	if( my_rank == 0 )
+	{
+		printf("Enter the order of the vectors\n");
+		scanf("%lld", &n);
+	}
+
+	MPI_Bcast(&n, 1, MPI_LONG_LONG, 0, MPI_COMM_WORLD);
+	*n_ptr = n;
+}
+
+/*
+ * x(i) = 1 + (i % 3) / 2 , y(i) = (i % 8) - 3.5 for my global indices i
+ */
+void Fill_vectors(DIST_VECTOR_T *x,	/* in/out */
+			DIST_VECTOR_T *y		/* in/out */
+			)
+{
+	int64_t i, global_i;
+
+	for( i = 0 ; i < x->local_n ; i++ )
+	{
+		global_i = x->first + i;
+		x->data[i] = 1.0f + (float) (global_i % 3) / 2.0f;
+		y->data[i] = (float) (global_i % 8) - 3.5f;
+	}
+}
+
+/*
+ * The vectors repeat every 24 elements : sum one period, then the rest
+ */
+void Exact_dots(int64_t n,	/* in */
+			double *xy_ptr,	/* out */
+			double *xx_ptr	/* out */
+			)
+{
+	double period_xy = 0.0, period_xx = 0.0;
+	double x_i, y_i;
+	int64_t i;
+
+	*xy_ptr = *xx_ptr = 0.0;
+	for( i = 0 ; i < 24 ; i++ )
+	{
+		x_i = 1.0 + (double) (i % 3) / 2.0;
+		y_i = (double) (i % 8) - 3.5;
+		period_xy += x_i * y_i;
+		period_xx += x_i * x_i;
+		if( i < n % 24 )
+		{
+			*xy_ptr += x_i * y_i;
+			*xx_ptr += x_i * x_i;
+		}
+	}
+	*xy_ptr += (double) (n / 24) * period_xy;
+	*xx_ptr += (double) (n / 24) * period_xx;
+}
+
+/*
+ * Dot product with one float accumulator, as in parellel_dot_mpi_all_reduce.c
+ */
+float serial_dot(const float x[],	/* in */
+			const float y[],		/* in */
+			int64_t n				/* in */
+			)
+{
+	int64_t i;
+	float sum = 0.0;
+
+	for( i = 0 ; i < n ; i++ )
+	{
+		sum += x[i]*y[i];
+	}
+
+	return sum;
+}
@@ -0,0 +1,246 @@
+/*
+ * mat_vec_multi.c
+ *
+ *  Created on: 16-Oct-2026
+ *      Author: prateek
+ *      Desc : Multiplies a row panel distributed matrix by k vectors at once,
+ *      	against k calls of the product of chap05/parallel_mat_vect.c.
+ *      Input :
+ *      	m, n : order of the matrix
+ *      	k : no of vectors
+ *      Output :
+ *      	The time per vector, and the messages, bytes of A read and bytes of x
+ *      	received per vector, for k single products and for one block product,
+ *      	and whether they agree.
+ *
+ *      Algorithm:
+ *      	single : for each vector, MPI_Allgatherv its blocks, then Dense_gemv.
+ *      	         k collectives, and A is read from memory k times.
+ *      	block  : the k vectors are the columns of an n x k panel X, distributed
+ *      	         by block rows like x. One MPI_Allgatherv of the panel, then
+ *      	         Dense_gemm, which reads A once for every 16 vectors.
+ *
+ *      NOTES:
+ *      	1. A(i,j) = (i + 2j) % 7 - 3 and vector v has x(j) = (j + v) % 5 - 2,
+ *      	   so every sum is an integer, exact in float in any order.
+ *      	2. Dense_gemm works on 16 vectors at a time, padding the last group with
+ *      	   zeros. For k of 1 or 2 most of that work is padding and the single
+ *      	   products are faster.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <mpi/mpi.h>
+#include "dense_matrix.h"
+
+#define REPS	5
+
+void Get_data(int *m_ptr, int *n_ptr, int *k_ptr, int my_rank);
+void Block_range(int n, int no_of_blocks, int block, int *first_ptr, int *count_ptr);
+void Parallel_mat_multi_vec(const DENSE_MATRIX_T *local_A, const DENSE_MATRIX_T *local_X,
+		const int row_counts[], const int row_displacements[], DENSE_MATRIX_T *global_X, DENSE_MATRIX_T *local_Y,
+		MPI_Comm comm);
+
+int main(int argc, char **argv)
+{
+	int my_rank;
+	int no_of_process;
+	int m, n, k;
+	int local_m, first_row, local_n, first_col;
+	int *counts, *displacements;		// Blocks of x, in floats
+	int *row_counts, *row_displacements;	// Blocks of X, in rows
+	DENSE_MATRIX_T *local_A, *local_X, *global_X, *local_Y;
+	float *local_x, *global_x, *single_y;
+	double start, elapsed, seconds[2];
+	int ok, all_ok;
+	int rank, rep, i, j, v;
+
+	MPI_Init(&argc, &argv);
+	MPI_Comm_rank(MPI_COMM_WORLD, &my_rank);
+	MPI_Comm_size(MPI_COMM_WORLD, &no_of_process);
+
+	Get_data(&m, &n, &k, my_rank);
+
+	Block_range(m, no_of_process, my_rank, &first_row, &local_m);
+	Block_range(n, no_of_process, my_rank, &first_col, &local_n);
+
+	local_A = Dense_matrix_allocate(local_m, n);
+	local_X = Dense_matrix_allocate(local_n, k);
+	global_X = Dense_matrix_allocate(n, k);
+	local_Y = Dense_matrix_allocate(local_m, k);
+	local_x = malloc((local_n + 1) * sizeof(float));
+	global_x = malloc((n + 1) * sizeof(float));
+	single_y = malloc(((size_t) local_m * k + 1) * sizeof(float));
+	ok = (local_A != NULL && local_X != NULL && global_X != NULL && local_Y != NULL && single_y != NULL);
+	MPI_Allreduce(&ok, &all_ok, 1, MPI_INT, MPI_MIN, MPI_COMM_WORLD);
+	if( !all_ok )
+	{
+		if( my_rank == 0 )
+		{
+			fprintf(stderr, "Cannot allocate the matrices \n");
+		}
+		MPI_Abort(MPI_COMM_WORLD, 1);
+	}
+
+	counts = malloc(no_of_process * sizeof(int));
+	displacements = malloc(no_of_process * sizeof(int));
+	row_counts = malloc(no_of_process * sizeof(int));
+	row_displacements = malloc(no_of_process * sizeof(int));
+	for( rank = 0 ; rank < no_of_process ; rank++ )
+	{
+		Block_range(n, no_of_process, rank, &displacements[rank], &counts[rank]);
+		row_counts[rank] = counts[rank];
+		row_displacements[rank] = displacements[rank];
+	}
+
+	for( i = 0 ; i < local_m ; i++ )
+	{
+		for( j = 0 ; j < n ; j++ )
+		{
+			Entry(local_A, i, j) = (float) ((first_row + i + 2 * j) % 7 - 3);
+		}
+	}
+	for( j = 0 ; j < local_n ; j++ )
+	{
+		for( v = 0 ; v < k ; v++ )
+		{
+			Entry(local_X, j, v) = (float) ((first_col + j + v) % 5 - 2);
+		}
+	}
+
+	/* k single products */
+	MPI_Barrier(MPI_COMM_WORLD);
+	start = MPI_Wtime();
+	for( rep = 0 ; rep < REPS ; rep++ )
+	{
+		for( v = 0 ; v < k ; v++ )
+		{
+			for( j = 0 ; j < local_n ; j++ )
+			{
+				local_x[j] = Entry(local_X, j, v);
+			}
+			MPI_Allgatherv(local_x, local_n, MPI_FLOAT, global_x, counts, displacements, MPI_FLOAT,
+					MPI_COMM_WORLD);
+			Dense_gemv(local_A, global_x, &single_y[(size_t) v * local_m]);
+		}
+	}
+	elapsed = (MPI_Wtime() - start) / REPS;
+	MPI_Reduce(&elapsed, &seconds[0], 1, MPI_DOUBLE, MPI_MAX, 0, MPI_COMM_WORLD);
+
+	/* One block product */
+	MPI_Barrier(MPI_COMM_WORLD);
+	start = MPI_Wtime();
+	for( rep = 0 ; rep < REPS ; rep++ )
+	{
+		Parallel_mat_multi_vec(local_A, local_X, row_counts, row_displacements, global_X, local_Y, MPI_COMM_WORLD);
+	}
+	elapsed = (MPI_Wtime() - start) / REPS;
+	MPI_Reduce(&elapsed, &seconds[1], 1, MPI_DOUBLE, MPI_MAX, 0, MPI_COMM_WORLD);
+
+	ok = 1;
+	for( v = 0 ; v < k ; v++ )
+	{
+		for( i = 0 ; i < local_m ; i++ )
+		{
+			ok &= (single_y[(size_t) v * local_m + i] == Entry(local_Y, i, v));
+		}
+	}
+	MPI_Reduce(&ok, &all_ok, 1, MPI_INT, MPI_MIN, 0, MPI_COMM_WORLD);
+
+	if( my_rank == 0 )
+	{
+		printf("m = %d , n = %d , k = %d , p = %d \n", m, n, k, no_of_process);
+		printf("Bytes of A read and of x received per vector on each process : \n");
+		printf("single : %e s per vector , 1 allgather per vector , %.0f bytes , %.0f bytes \n",
+				seconds[0] / k, (double) local_m * n * sizeof(float), (double) n * sizeof(float));
+		printf("block  : %e s per vector , 1 allgather per %d vectors , %.0f bytes , %.0f bytes \n",
+				seconds[1] / k, k, (double) local_m * n * sizeof(float) * ((k + 15) / 16) / k,
+				(double) n * sizeof(float));
+		printf("Both give the same Y : %s \n", all_ok ? "yes" : "no");
+	}
+
+	Dense_matrix_free(&local_A);
+	Dense_matrix_free(&local_X);
+	Dense_matrix_free(&global_X);
+	Dense_matrix_free(&local_Y);
+	free(local_x);
+	free(global_x);
+	free(single_y);
+	free(counts);
+	free(displacements);
+	free(row_counts);
+	free(row_displacements);
+	MPI_Finalize();
+
+	return 0;
+}
+
+/*
+ * Process 0 reads the order of the matrix and the no of vectors
+ */
+void Get_data(int *m_ptr,	/* out */
+			int *n_ptr,		/* out */
+			int *k_ptr,		/* out */
+			int my_rank		/* in */
+			)
+{
+	if( my_rank == 0 )
+	{
+		printf("Enter the order of the matrix (m x n) and the no of vectors\n");
+		scanf("%d %d %d", m_ptr, n_ptr, k_ptr);
+	}
+
+	MPI_Bcast(m_ptr, 1, MPI_INT, 0, MPI_COMM_WORLD);
+	MPI_Bcast(n_ptr, 1, MPI_INT, 0, MPI_COMM_WORLD);
+	MPI_Bcast(k_ptr, 1, MPI_INT, 0, MPI_COMM_WORLD);
+}
+
+/*
+ * First index and length of block number block of n split into no_of_blocks.
+ * The first n % no_of_blocks blocks get one more.
+ */
+void Block_range(int n,			/* in */
+			int no_of_blocks,	/* in */
+			int block,			/* in */
+			int *first_ptr,		/* out */
+			int *count_ptr		/* out */
+			)
+{
+	int quotient = n / no_of_blocks;
+	int remainder = n % no_of_blocks;
+
+	*count_ptr = quotient + (block < remainder ? 1 : 0);
+	*first_ptr = block * quotient + (block < remainder ? block : remainder);
+}
+
+/********************************************************************/
+/* Function Parallel_mat_multi_vec
+ * local_Y = local_A X for the n x k panel X, whose block rows are
+ * local_X on each process. local_X and global_X have the same stride.
+ * A row of X goes as its k floats, resized to the stride, so one
+ * MPI_Allgatherv moves the panel without the padding of the rows;
+ * row_counts and row_displacements are in rows. The padding of
+ * global_X keeps the zeros it was allocated with.
+ ********************************************************************/
+void Parallel_mat_multi_vec(const DENSE_MATRIX_T *local_A,	/* in */
+			const DENSE_MATRIX_T *local_X,			/* in */
+			const int row_counts[],					/* in */
+			const int row_displacements[],			/* in */
+			DENSE_MATRIX_T *global_X,				/* scratch */
+			DENSE_MATRIX_T *local_Y,				/* out */
+			MPI_Comm comm							/* in */
+			)
+{
+	MPI_Datatype k_floats_mpi_t;
+	MPI_Datatype row_mpi_t;
+
+	MPI_Type_contiguous(local_X->cols, MPI_FLOAT, &k_floats_mpi_t);
+	MPI_Type_create_resized(k_floats_mpi_t, 0, (MPI_Aint) local_X->stride * sizeof(float), &row_mpi_t);
+	MPI_Type_commit(&row_mpi_t);
+
+	MPI_Allgatherv(local_X->entries, local_X->rows, row_mpi_t, global_X->entries, row_counts, row_displacements,
+			row_mpi_t, comm);
+	Dense_gemm(local_A, global_X, local_Y);
+
+	MPI_Type_free(&row_mpi_t);
+	MPI_Type_free(&k_floats_mpi_t);
+}
@@ -0,0 +1,215 @@
+/*
+ * tree_bcast.c
+ *
+ *  Created on: 16-Oct-2026
+ *      Author: prateek
+ *      Desc : Tree structured broadcast with a choice of schedule.
+ *      	integral_tree_send.c sends a, b and n with three messages per edge of a
+ *      	binomial tree. Here the tree is worked out from the schedule, the payload is
+ *      	any MPI datatype sent as one message per edge, and large payloads are cut
+ *      	into segments so that a process forwards segment s while it is still
+ *      	receiving segment s+1.
+ *
+ *      	All ranks are relative to root : rel_rank = (my_rank - root + p) % p,
+ *      	so every schedule is laid out as if root were process 0.
+ *
+ *      	Binomial tree ( as in integral_tree_send.c ) :
+ *      									Rank 0							STAGE 0
+ *      									/      \
+ *									  Rank 0	    Rank 1					STAGE 1
+ *									/     \        /       \
+ *							  Rank 0    Rank 2    Rank 1    Rank 3			STAGE 2
+ */
+#include <stdlib.h>
+#include "tree_bcast.h"
+
+#define PIPELINE_DEPTH		4		/* Segments in flight on each edge */
+#define MAX_CHILDREN		64
+
+/********************************************************************/
+/* Function Tree_neighbours
+ * Works out the parent (-1 for the root) and the children of rel_rank
+ * in the tree given by schedule. Children are listed in the order they
+ * should be served : the one with the biggest subtree first.
+ * Returns the no of children.
+ ********************************************************************/
+static int Tree_neighbours(int rel_rank,	/* in */
+			int p,							/* in */
+			TREE_SCHEDULE_T schedule,		/* in */
+			int arity,						/* in */
+			int *parent_ptr,				/* out */
+			int children[]					/* out */
+			)
+{
+	int no_of_children = 0;
+	int power_2_stage;
+	int child;
+	int k;
+
+	if( schedule == TREE_CHAIN )
+	{
+		schedule = TREE_KARY;
+		arity = 1;
+	}
+
+	if( schedule == TREE_BINOMIAL )
+	{
+		/* Parent : clear the highest set bit. Children : set each higher bit in turn */
+		*parent_ptr = -1;
+		power_2_stage = 1;
+		while( power_2_stage <= rel_rank )
+		{
+			power_2_stage <<= 1;
+		}
+		if( rel_rank > 0 )
+		{
+			*parent_ptr = rel_rank - (power_2_stage >> 1);
+		}
+
+		/* Later stages have smaller subtrees, so serve the earliest stage first */
+		for( ; rel_rank + power_2_stage < p ; power_2_stage <<= 1 )
+		{
+			children[no_of_children++] = rel_rank + power_2_stage;
+		}
+		return no_of_children;
+	}
+
+	/* k-ary tree */
+	if( arity < 1 )
+	{
+		arity = 1;
+	}
+	if( arity > MAX_CHILDREN )
+	{
+		arity = MAX_CHILDREN;
+	}
+	*parent_ptr = (rel_rank == 0) ? -1 : (rel_rank - 1) / arity;
+	for( k = 1 ; k <= arity ; k++ )
+	{
+		child = arity * rel_rank + k;
+		if( child < p )
+		{
+			children[no_of_children++] = child;
+		}
+	}
+	return no_of_children;
+}
+
+/********************************************************************/
+/* Function Tree_bcast
+ * Broadcast buffer from root along the tree given by schedule.
+ * Algorithm:
+ *     1.  Cut the payload into segments of whole elements.
+ *     2.  Non root processes keep up to PIPELINE_DEPTH receives posted.
+ *     3.  As soon as segment s has arrived it is forwarded to every child
+ *         with MPI_Isend; sends older than PIPELINE_DEPTH segments are
+ *         completed before their request slot is used again.
+ ********************************************************************/
+int Tree_bcast(void *buffer,		/* in/out */
+			int count,				/* in */
+			MPI_Datatype datatype,	/* in */
+			int root,				/* in */
+			MPI_Comm comm,			/* in */
+			TREE_SCHEDULE_T schedule,	/* in */
+			int arity,				/* in */
+			int segment_bytes		/* in */
+			)
+{
+	int my_rank, p, rel_rank;
+	int parent;
+	int children[MAX_CHILDREN];
+	int no_of_children;
+	int type_size;
+	MPI_Aint lower_bound, extent;
+	int segment_count;		// Elements per segment
+	int no_of_segments;
+	int segment, next, c, slot;
+	MPI_Request recv_requests[PIPELINE_DEPTH];
+	MPI_Request *send_requests;
+
+	MPI_Comm_rank(comm, &my_rank);
+	MPI_Comm_size(comm, &p);
+	if( p == 1 || count == 0 )
+	{
+		return MPI_SUCCESS;
+	}
+
+	rel_rank = (my_rank - root + p) % p;
+	no_of_children = Tree_neighbours(rel_rank, p, schedule, arity, &parent, children);
+	if( parent >= 0 )
+	{
+		parent = (parent + root) % p;
+	}
+	for( c = 0 ; c < no_of_children ; c++ )
+	{
+		children[c] = (children[c] + root) % p;
+	}
+
+	MPI_Type_size(datatype, &type_size);
+	MPI_Type_get_extent(datatype, &lower_bound, &extent);
+
+	segment_count = count;
+	if( segment_bytes > 0 && type_size > 0 && (long) count * type_size > segment_bytes )
+	{
+		segment_count = segment_bytes / type_size;
+		if( segment_count < 1 )
+		{
+			segment_count = 1;
+		}
+	}
+	no_of_segments = (count + segment_count - 1) / segment_count;
+
+#define SEGMENT_START(s)	((char *) buffer + (MPI_Aint) (s) * segment_count * extent)
+#define SEGMENT_COUNT(s)	(((s) == no_of_segments - 1) ? count - (s) * segment_count : segment_count)
+
+	send_requests = malloc(PIPELINE_DEPTH * (no_of_children > 0 ? no_of_children : 1) * sizeof(MPI_Request));
+	for( slot = 0 ; slot < PIPELINE_DEPTH * no_of_children ; slot++ )
+	{
+		send_requests[slot] = MPI_REQUEST_NULL;
+	}
+
+	/* Messages from one source with one tag arrive in order, so the receives match in order */
+	if( parent >= 0 )
+	{
+		for( next = 0 ; next < PIPELINE_DEPTH && next < no_of_segments ; next++ )
+		{
+			MPI_Irecv(SEGMENT_START(next), SEGMENT_COUNT(next), datatype, parent, TREE_BCAST_TAG,
+					comm, &recv_requests[next]);
+		}
+	}
+
+	for( segment = 0 ; segment < no_of_segments ; segment++ )
+	{
+		slot = segment % PIPELINE_DEPTH;
+
+		if( parent >= 0 )
+		{
+			MPI_Wait(&recv_requests[slot], MPI_STATUS_IGNORE);
+			next = segment + PIPELINE_DEPTH;
+			if( next < no_of_segments )
+			{
+				MPI_Irecv(SEGMENT_START(next), SEGMENT_COUNT(next), datatype, parent, TREE_BCAST_TAG,
+						comm, &recv_requests[slot]);
+			}
+		}
+
+		if( no_of_children > 0 )
+		{
+			/* Free the slot used PIPELINE_DEPTH segments ago */
+			MPI_Waitall(no_of_children, &send_requests[slot * no_of_children], MPI_STATUSES_IGNORE);
+			for( c = 0 ; c < no_of_children ; c++ )
+			{
+				MPI_Isend(SEGMENT_START(segment), SEGMENT_COUNT(segment), datatype, children[c],
+						TREE_BCAST_TAG, comm, &send_requests[slot * no_of_children + c]);
+			}
+		}
+	}
+
+	MPI_Waitall(PIPELINE_DEPTH * no_of_children, send_requests, MPI_STATUSES_IGNORE);
+	free(send_requests);
+
+#undef SEGMENT_START
+#undef SEGMENT_COUNT
+
+	return MPI_SUCCESS;
+}
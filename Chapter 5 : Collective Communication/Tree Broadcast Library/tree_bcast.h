@@ -0,0 +1,41 @@
+/*
+ * tree_bcast.h
+ *
+ *  Created on: 16-Oct-2026
+ *      Author: prateek
+ *      Desc : Header for tree_bcast.c -- broadcast along a binomial tree, a k-ary
+ *      	tree or a pipelined chain, generalizing the hand coded tree of
+ *      	integral_tree_send.c / chap05/get_data1.c.
+ */
+#ifndef TREE_BCAST_H
+#define TREE_BCAST_H
+
+#include <mpi/mpi.h>
+
+/* Tag used for the messages of Tree_bcast */
+#define TREE_BCAST_TAG		7001
+
+/* Shape of the tree the data travels along */
+typedef enum {
+	TREE_BINOMIAL,		/* Stage s : ranks < 2^s send to rank + 2^s */
+	TREE_KARY,			/* Rank r sends to k*r+1 .. k*r+k */
+	TREE_CHAIN			/* Rank r sends to r+1 */
+} TREE_SCHEDULE_T;
+
+/* Broadcast count elements of datatype from root to every process of comm.
+ * arity is used by TREE_KARY only. Payloads larger than segment_bytes are
+ * sent in segments of whole elements so the levels of the tree overlap;
+ * segment_bytes = 0 sends the payload as one message per edge.
+ * Collective, returns MPI_SUCCESS */
+int Tree_bcast(
+		void *buffer,				/* in/out */
+		int count,					/* in */
+		MPI_Datatype datatype,		/* in */
+		int root,					/* in */
+		MPI_Comm comm,				/* in */
+		TREE_SCHEDULE_T schedule,	/* in */
+		int arity,					/* in */
+		int segment_bytes			/* in */
+		);
+
+#endif /* TREE_BCAST_H */
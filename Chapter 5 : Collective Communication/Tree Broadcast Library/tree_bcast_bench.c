@@ -0,0 +1,200 @@
+/*
+ * tree_bcast_bench.c
+ *
+ *  Created on: 16-Oct-2026
+ *      Author: prateek
+ *      Desc : Times the schedules of Tree_bcast against MPI_Bcast.
+ *      Input : None
+ *      Output :
+ *      	For payloads from MIN_BYTES to MAX_BYTES : the time of one broadcast with
+ *      	each schedule (slowest process, best of NO_OF_TRIALS) and the fastest one.
+ *
+ *      Algorithm:
+ *      1) For every payload size and every schedule, first check that the data
+ *         arrives intact on every process.
+ *      2) Then run REPS broadcasts between two barriers, NO_OF_TRIALS times, and
+ *         keep the best time. The time of a trial is the max over processes.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <mpi/mpi.h>
+#include "tree_bcast.h"
+
+#define MIN_BYTES		8
+#define MAX_BYTES		(4 << 20)
+#define SEGMENT_BYTES	(16 << 10)
+#define REPS			20
+#define NO_OF_TRIALS	3
+
+/* One way to broadcast */
+typedef struct {
+	char name[24];
+	int use_mpi_bcast;
+	TREE_SCHEDULE_T schedule;
+	int arity;
+	int segment_bytes;
+} METHOD_T;
+
+static const METHOD_T methods[] = {
+	{ "MPI_Bcast",			1, TREE_BINOMIAL,	0, 0 },
+	{ "binomial",			0, TREE_BINOMIAL,	0, 0 },
+	{ "binomial/seg",		0, TREE_BINOMIAL,	0, SEGMENT_BYTES },
+	{ "4-ary",				0, TREE_KARY,		4, 0 },
+	{ "4-ary/seg",			0, TREE_KARY,		4, SEGMENT_BYTES },
+	{ "chain/seg",			0, TREE_CHAIN,		1, SEGMENT_BYTES },
+};
+#define NO_OF_METHODS	((int) (sizeof(methods) / sizeof(methods[0])))
+
+void Broadcast(const METHOD_T *method, char *buffer, int bytes, MPI_Comm comm);
+int Check(const METHOD_T *method, char *buffer, int bytes, int my_rank, MPI_Comm comm);
+double Time_method(const METHOD_T *method, char *buffer, int bytes, MPI_Comm comm);
+
+int main(int argc, char **argv)
+{
+	int my_rank;
+	int no_of_process;
+	char *buffer;
+	double seconds[NO_OF_METHODS];
+	int bytes;
+	int m, best;
+
+	MPI_Init(&argc, &argv);
+	MPI_Comm_rank(MPI_COMM_WORLD, &my_rank);
+	MPI_Comm_size(MPI_COMM_WORLD, &no_of_process);
+
+	buffer = malloc(MAX_BYTES);
+
+	if( my_rank == 0 )
+	{
+		printf("Broadcast time in microseconds , p = %d \n", no_of_process);
+		printf("%10s", "bytes");
+		for( m = 0 ; m < NO_OF_METHODS ; m++ )
+		{
+			printf(" %13s", methods[m].name);
+		}
+		printf("   fastest \n");
+	}
+
+	for( bytes = MIN_BYTES ; bytes <= MAX_BYTES ; bytes *= 4 )
+	{
+		for( m = 0 ; m < NO_OF_METHODS ; m++ )
+		{
+			if( !Check(&methods[m], buffer, bytes, my_rank, MPI_COMM_WORLD) )
+			{
+				if( my_rank == 0 )
+				{
+					fprintf(stderr, "%s delivered wrong data for %d bytes \n", methods[m].name, bytes);
+				}
+				MPI_Abort(MPI_COMM_WORLD, 1);
+			}
+			seconds[m] = Time_method(&methods[m], buffer, bytes, MPI_COMM_WORLD);
+		}
+
+		if( my_rank == 0 )
+		{
+			best = 0;
+			printf("%10d", bytes);
+			for( m = 0 ; m < NO_OF_METHODS ; m++ )
+			{
+				printf(" %13.2f", seconds[m] * 1.0e6);
+				if( seconds[m] < seconds[best] )
+				{
+					best = m;
+				}
+			}
+			printf("   %s \n", methods[best].name);
+		}
+	}
+
+	free(buffer);
+	MPI_Finalize();
+
+	return 0;
+}
+
+/*
+ * One broadcast of bytes bytes from process 0
+ */
+void Broadcast(const METHOD_T *method,	/* in */
+			char *buffer,				/* in/out */
+			int bytes,					/* in */
+			MPI_Comm comm				/* in */
+			)
+{
+	if( method->use_mpi_bcast )
+	{
+		MPI_Bcast(buffer, bytes, MPI_BYTE, 0, comm);
+	}
+	else
+	{
+		Tree_bcast(buffer, bytes, MPI_BYTE, 0, comm, method->schedule, method->arity, method->segment_bytes);
+	}
+}
+
+/*
+ * Returns 1 on every process if every process got the right bytes
+ */
+int Check(const METHOD_T *method,	/* in */
+			char *buffer,			/* scratch */
+			int bytes,				/* in */
+			int my_rank,			/* in */
+			MPI_Comm comm			/* in */
+			)
+{
+	int i;
+	int ok = 1;
+	int all_ok;
+
+	for( i = 0 ; i < bytes ; i++ )
+	{
+		buffer[i] = (my_rank == 0) ? (char) (i * 7 + bytes) : 0;
+	}
+
+	Broadcast(method, buffer, bytes, comm);
+
+	for( i = 0 ; i < bytes ; i++ )
+	{
+		if( buffer[i] != (char) (i * 7 + bytes) )
+		{
+			ok = 0;
+			break;
+		}
+	}
+
+	MPI_Allreduce(&ok, &all_ok, 1, MPI_INT, MPI_MIN, comm);
+	return all_ok;
+}
+
+/*
+ * Best over NO_OF_TRIALS of the slowest process's time for one broadcast
+ */
+double Time_method(const METHOD_T *method,	/* in */
+			char *buffer,					/* in/out */
+			int bytes,						/* in */
+			MPI_Comm comm					/* in */
+			)
+{
+	double start, elapsed, max_elapsed;
+	double best = 0.0;
+	int trial, rep;
+
+	for( trial = 0 ; trial < NO_OF_TRIALS ; trial++ )
+	{
+		MPI_Barrier(comm);
+		start = MPI_Wtime();
+		for( rep = 0 ; rep < REPS ; rep++ )
+		{
+			Broadcast(method, buffer, bytes, comm);
+		}
+		elapsed = (MPI_Wtime() - start) / REPS;
+
+		MPI_Allreduce(&elapsed, &max_elapsed, 1, MPI_DOUBLE, MPI_MAX, comm);
+		if( trial == 0 || max_elapsed < best )
+		{
+			best = max_elapsed;
+		}
+	}
+
+	return best;
+}
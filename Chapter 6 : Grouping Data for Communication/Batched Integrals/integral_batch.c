@@ -0,0 +1,201 @@
+/*
+ * integral_batch.c
+ *
+ *  Created on: 16-Oct-2026
+ *      Author: prateek
+ *      Desc : Parallel Trapezoidal Rule for a whole table of integrals in one run.
+ *      Input :
+ *      	no_of_jobs : no of integrals
+ *      	no_of_jobs lines of a, b, n : limits and no of trapezoids of each integral
+ *      Output :
+ *      	Estimate of every integral and the elapsed time per integral.
+ *
+ *      Algorithm:
+ *      1) Process 0 reads the job table into an array of JOB_T.
+ *      2) The table is broadcast once, as no_of_jobs elements of a committed
+ *         datatype matching JOB_T.
+ *      3) Every process computes its share of the trapezoids of every job. The
+ *         first n % p processes get one trapezoid more, so nothing is dropped.
+ *      4) All the partial results are added with a single vector MPI_Reduce.
+ *
+ *      NOTE : f(x) is hardwired.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stddef.h>
+#include <mpi/mpi.h>
+
+/* One integral of the batch */
+typedef struct {
+	float a;
+	float b;
+	int n;
+} JOB_T;
+
+void Build_job_type(MPI_Datatype *job_mpi_t_ptr);
+JOB_T *Get_jobs(int *no_of_jobs_ptr, int my_rank);
+float Job_share(JOB_T *job, int my_rank, int no_of_process);
+float calculate_integral( float local_a, float local_b , int local_n , float h );
+float f(float x);
+
+int main(int argc, char **argv)
+{
+	int my_rank;			// My process rank
+	int no_of_process;		// No of processes
+	int no_of_jobs;			// No of integrals in the batch
+	JOB_T *jobs;			// The job table
+	float *integral;		// My part of every integral
+	float *total = NULL;	// Every integral
+	double start, finish;
+	int i;
+
+	MPI_Init(&argc, &argv);
+	MPI_Comm_rank(MPI_COMM_WORLD, &my_rank);
+	MPI_Comm_size(MPI_COMM_WORLD, &no_of_process);
+
+	MPI_Barrier(MPI_COMM_WORLD);
+	start = MPI_Wtime();
+
+	jobs = Get_jobs(&no_of_jobs, my_rank);
+
+	integral = malloc(no_of_jobs * sizeof(float));
+	for( i = 0 ; i < no_of_jobs ; i++ )
+	{
+		integral[i] = Job_share(&jobs[i], my_rank, no_of_process);
+	}
+
+	/* One reduction for the whole batch */
+	if( my_rank == 0 )
+	{
+		total = malloc(no_of_jobs * sizeof(float));
+	}
+	MPI_Reduce(integral, total, no_of_jobs, MPI_FLOAT, MPI_SUM, 0, MPI_COMM_WORLD);
+
+	MPI_Barrier(MPI_COMM_WORLD);
+	finish = MPI_Wtime();
+
+	if( my_rank == 0 )
+	{
+		for( i = 0 ; i < no_of_jobs ; i++ )
+		{
+			printf("Job %d : integral from %f to %f with n = %d = %f \n", i,
+					jobs[i].a, jobs[i].b, jobs[i].n, total[i]);
+		}
+		printf("Elapsed time in seconds = %e (%e per integral) \n", finish - start,
+				(no_of_jobs > 0) ? (finish - start) / no_of_jobs : 0.0);
+		free(total);
+	}
+
+	free(integral);
+	free(jobs);
+	MPI_Finalize();
+
+	return 0;
+}
+
+/********************************************************************/
+/* Function Build_job_type
+ * Builds a derived datatype matching JOB_T, resized to sizeof(JOB_T)
+ * so that an array of jobs can be sent with one call.
+ ********************************************************************/
+void Build_job_type(MPI_Datatype *job_mpi_t_ptr	/* out */)
+{
+	int block_lengths[3] = { 1, 1, 1 };
+	MPI_Datatype typelist[3] = { MPI_FLOAT, MPI_FLOAT, MPI_INT };
+	MPI_Aint displacements[3] = { offsetof(JOB_T, a), offsetof(JOB_T, b), offsetof(JOB_T, n) };
+	MPI_Datatype struct_mpi_t;
+
+	MPI_Type_create_struct(3, block_lengths, displacements, typelist, &struct_mpi_t);
+	MPI_Type_create_resized(struct_mpi_t, 0, sizeof(JOB_T), job_mpi_t_ptr);
+	MPI_Type_commit(job_mpi_t_ptr);
+	MPI_Type_free(&struct_mpi_t);
+}
+
+/********************************************************************/
+/* Function Get_jobs
+ * Process 0 reads the job table, then it is broadcast to everyone :
+ * one MPI_Bcast for the size and one for the whole table.
+ * Returns the table, allocated with malloc, on every process.
+ ********************************************************************/
+JOB_T *Get_jobs(int *no_of_jobs_ptr,	/* out */
+			int my_rank					/* in */
+			)
+{
+	JOB_T *jobs;
+	MPI_Datatype job_mpi_t;
+	int i;
+
+	if( my_rank == 0 )
+	{
+		printf("Enter the no of integrals , then a , b and n of each \n");
+		if( scanf("%d", no_of_jobs_ptr) != 1 || *no_of_jobs_ptr < 0 )
+		{
+			*no_of_jobs_ptr = 0;
+		}
+	}
+	MPI_Bcast(no_of_jobs_ptr, 1, MPI_INT, 0, MPI_COMM_WORLD);
+
+	jobs = malloc(*no_of_jobs_ptr * sizeof(JOB_T));
+	if( my_rank == 0 )
+	{
+		for( i = 0 ; i < *no_of_jobs_ptr ; i++ )
+		{
+			scanf("%f %f %d", &jobs[i].a, &jobs[i].b, &jobs[i].n);
+		}
+	}
+
+	Build_job_type(&job_mpi_t);
+	MPI_Bcast(jobs, *no_of_jobs_ptr, job_mpi_t, 0, MPI_COMM_WORLD);
+	MPI_Type_free(&job_mpi_t);
+
+	return jobs;
+}
+
+/*
+ * Integral over my share of the trapezoids of one job. The first
+ * n % no_of_process processes do one trapezoid more.
+ */
+float Job_share(JOB_T *job,		/* in */
+			int my_rank,		/* in */
+			int no_of_process	/* in */
+			)
+{
+	float h = (job->b - job->a) / job->n;
+	int quotient = job->n / no_of_process;
+	int remainder = job->n % no_of_process;
+	int local_n = quotient + (my_rank < remainder ? 1 : 0);
+	int first = my_rank * quotient + (my_rank < remainder ? my_rank : remainder);
+	float local_a = job->a + first * h;
+
+	if( local_n == 0 )
+	{
+		return 0.0;
+	}
+	return calculate_integral(local_a, local_a + local_n * h, local_n, h);
+}
+
+/* Function to calculate integral */
+float calculate_integral( float local_a, float local_b , int local_n , float h )
+{
+	float integral;		// Store result of integral
+	float x ;
+	int i;
+
+	integral = ( f(local_a) + f(local_b)) / 2.0;
+	x = local_a;
+
+	for( i = 1 ; i <= local_n-1 ; i++ )
+	{
+		x = x+h;
+		integral = integral + f(x);
+	}
+
+	integral = integral * h;
+	return integral;
+}
+
+// f(x) = x^2
+float f(float x)
+{
+	return (x*x);
+}
@@ -0,0 +1,548 @@
+/*
+ * type_cache.c
+ *
+ *  Created on: 16-Oct-2026
+ *      Author: prateek
+ *      Desc : A cache of committed derived datatypes. Split in
+ *      	chap14b/service_requests.c builds and commits an MPI_Type_indexed for
+ *      	every transfer of work and Send_work frees it right after, and
+ *      	Build_derived_type, Build_matrix_type, ... do the same for every object,
+ *      	although the same few shapes come back over and over.
+ *
+ *      	A layout is described the way MPI_Type_get_contents describes a type :
+ *      	the constructor, its integer arguments, its address arguments and its
+ *      	datatype arguments. That key is hashed into a table of buckets. If it is
+ *      	there the committed datatype is handed out again; if not it is built,
+ *      	committed and stored.
+ *
+ *      	Every entry counts the references handed out. An entry nobody holds
+ *      	stays committed, so the next message of that shape finds it, until the
+ *      	cache is full : then the least recently used entry without references
+ *      	is freed to make room. If every entry is held the new type is handed
+ *      	out without being stored, and freed when it is released.
+ *
+ *      NOTES:
+ *      	1. Datatype arguments are keyed by their handle. They should be
+ *      	   predefined types or types that stay alive while the cache is used,
+ *      	   since MPI may give the handle of a freed type to a new one.
+ *      	   Type_cache_resized keeps a reference to the type it resizes for that
+ *      	   reason.
+ *      	2. A lookup scans only its bucket; eviction and release scan the entries,
+ *      	   which is no more than the cost of the MPI_Type_free that goes with them.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include "type_cache.h"
+
+#define FNV_OFFSET		14695981039346656037ULL
+#define FNV_PRIME		1099511628211ULL
+
+/* One committed layout */
+typedef struct {
+	int in_use;
+	TYPE_KIND_T kind;
+	uint64_t hash;
+	int no_of_ints;
+	int *ints;
+	int no_of_aints;
+	MPI_Aint *aints;
+	int no_of_types;
+	MPI_Datatype *types;
+	MPI_Datatype type;		/* Committed                                  */
+	int references;			/* Handed out and not released                */
+	long last_used;			/* Value of the clock at the last lookup      */
+	int next;				/* Next entry in the same bucket, -1 at the end */
+	int source;				/* Entry a TYPE_RESIZED was made from, or -1  */
+} TYPE_ENTRY_T;
+
+struct TYPE_CACHE {
+	int capacity;
+	int no_of_buckets;
+	int *buckets;			/* First entry of each bucket, -1 if empty     */
+	TYPE_ENTRY_T *entries;
+	long clock;
+	long hits;
+	long misses;
+	long evictions;
+};
+
+/* The arguments of one lookup */
+typedef struct {
+	TYPE_KIND_T kind;
+	int no_of_ints;
+	const int *ints;
+	int no_of_aints;
+	const MPI_Aint *aints;
+	int no_of_types;
+	const MPI_Datatype *types;
+} TYPE_KEY_T;
+
+/*
+ * FNV-1a over bytes bytes, carrying on from hash, a 64 bit word at a time
+ */
+static uint64_t Hash_bytes(uint64_t hash,	/* in */
+			const void *data,			/* in */
+			size_t bytes				/* in */
+			)
+{
+	const unsigned char *byte = data;
+	uint64_t word;
+	size_t i;
+
+	for( i = 0 ; i + sizeof(uint64_t) <= bytes ; i += sizeof(uint64_t) )
+	{
+		memcpy(&word, &byte[i], sizeof(uint64_t));
+		hash = (hash ^ word) * FNV_PRIME;
+	}
+	for( ; i < bytes ; i++ )
+	{
+		hash = (hash ^ byte[i]) * FNV_PRIME;
+	}
+	return hash;
+}
+
+static uint64_t Hash_key(const TYPE_KEY_T *key	/* in */)
+{
+	uint64_t hash = FNV_OFFSET;
+
+	hash = Hash_bytes(hash, &key->kind, sizeof(key->kind));
+	hash = Hash_bytes(hash, key->ints, key->no_of_ints * sizeof(int));
+	hash = Hash_bytes(hash, key->aints, key->no_of_aints * sizeof(MPI_Aint));
+	hash = Hash_bytes(hash, key->types, key->no_of_types * sizeof(MPI_Datatype));
+	return hash;
+}
+
+static int Same_key(const TYPE_ENTRY_T *entry,	/* in */
+			const TYPE_KEY_T *key,				/* in */
+			uint64_t hash						/* in */
+			)
+{
+	return entry->hash == hash && entry->kind == key->kind
+			&& entry->no_of_ints == key->no_of_ints && entry->no_of_aints == key->no_of_aints
+			&& entry->no_of_types == key->no_of_types
+			&& memcmp(entry->ints, key->ints, key->no_of_ints * sizeof(int)) == 0
+			&& memcmp(entry->aints, key->aints, key->no_of_aints * sizeof(MPI_Aint)) == 0
+			&& memcmp(entry->types, key->types, key->no_of_types * sizeof(MPI_Datatype)) == 0;
+}
+
+/*
+ * Build and commit the datatype the key describes
+ */
+static MPI_Datatype Build_type(const TYPE_KEY_T *key	/* in */)
+{
+	MPI_Datatype type = MPI_DATATYPE_NULL;
+	int count;
+
+	switch( key->kind )
+	{
+	case TYPE_VECTOR:
+		MPI_Type_vector(key->ints[0], key->ints[1], key->ints[2], key->types[0], &type);
+		break;
+	case TYPE_INDEXED:
+		count = key->ints[0];
+		MPI_Type_indexed(count, &key->ints[1], &key->ints[1 + count], key->types[0], &type);
+		break;
+	case TYPE_STRUCT:
+		MPI_Type_create_struct(key->ints[0], &key->ints[1], key->aints, key->types, &type);
+		break;
+	case TYPE_RESIZED:
+		MPI_Type_create_resized(key->types[0], key->aints[0], key->aints[1], &type);
+		break;
+	}
+	MPI_Type_commit(&type);
+	return type;
+}
+
+/*
+ * Index of the entry holding type, -1 if it is not in the cache
+ */
+static int Find_type(const TYPE_CACHE_T *cache,	/* in */
+			MPI_Datatype type				/* in */
+			)
+{
+	int e;
+
+	for( e = 0 ; e < cache->capacity ; e++ )
+	{
+		if( cache->entries[e].in_use && cache->entries[e].type == type )
+		{
+			return e;
+		}
+	}
+	return -1;
+}
+
+static void Release_entry(TYPE_CACHE_T *cache, int e);
+
+/*
+ * Free entry e and take it out of its bucket
+ */
+static void Evict_entry(TYPE_CACHE_T *cache,	/* in/out */
+			int e							/* in */
+			)
+{
+	TYPE_ENTRY_T *entry = &cache->entries[e];
+	int *link = &cache->buckets[entry->hash % cache->no_of_buckets];
+	int source = entry->source;
+
+	while( *link != e )
+	{
+		link = &cache->entries[*link].next;
+	}
+	*link = entry->next;
+
+	MPI_Type_free(&entry->type);
+	free(entry->ints);
+	free(entry->aints);
+	free(entry->types);
+	memset(entry, 0, sizeof(TYPE_ENTRY_T));
+
+	if( source >= 0 )
+	{
+		Release_entry(cache, source);
+	}
+}
+
+static void Release_entry(TYPE_CACHE_T *cache,	/* in/out */
+			int e								/* in */
+			)
+{
+	if( cache->entries[e].references > 0 )
+	{
+		cache->entries[e].references--;
+	}
+}
+
+/********************************************************************/
+/* Function Free_slot
+ * An entry that is not in use, or else the least recently used one
+ * without references, which is evicted. -1 if every entry is held.
+ ********************************************************************/
+static int Free_slot(TYPE_CACHE_T *cache	/* in/out */)
+{
+	int oldest = -1;
+	int e;
+
+	for( e = 0 ; e < cache->capacity ; e++ )
+	{
+		if( !cache->entries[e].in_use )
+		{
+			return e;
+		}
+		if( cache->entries[e].references == 0
+				&& (oldest < 0 || cache->entries[e].last_used < cache->entries[oldest].last_used) )
+		{
+			oldest = e;
+		}
+	}
+
+	if( oldest >= 0 )
+	{
+		Evict_entry(cache, oldest);
+		cache->evictions++;
+	}
+	return oldest;
+}
+
+/********************************************************************/
+/* Function Lookup
+ * The committed datatype for key, with one more reference.
+ * Algorithm:
+ *     1.  Hash the key and walk its bucket. If the key is there, it is
+ *         a hit : take a reference and return its type.
+ *     2.  Otherwise build and commit the type. Store it in a free slot,
+ *         evicting the least recently used unreferenced entry if need
+ *         be; if there is none, return it uncached.
+ * source is the entry a TYPE_RESIZED key resizes, or -1.
+ ********************************************************************/
+static MPI_Datatype Lookup(TYPE_CACHE_T *cache,	/* in/out */
+			const TYPE_KEY_T *key,			/* in */
+			int source						/* in */
+			)
+{
+	uint64_t hash = Hash_key(key);
+	int bucket = hash % cache->no_of_buckets;
+	TYPE_ENTRY_T *entry;
+	int e;
+
+	cache->clock++;
+
+	/* 1. */
+	for( e = cache->buckets[bucket] ; e >= 0 ; e = cache->entries[e].next )
+	{
+		entry = &cache->entries[e];
+		if( Same_key(entry, key, hash) )
+		{
+			entry->references++;
+			entry->last_used = cache->clock;
+			cache->hits++;
+			return entry->type;
+		}
+	}
+
+	/* 2. */
+	cache->misses++;
+	e = Free_slot(cache);
+	if( e < 0 )
+	{
+		return Build_type(key);
+	}
+
+	entry = &cache->entries[e];
+	entry->ints = malloc((key->no_of_ints + 1) * sizeof(int));
+	entry->aints = malloc((key->no_of_aints + 1) * sizeof(MPI_Aint));
+	entry->types = malloc((key->no_of_types + 1) * sizeof(MPI_Datatype));
+	if( entry->ints == NULL || entry->aints == NULL || entry->types == NULL )
+	{
+		free(entry->ints);
+		free(entry->aints);
+		free(entry->types);
+		memset(entry, 0, sizeof(TYPE_ENTRY_T));
+		return Build_type(key);
+	}
+
+	entry->in_use = 1;
+	entry->kind = key->kind;
+	entry->hash = hash;
+	entry->no_of_ints = key->no_of_ints;
+	entry->no_of_aints = key->no_of_aints;
+	entry->no_of_types = key->no_of_types;
+	memcpy(entry->ints, key->ints, key->no_of_ints * sizeof(int));
+	memcpy(entry->aints, key->aints, key->no_of_aints * sizeof(MPI_Aint));
+	memcpy(entry->types, key->types, key->no_of_types * sizeof(MPI_Datatype));
+	entry->type = Build_type(key);
+	entry->references = 1;
+	entry->last_used = cache->clock;
+	entry->source = source;
+	if( source >= 0 )
+	{
+		cache->entries[source].references++;
+	}
+	entry->next = cache->buckets[bucket];
+	cache->buckets[bucket] = e;
+
+	return entry->type;
+}
+
+/*
+ * Empty cache of capacity entries, twice as many buckets
+ */
+TYPE_CACHE_T *Type_cache_create(int capacity	/* in */)
+{
+	TYPE_CACHE_T *cache = malloc(sizeof(TYPE_CACHE_T));
+	int b;
+
+	if( cache == NULL )
+	{
+		return NULL;
+	}
+	cache->capacity = (capacity > 0) ? capacity : TYPE_CACHE_DEFAULT_SIZE;
+	cache->no_of_buckets = 2 * cache->capacity;
+	cache->buckets = malloc(cache->no_of_buckets * sizeof(int));
+	cache->entries = calloc(cache->capacity, sizeof(TYPE_ENTRY_T));
+	if( cache->buckets == NULL || cache->entries == NULL )
+	{
+		free(cache->buckets);
+		free(cache->entries);
+		free(cache);
+		return NULL;
+	}
+	for( b = 0 ; b < cache->no_of_buckets ; b++ )
+	{
+		cache->buckets[b] = -1;
+	}
+	cache->clock = 0;
+	cache->hits = cache->misses = cache->evictions = 0;
+
+	return cache;
+}
+
+void Type_cache_free(TYPE_CACHE_T **cache	/* in/out */)
+{
+	int e;
+
+	if( *cache == NULL )
+	{
+		return;
+	}
+	for( e = 0 ; e < (*cache)->capacity ; e++ )
+	{
+		if( (*cache)->entries[e].in_use )
+		{
+			MPI_Type_free(&(*cache)->entries[e].type);
+			free((*cache)->entries[e].ints);
+			free((*cache)->entries[e].aints);
+			free((*cache)->entries[e].types);
+		}
+	}
+	free((*cache)->buckets);
+	free((*cache)->entries);
+	free(*cache);
+	*cache = NULL;
+}
+
+/*
+ * Key : ints = { count, block_length, stride }, types = { base }
+ */
+MPI_Datatype Type_cache_vector(TYPE_CACHE_T *cache,	/* in/out */
+			int count,							/* in */
+			int block_length,					/* in */
+			int stride,							/* in */
+			MPI_Datatype base					/* in */
+			)
+{
+	int ints[3];
+	TYPE_KEY_T key;
+
+	ints[0] = count;
+	ints[1] = block_length;
+	ints[2] = stride;
+	key.kind = TYPE_VECTOR;
+	key.no_of_ints = 3;
+	key.ints = ints;
+	key.no_of_aints = 0;
+	key.aints = NULL;
+	key.no_of_types = 1;
+	key.types = &base;
+
+	return Lookup(cache, &key, -1);
+}
+
+/*
+ * Key : ints = { count, block_lengths, displacements }, types = { base }
+ */
+MPI_Datatype Type_cache_indexed(TYPE_CACHE_T *cache,	/* in/out */
+			int count,							/* in */
+			const int block_lengths[],			/* in */
+			const int displacements[],			/* in */
+			MPI_Datatype base					/* in */
+			)
+{
+	int *ints = malloc((2 * count + 1) * sizeof(int));
+	TYPE_KEY_T key;
+	MPI_Datatype type;
+
+	if( ints == NULL )
+	{
+		MPI_Type_indexed(count, block_lengths, displacements, base, &type);
+		MPI_Type_commit(&type);
+		return type;
+	}
+	ints[0] = count;
+	memcpy(&ints[1], block_lengths, count * sizeof(int));
+	memcpy(&ints[1 + count], displacements, count * sizeof(int));
+	key.kind = TYPE_INDEXED;
+	key.no_of_ints = 2 * count + 1;
+	key.ints = ints;
+	key.no_of_aints = 0;
+	key.aints = NULL;
+	key.no_of_types = 1;
+	key.types = &base;
+
+	type = Lookup(cache, &key, -1);
+	free(ints);
+	return type;
+}
+
+/*
+ * Key : ints = { count, block_lengths }, aints = displacements, types = types
+ */
+MPI_Datatype Type_cache_struct(TYPE_CACHE_T *cache,	/* in/out */
+			int count,							/* in */
+			const int block_lengths[],			/* in */
+			const MPI_Aint displacements[],		/* in */
+			const MPI_Datatype types[]			/* in */
+			)
+{
+	int *ints = malloc((count + 1) * sizeof(int));
+	TYPE_KEY_T key;
+	MPI_Datatype type;
+
+	if( ints == NULL )
+	{
+		MPI_Type_create_struct(count, block_lengths, displacements, types, &type);
+		MPI_Type_commit(&type);
+		return type;
+	}
+	ints[0] = count;
+	memcpy(&ints[1], block_lengths, count * sizeof(int));
+	key.kind = TYPE_STRUCT;
+	key.no_of_ints = count + 1;
+	key.ints = ints;
+	key.no_of_aints = count;
+	key.aints = displacements;
+	key.no_of_types = count;
+	key.types = types;
+
+	type = Lookup(cache, &key, -1);
+	free(ints);
+	return type;
+}
+
+/*
+ * Key : aints = { lb, extent }, types = { type }
+ */
+MPI_Datatype Type_cache_resized(TYPE_CACHE_T *cache,	/* in/out */
+			MPI_Datatype type,					/* in */
+			MPI_Aint lb,						/* in */
+			MPI_Aint extent						/* in */
+			)
+{
+	MPI_Aint aints[2];
+	TYPE_KEY_T key;
+
+	aints[0] = lb;
+	aints[1] = extent;
+	key.kind = TYPE_RESIZED;
+	key.no_of_ints = 0;
+	key.ints = NULL;
+	key.no_of_aints = 2;
+	key.aints = aints;
+	key.no_of_types = 1;
+	key.types = &type;
+
+	return Lookup(cache, &key, Find_type(cache, type));
+}
+
+/*
+ * One reference less; a type that is not in the cache is freed
+ */
+void Type_cache_release(TYPE_CACHE_T *cache,	/* in/out */
+			MPI_Datatype type					/* in */
+			)
+{
+	int e = Find_type(cache, type);
+
+	if( e >= 0 )
+	{
+		Release_entry(cache, e);
+	}
+	else
+	{
+		MPI_Type_free(&type);
+	}
+}
+
+void Type_cache_stats(const TYPE_CACHE_T *cache,	/* in */
+			long *hits_ptr,						/* out */
+			long *misses_ptr,					/* out */
+			long *evictions_ptr					/* out */
+			)
+{
+	*hits_ptr = cache->hits;
+	*misses_ptr = cache->misses;
+	*evictions_ptr = cache->evictions;
+}
+
+void Type_cache_print_stats(const TYPE_CACHE_T *cache,	/* in */
+			const char *title						/* in */
+			)
+{
+	long lookups = cache->hits + cache->misses;
+
+	printf("%s : %ld lookups , %ld hits , %ld misses , %ld evictions , hit rate %.1f %% \n", title, lookups,
+			cache->hits, cache->misses, cache->evictions,
+			(lookups > 0) ? 100.0 * cache->hits / lookups : 0.0);
+}
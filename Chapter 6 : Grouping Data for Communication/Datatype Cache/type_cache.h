@@ -0,0 +1,101 @@
+/*
+ * type_cache.h
+ *
+ *  Created on: 16-Oct-2026
+ *      Author: prateek
+ *      Desc : Header for type_cache.c -- committed derived datatypes kept and
+ *      	handed out again for every layout that has been seen before, instead of
+ *      	being built, committed and freed on every message.
+ */
+#ifndef TYPE_CACHE_H
+#define TYPE_CACHE_H
+
+#include <mpi/mpi.h>
+
+/* Layouts a cache keeps when none is given */
+#define TYPE_CACHE_DEFAULT_SIZE		64
+
+/* The constructors a layout can come from */
+typedef enum {
+	TYPE_VECTOR,		/* MPI_Type_vector                       */
+	TYPE_INDEXED,		/* MPI_Type_indexed                      */
+	TYPE_STRUCT,		/* MPI_Type_create_struct                */
+	TYPE_RESIZED		/* MPI_Type_create_resized of a type     */
+} TYPE_KIND_T;
+
+typedef struct TYPE_CACHE TYPE_CACHE_T;
+
+/* Empty cache holding at most capacity layouts ( TYPE_CACHE_DEFAULT_SIZE if
+ * capacity <= 0 ). Returns NULL if there is not enough memory */
+TYPE_CACHE_T *Type_cache_create(
+		int capacity				/* in */
+		);
+
+/* Frees every datatype in the cache, referenced or not, then the cache */
+void Type_cache_free(
+		TYPE_CACHE_T **cache		/* in/out */
+		);
+
+/* The committed datatypes. Each call takes a reference, given back with
+ * Type_cache_release; never MPI_Type_free them. A layout seen before
+ * returns the same datatype without building or committing anything */
+
+/* count blocks of block_length base elements, stride elements apart */
+MPI_Datatype Type_cache_vector(
+		TYPE_CACHE_T *cache,		/* in/out */
+		int count,					/* in */
+		int block_length,			/* in */
+		int stride,					/* in */
+		MPI_Datatype base			/* in */
+		);
+
+/* Block i has block_lengths[i] base elements at displacements[i] elements */
+MPI_Datatype Type_cache_indexed(
+		TYPE_CACHE_T *cache,		/* in/out */
+		int count,					/* in */
+		const int block_lengths[],	/* in */
+		const int displacements[],	/* in */
+		MPI_Datatype base			/* in */
+		);
+
+/* Block i has block_lengths[i] elements of types[i] at displacements[i] bytes */
+MPI_Datatype Type_cache_struct(
+		TYPE_CACHE_T *cache,		/* in/out */
+		int count,					/* in */
+		const int block_lengths[],	/* in */
+		const MPI_Aint displacements[],	/* in */
+		const MPI_Datatype types[]	/* in */
+		);
+
+/* type with lower bound lb and extent extent, e.g. a column type resized
+ * to one element so that consecutive columns can be scattered. type must
+ * come from the same cache; the new type keeps a reference to it */
+MPI_Datatype Type_cache_resized(
+		TYPE_CACHE_T *cache,		/* in/out */
+		MPI_Datatype type,			/* in */
+		MPI_Aint lb,				/* in */
+		MPI_Aint extent				/* in */
+		);
+
+/* Give back one reference to type. It stays committed in the cache until
+ * it is the least recently used unreferenced layout and room is needed */
+void Type_cache_release(
+		TYPE_CACHE_T *cache,		/* in/out */
+		MPI_Datatype type			/* in */
+		);
+
+/* Lookups that found the layout, that had to build it, and layouts evicted */
+void Type_cache_stats(
+		const TYPE_CACHE_T *cache,	/* in */
+		long *hits_ptr,				/* out */
+		long *misses_ptr,			/* out */
+		long *evictions_ptr			/* out */
+		);
+
+/* Print the stats and the hit rate after title */
+void Type_cache_print_stats(
+		const TYPE_CACHE_T *cache,	/* in */
+		const char *title			/* in */
+		);
+
+#endif /* TYPE_CACHE_H */
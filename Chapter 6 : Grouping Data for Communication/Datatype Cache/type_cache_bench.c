@@ -0,0 +1,328 @@
+/*
+ * type_cache_bench.c
+ *
+ *  Created on: 16-Oct-2026
+ *      Author: prateek
+ *      Desc : Transfers of work as in chap14b/service_requests.c : every other
+ *      	node of a stack of ints is sent with an MPI_Type_indexed. The type is
+ *      	built, committed and freed for every transfer, as in Split and
+ *      	Send_work, or taken from type_cache.c. Then columns of a matrix are sent
+ *      	the same two ways with a resized MPI_Type_vector.
+ *      Input :
+ *      	capacity : no of layouts the cache keeps
+ *      Output :
+ *      	The time per transfer ( slowest process ) of both ways, for the types
+ *      	alone and with the messages, whether what arrived is right, and the hit
+ *      	rate of the cache.
+ *
+ *      Algorithm:
+ *      1) The stacks come in NO_OF_SHAPES shapes, the nodes of shape s being of
+ *         2 + (7 i + s) % 9 ints. Transfer t uses shape Shape_of(t), drawn so
+ *         that low shapes come up more often, like the few sizes a search
+ *         really produces.
+ *      2) Process r exchanges with r ^ 1, or with itself if that does not exist,
+ *         sending with the datatype and receiving the selected ints in a row.
+ *
+ *      NOTES:
+ *      	1. With a capacity below NO_OF_SHAPES the cache has to evict, and the
+ *      	   hit rate shows how well LRU copes with the skewed shapes.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <mpi/mpi.h>
+#include "type_cache.h"
+
+#define STACK_INTS		4096	/* Ints on a stack */
+#define NO_OF_SHAPES	16
+#define TRANSFERS		2000
+#define ORDER			512		/* Of the matrix whose columns are sent */
+#define WORK_TAG		7601
+
+/* The nodes of one shape that are sent */
+typedef struct {
+	int node_count;
+	int total;				/* Ints sent */
+	int *block_lengths;
+	int *displacements;
+} SHAPE_T;
+
+void Get_data(int *capacity_ptr, int my_rank);
+void Build_shape(SHAPE_T *shape, int s);
+int Shape_of(int t);
+double Time_stack_transfers(TYPE_CACHE_T *cache, const SHAPE_T shapes[], int communicate, const int stack[],
+		int partner, int *ok_ptr);
+double Time_column_transfers(TYPE_CACHE_T *cache, const float matrix[], int partner, int *ok_ptr);
+
+int main(int argc, char **argv)
+{
+	int my_rank;
+	int p;
+	int capacity;
+	int partner;
+	SHAPE_T shapes[NO_OF_SHAPES];
+	int *stack;
+	float *matrix;
+	TYPE_CACHE_T *cache;
+	double elapsed, seconds[6];
+	int ok, all_ok;
+	int s, i, j, test;
+
+	MPI_Init(&argc, &argv);
+	MPI_Comm_size(MPI_COMM_WORLD, &p);
+	MPI_Comm_rank(MPI_COMM_WORLD, &my_rank);
+
+	Get_data(&capacity, my_rank);
+	partner = ((my_rank ^ 1) < p) ? (my_rank ^ 1) : my_rank;
+
+	for( s = 0 ; s < NO_OF_SHAPES ; s++ )
+	{
+		Build_shape(&shapes[s], s);
+	}
+	stack = malloc(STACK_INTS * sizeof(int));
+	for( i = 0 ; i < STACK_INTS ; i++ )
+	{
+		stack[i] = my_rank * STACK_INTS + i;
+	}
+	matrix = malloc((size_t) ORDER * ORDER * sizeof(float));
+	for( i = 0 ; i < ORDER ; i++ )
+	{
+		for( j = 0 ; j < ORDER ; j++ )
+		{
+			matrix[(size_t) i * ORDER + j] = (float) (my_rank * ORDER * ORDER + i * ORDER + j);
+		}
+	}
+	cache = Type_cache_create(capacity);
+
+	/* Without, then with the cache : the types alone, with the messages, the columns */
+	all_ok = 1;
+	for( test = 0 ; test < 6 ; test++ )
+	{
+		MPI_Barrier(MPI_COMM_WORLD);
+		switch( test )
+		{
+		case 0:
+		case 1:
+			elapsed = Time_stack_transfers(test ? cache : NULL, shapes, 0, stack, partner, &ok);
+			break;
+		case 2:
+		case 3:
+			elapsed = Time_stack_transfers((test == 3) ? cache : NULL, shapes, 1, stack, partner, &ok);
+			break;
+		default:
+			elapsed = Time_column_transfers((test == 5) ? cache : NULL, matrix, partner, &ok);
+			break;
+		}
+		MPI_Reduce(&elapsed, &seconds[test], 1, MPI_DOUBLE, MPI_MAX, 0, MPI_COMM_WORLD);
+		all_ok &= ok;
+	}
+	MPI_Allreduce(MPI_IN_PLACE, &all_ok, 1, MPI_INT, MPI_MIN, MPI_COMM_WORLD);
+
+	if( my_rank == 0 )
+	{
+		printf("p = %d , %d transfers of %d shapes , cache of %d layouts \n", p, TRANSFERS, NO_OF_SHAPES,
+				capacity);
+		printf("                         rebuilt        cached \n");
+		printf("indexed type alone   : %e s  %e s per transfer \n", seconds[0], seconds[1]);
+		printf("indexed type + send  : %e s  %e s per transfer \n", seconds[2], seconds[3]);
+		printf("column type + send   : %e s  %e s per transfer \n", seconds[4], seconds[5]);
+		printf("Data received : %s \n", all_ok ? "right" : "WRONG");
+		Type_cache_print_stats(cache, "Cache on process 0");
+	}
+
+	Type_cache_free(&cache);
+	for( s = 0 ; s < NO_OF_SHAPES ; s++ )
+	{
+		free(shapes[s].block_lengths);
+		free(shapes[s].displacements);
+	}
+	free(stack);
+	free(matrix);
+	MPI_Finalize();
+
+	return 0;
+}
+
+/*
+ * Process 0 reads the capacity of the cache and broadcasts it
+ */
+void Get_data(int *capacity_ptr,	/* out */
+			int my_rank				/* in */
+			)
+{
+	if( my_rank == 0 )
+	{
+		printf("Enter the no of layouts the cache keeps\n");
+		scanf("%d", capacity_ptr);
+	}
+
+	MPI_Bcast(capacity_ptr, 1, MPI_INT, 0, MPI_COMM_WORLD);
+}
+
+/*
+ * Every other node of a stack of shape s, like Split
+ */
+void Build_shape(SHAPE_T *shape,	/* out */
+			int s					/* in */
+			)
+{
+	int index = 0;
+	int size, i;
+
+	shape->block_lengths = malloc(STACK_INTS * sizeof(int));
+	shape->displacements = malloc(STACK_INTS * sizeof(int));
+	shape->node_count = 0;
+	shape->total = 0;
+	for( i = 0 ; ; i++ )
+	{
+		size = 2 + (7 * i + s) % 9;
+		if( index + size > STACK_INTS )
+		{
+			break;
+		}
+		if( i % 2 == 1 )
+		{
+			shape->block_lengths[shape->node_count] = size;
+			shape->displacements[shape->node_count] = index;
+			shape->node_count++;
+			shape->total += size;
+		}
+		index += size;
+	}
+}
+
+/*
+ * Shape of transfer t : shape s comes up about twice as often as s + 1
+ */
+int Shape_of(int t	/* in */)
+{
+	unsigned hash = (unsigned) t * 2654435761u;
+	int s = 0;
+
+	while( s < NO_OF_SHAPES - 1 && (hash & (1u << (31 - s))) == 0 )
+	{
+		s++;
+	}
+	return s;
+}
+
+/********************************************************************/
+/* Function Time_stack_transfers
+ * Time per transfer of TRANSFERS transfers. The type comes from cache,
+ * or is built and freed every time if cache is NULL. If communicate
+ * is 0 only the type is made and given back; otherwise the nodes are
+ * exchanged with partner and checked.
+ ********************************************************************/
+double Time_stack_transfers(TYPE_CACHE_T *cache,	/* in/out */
+			const SHAPE_T shapes[],				/* in */
+			int communicate,					/* in */
+			const int stack[],					/* in */
+			int partner,						/* in */
+			int *ok_ptr							/* out */
+			)
+{
+	const SHAPE_T *shape;
+	MPI_Datatype stack_mpi_t;
+	int received[STACK_INTS];
+	double start;
+	int t, n, i, k;
+
+	*ok_ptr = 1;
+	start = MPI_Wtime();
+	for( t = 0 ; t < TRANSFERS ; t++ )
+	{
+		shape = &shapes[Shape_of(t)];
+		if( cache == NULL )
+		{
+			MPI_Type_indexed(shape->node_count, shape->block_lengths, shape->displacements, MPI_INT,
+					&stack_mpi_t);
+			MPI_Type_commit(&stack_mpi_t);
+		}
+		else
+		{
+			stack_mpi_t = Type_cache_indexed(cache, shape->node_count, shape->block_lengths,
+					shape->displacements, MPI_INT);
+		}
+
+		if( communicate )
+		{
+			MPI_Sendrecv(stack, 1, stack_mpi_t, partner, WORK_TAG, received, shape->total, MPI_INT, partner,
+					WORK_TAG, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+			k = 0;
+			for( n = 0 ; n < shape->node_count ; n++ )
+			{
+				for( i = 0 ; i < shape->block_lengths[n] ; i++ )
+				{
+					*ok_ptr &= (received[k++] == partner * STACK_INTS + shape->displacements[n] + i);
+				}
+			}
+		}
+
+		if( cache == NULL )
+		{
+			MPI_Type_free(&stack_mpi_t);
+		}
+		else
+		{
+			Type_cache_release(cache, stack_mpi_t);
+		}
+	}
+
+	return (MPI_Wtime() - start) / TRANSFERS;
+}
+
+/********************************************************************/
+/* Function Time_column_transfers
+ * Time per transfer of sending column t % ORDER of matrix to partner
+ * with an MPI_Type_vector resized to one float, like chap06/send_col.c.
+ * The types come from cache, or are built and freed every time if
+ * cache is NULL.
+ ********************************************************************/
+double Time_column_transfers(TYPE_CACHE_T *cache,	/* in/out */
+			const float matrix[],				/* in */
+			int partner,						/* in */
+			int *ok_ptr							/* out */
+			)
+{
+	MPI_Datatype vector_mpi_t, column_mpi_t;
+	float received[ORDER];
+	double start;
+	int t, col, i;
+
+	*ok_ptr = 1;
+	start = MPI_Wtime();
+	for( t = 0 ; t < TRANSFERS ; t++ )
+	{
+		col = t % ORDER;
+		if( cache == NULL )
+		{
+			MPI_Type_vector(ORDER, 1, ORDER, MPI_FLOAT, &vector_mpi_t);
+			MPI_Type_create_resized(vector_mpi_t, 0, sizeof(float), &column_mpi_t);
+			MPI_Type_commit(&column_mpi_t);
+			MPI_Type_free(&vector_mpi_t);
+		}
+		else
+		{
+			vector_mpi_t = Type_cache_vector(cache, ORDER, 1, ORDER, MPI_FLOAT);
+			column_mpi_t = Type_cache_resized(cache, vector_mpi_t, 0, sizeof(float));
+			Type_cache_release(cache, vector_mpi_t);
+		}
+
+		MPI_Sendrecv(&matrix[col], 1, column_mpi_t, partner, WORK_TAG, received, ORDER, MPI_FLOAT, partner,
+				WORK_TAG, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+		for( i = 0 ; i < ORDER ; i++ )
+		{
+			*ok_ptr &= (received[i] == (float) (partner * ORDER * ORDER + i * ORDER + col));
+		}
+
+		if( cache == NULL )
+		{
+			MPI_Type_free(&column_mpi_t);
+		}
+		else
+		{
+			Type_cache_release(cache, column_mpi_t);
+		}
+	}
+
+	return (MPI_Wtime() - start) / TRANSFERS;
+}
@@ -0,0 +1,500 @@
+/*
+ * dist_csr.c
+ *
+ *  Created on: 16-Oct-2026
+ *      Author: prateek
+ *      Desc : A sparse matrix distributed by block rows, without PETSc
+ *      	( chap15/sparse_linsolve.c ). chap06/sparse_row.c sends one row packed
+ *      	in a buffer; here every process keeps its rows in CSR form and y = Ax
+ *      	moves only the entries of x that its rows use.
+ *
+ *      	Dist_csr_create splits my rows by column :
+ *      		local  : columns of my own block of x, renumbered from 0
+ *      		remote : every other column that appears, renumbered from 0 in
+ *      		         increasing global order
+ *      	The remote columns sorted this way come in runs owned by one process,
+ *      	so the entries of x from process q land in one piece of the halo and
+ *      	are received straight there. Each owner is told once which of its
+ *      	entries to send, and the receives and sends become persistent requests.
+ *
+ *      	Dist_csr_spmv then only packs the entries to send and starts the
+ *      	requests; it multiplies the local columns while the halo is on its
+ *      	way, and the remote columns once it has arrived.
+ *
+ *      NOTES:
+ *      	1. Renumbering keeps both x's small : the local block has local_n
+ *      	   entries and the halo only the ones used, so the gathers of x[cols[k]]
+ *      	   stay in cache instead of ranging over an x of order n.
+ *      	2. Without a progress thread the messages only move inside MPI calls,
+ *      	   so the local part is done SPMV_ROWS rows at a time with an
+ *      	   MPI_Testall after each piece, as in chap13 Overlapped Matrix Vector.
+ */
+#include <stdlib.h>
+#include <string.h>
+#include "dist_csr.h"
+
+#define SPMV_ROWS	1024	/* Local rows multiplied between two MPI_Testall */
+
+static int Compare_ints(const void *a, const void *b)
+{
+	int x = *(const int *) a;
+	int y = *(const int *) b;
+
+	return (x > y) - (x < y);
+}
+
+/*
+ * Allocate a CSR block of rows rows and nonzeros entries. Returns 0 on failure
+ */
+static int Csr_block_allocate(CSR_BLOCK_T *block,	/* out */
+			int rows,						/* in */
+			int nonzeros					/* in */
+			)
+{
+	block->rows = rows;
+	block->row_start = malloc((rows + 1) * sizeof(int));
+	block->cols = malloc((nonzeros + 1) * sizeof(int));
+	block->values = malloc((nonzeros + 1) * sizeof(float));
+
+	return block->row_start != NULL && block->cols != NULL && block->values != NULL;
+}
+
+static void Csr_block_free(CSR_BLOCK_T *block	/* in/out */)
+{
+	free(block->row_start);
+	free(block->cols);
+	free(block->values);
+	block->row_start = NULL;
+	block->cols = NULL;
+	block->values = NULL;
+}
+
+/********************************************************************/
+/* Function Split_columns
+ * Fills A->local and A->remote from rows, and A->halo_cols with the
+ * distinct remote columns in increasing order. Rows without remote
+ * entries are left out of A->remote, which saves a pass over all of
+ * local_y in every product. Returns 0 on failure.
+ ********************************************************************/
+static int Split_columns(const CSR_BLOCK_T *rows,	/* in */
+			DIST_CSR_T *A					/* in/out */
+			)
+{
+	int my_end = A->first_row + rows->rows;
+	int local_nonzeros = 0, remote_nonzeros = 0;
+	int remote_row_count = 0;
+	int *sorted;
+	int col, i, k, r;
+
+	for( i = 0 ; i < rows->rows ; i++ )
+	{
+		r = remote_nonzeros;
+		for( k = rows->row_start[i] ; k < rows->row_start[i + 1] ; k++ )
+		{
+			col = rows->cols[k];
+			if( col >= A->first_row && col < my_end )
+			{
+				local_nonzeros++;
+			}
+			else
+			{
+				remote_nonzeros++;
+			}
+		}
+		remote_row_count += (remote_nonzeros > r);
+	}
+
+	sorted = malloc((remote_nonzeros + 1) * sizeof(int));
+	A->remote_rows = malloc((remote_row_count + 1) * sizeof(int));
+	if( !Csr_block_allocate(&A->local, rows->rows, local_nonzeros)
+			|| !Csr_block_allocate(&A->remote, remote_row_count, remote_nonzeros) || sorted == NULL
+			|| A->remote_rows == NULL )
+	{
+		free(sorted);
+		return 0;
+	}
+
+	/* The distinct remote columns */
+	remote_nonzeros = 0;
+	for( k = 0 ; k < rows->row_start[rows->rows] ; k++ )
+	{
+		col = rows->cols[k];
+		if( col < A->first_row || col >= my_end )
+		{
+			sorted[remote_nonzeros++] = col;
+		}
+	}
+	qsort(sorted, remote_nonzeros, sizeof(int), Compare_ints);
+	A->halo_size = 0;
+	for( k = 0 ; k < remote_nonzeros ; k++ )
+	{
+		if( A->halo_size == 0 || sorted[k] != sorted[A->halo_size - 1] )
+		{
+			sorted[A->halo_size++] = sorted[k];
+		}
+	}
+	A->halo_cols = sorted;
+	A->halo = malloc((A->halo_size + 1) * sizeof(float));
+	if( A->halo == NULL )
+	{
+		return 0;
+	}
+
+	/* Both blocks, renumbered */
+	local_nonzeros = remote_nonzeros = 0;
+	r = 0;
+	for( i = 0 ; i < rows->rows ; i++ )
+	{
+		A->local.row_start[i] = local_nonzeros;
+		A->remote.row_start[r] = remote_nonzeros;
+		for( k = rows->row_start[i] ; k < rows->row_start[i + 1] ; k++ )
+		{
+			col = rows->cols[k];
+			if( col >= A->first_row && col < my_end )
+			{
+				A->local.cols[local_nonzeros] = col - A->first_row;
+				A->local.values[local_nonzeros++] = rows->values[k];
+			}
+			else
+			{
+				A->remote.cols[remote_nonzeros] = (int) ((int *) bsearch(&col, A->halo_cols, A->halo_size,
+						sizeof(int), Compare_ints) - A->halo_cols);
+				A->remote.values[remote_nonzeros++] = rows->values[k];
+			}
+		}
+		if( remote_nonzeros > A->remote.row_start[r] )
+		{
+			A->remote_rows[r++] = i;
+		}
+	}
+	A->local.row_start[rows->rows] = local_nonzeros;
+	A->remote.row_start[r] = remote_nonzeros;
+
+	return 1;
+}
+
+/********************************************************************/
+/* Function Build_plan
+ * Algorithm:
+ *     1.  Walk the sorted halo columns, cutting them into runs by owner :
+ *         these are my receives.
+ *     2.  MPI_Alltoall the no of entries I need from each process, so
+ *         each process learns how many it sends to whom.
+ *     3.  Send every owner the global columns I need from it; what I
+ *         receive are the columns I must send, made local.
+ * Returns 0 if memory ran out on any process.
+ ********************************************************************/
+static int Build_plan(DIST_CSR_T *A		/* in/out */)
+{
+	HALO_PLAN_T *plan = &A->plan;
+	int p;
+	int *need, *give;
+	int no_of_indices;
+	MPI_Request *requests;
+	int owner, q, k, ok;
+
+	MPI_Comm_size(A->comm, &p);
+	need = calloc(p, sizeof(int));
+	give = malloc(p * sizeof(int));
+	ok = (need != NULL && give != NULL);
+
+	/* 1. Runs of the halo by owner */
+	owner = 0;
+	for( k = 0 ; ok && k < A->halo_size ; k++ )
+	{
+		while( A->halo_cols[k] >= A->first_rows[owner + 1] )
+		{
+			owner++;
+		}
+		need[owner]++;
+	}
+	MPI_Allreduce(MPI_IN_PLACE, &ok, 1, MPI_INT, MPI_MIN, A->comm);
+	if( !ok )
+	{
+		free(need);
+		free(give);
+		return 0;
+	}
+
+	/* 2. */
+	MPI_Alltoall(need, 1, MPI_INT, give, 1, MPI_INT, A->comm);
+
+	plan->no_of_recvs = plan->no_of_sends = 0;
+	no_of_indices = 0;
+	for( q = 0 ; q < p ; q++ )
+	{
+		plan->no_of_recvs += (need[q] > 0);
+		plan->no_of_sends += (give[q] > 0);
+		no_of_indices += give[q];
+	}
+	plan->recv_ranks = malloc((plan->no_of_recvs + 1) * sizeof(int));
+	plan->recv_counts = malloc((plan->no_of_recvs + 1) * sizeof(int));
+	plan->recv_offsets = malloc((plan->no_of_recvs + 1) * sizeof(int));
+	plan->send_ranks = malloc((plan->no_of_sends + 1) * sizeof(int));
+	plan->send_counts = malloc((plan->no_of_sends + 1) * sizeof(int));
+	plan->send_offsets = malloc((plan->no_of_sends + 1) * sizeof(int));
+	plan->send_indices = malloc((no_of_indices + 1) * sizeof(int));
+	plan->send_buffer = malloc((no_of_indices + 1) * sizeof(float));
+	plan->requests = malloc((plan->no_of_recvs + plan->no_of_sends + 1) * sizeof(MPI_Request));
+	ok = (plan->recv_ranks != NULL && plan->recv_counts != NULL && plan->recv_offsets != NULL
+			&& plan->send_ranks != NULL && plan->send_counts != NULL && plan->send_offsets != NULL
+			&& plan->send_indices != NULL && plan->send_buffer != NULL && plan->requests != NULL);
+	MPI_Allreduce(MPI_IN_PLACE, &ok, 1, MPI_INT, MPI_MIN, A->comm);
+	if( !ok )
+	{
+		free(plan->requests);
+		plan->requests = NULL;
+		free(need);
+		free(give);
+		return 0;
+	}
+
+	plan->no_of_recvs = plan->no_of_sends = 0;
+	no_of_indices = 0;
+	for( q = 0 ; q < p ; q++ )
+	{
+		if( need[q] > 0 )
+		{
+			plan->recv_ranks[plan->no_of_recvs] = q;
+			plan->recv_counts[plan->no_of_recvs] = need[q];
+			plan->recv_offsets[plan->no_of_recvs] = (plan->no_of_recvs == 0) ? 0 :
+					plan->recv_offsets[plan->no_of_recvs - 1] + plan->recv_counts[plan->no_of_recvs - 1];
+			plan->no_of_recvs++;
+		}
+		if( give[q] > 0 )
+		{
+			plan->send_ranks[plan->no_of_sends] = q;
+			plan->send_counts[plan->no_of_sends] = give[q];
+			plan->send_offsets[plan->no_of_sends] = no_of_indices;
+			no_of_indices += give[q];
+			plan->no_of_sends++;
+		}
+	}
+
+	/* 3. The column lists go the opposite way to the halo */
+	requests = plan->requests;
+	for( k = 0 ; k < plan->no_of_sends ; k++ )
+	{
+		MPI_Irecv(&plan->send_indices[plan->send_offsets[k]], plan->send_counts[k], MPI_INT, plan->send_ranks[k],
+				HALO_TAG, A->comm, &requests[k]);
+	}
+	for( k = 0 ; k < plan->no_of_recvs ; k++ )
+	{
+		MPI_Isend(&A->halo_cols[plan->recv_offsets[k]], plan->recv_counts[k], MPI_INT, plan->recv_ranks[k],
+				HALO_TAG, A->comm, &requests[plan->no_of_sends + k]);
+	}
+	MPI_Waitall(plan->no_of_sends + plan->no_of_recvs, requests, MPI_STATUSES_IGNORE);
+	plan->no_of_entries = no_of_indices;
+	for( k = 0 ; k < no_of_indices ; k++ )
+	{
+		plan->send_indices[k] -= A->first_row;
+	}
+
+	/* The persistent requests : receives first */
+	for( k = 0 ; k < plan->no_of_recvs ; k++ )
+	{
+		MPI_Recv_init(&A->halo[plan->recv_offsets[k]], plan->recv_counts[k], MPI_FLOAT, plan->recv_ranks[k],
+				HALO_TAG, A->comm, &requests[k]);
+	}
+	for( k = 0 ; k < plan->no_of_sends ; k++ )
+	{
+		MPI_Send_init(&plan->send_buffer[plan->send_offsets[k]], plan->send_counts[k], MPI_FLOAT,
+				plan->send_ranks[k], HALO_TAG, A->comm, &requests[plan->no_of_recvs + k]);
+	}
+
+	free(need);
+	free(give);
+	return 1;
+}
+
+/********************************************************************/
+/* Function Dist_csr_create
+ * Algorithm:
+ *     1.  MPI_Allgather the no of rows of every process, giving the
+ *         first row ( and entry of x ) of each.
+ *     2.  Split my rows into local and remote columns.
+ *     3.  Build the halo plan.
+ ********************************************************************/
+int Dist_csr_create(int n,			/* in */
+			int first_row,				/* in */
+			const CSR_BLOCK_T *rows,	/* in */
+			MPI_Comm comm,				/* in */
+			DIST_CSR_T *A				/* out */
+			)
+{
+	int p;
+	int ok, q;
+
+	memset(A, 0, sizeof(DIST_CSR_T));
+	MPI_Comm_size(comm, &p);
+	A->n = n;
+	A->first_row = first_row;
+	A->comm = comm;
+
+	/* 1. */
+	A->first_rows = malloc((p + 1) * sizeof(int));
+	ok = (A->first_rows != NULL);
+	MPI_Allreduce(MPI_IN_PLACE, &ok, 1, MPI_INT, MPI_MIN, comm);
+	if( !ok )
+	{
+		Dist_csr_free(A);
+		return 0;
+	}
+	MPI_Allgather(&rows->rows, 1, MPI_INT, &A->first_rows[1], 1, MPI_INT, comm);
+	A->first_rows[0] = 0;
+	for( q = 0 ; q < p ; q++ )
+	{
+		A->first_rows[q + 1] += A->first_rows[q];
+	}
+
+	/* 2. */
+	ok = Split_columns(rows, A);
+	MPI_Allreduce(MPI_IN_PLACE, &ok, 1, MPI_INT, MPI_MIN, comm);
+
+	/* 3. */
+	if( !ok || !Build_plan(A) )
+	{
+		Dist_csr_free(A);
+		return 0;
+	}
+	return 1;
+}
+
+void Dist_csr_free(DIST_CSR_T *A	/* in/out */)
+{
+	HALO_PLAN_T *plan = &A->plan;
+	int k;
+
+	if( plan->requests != NULL )
+	{
+		for( k = 0 ; k < plan->no_of_recvs + plan->no_of_sends ; k++ )
+		{
+			MPI_Request_free(&plan->requests[k]);
+		}
+	}
+	free(plan->recv_ranks);
+	free(plan->recv_counts);
+	free(plan->recv_offsets);
+	free(plan->send_ranks);
+	free(plan->send_counts);
+	free(plan->send_offsets);
+	free(plan->send_indices);
+	free(plan->send_buffer);
+	free(plan->requests);
+
+	Csr_block_free(&A->local);
+	Csr_block_free(&A->remote);
+	free(A->remote_rows);
+	free(A->first_rows);
+	free(A->halo_cols);
+	free(A->halo);
+	memset(A, 0, sizeof(DIST_CSR_T));
+}
+
+/*
+ * y += block x, one row at a time
+ */
+void Csr_block_mult(const CSR_BLOCK_T *block,	/* in */
+			const float x[],				/* in */
+			float y[]						/* in/out */
+			)
+{
+	const int *row_start = block->row_start;
+	const int *cols = block->cols;
+	const float *values = block->values;
+	float sum;
+	int i, k;
+
+	for( i = 0 ; i < block->rows ; i++ )
+	{
+		sum = 0.0f;
+#pragma omp simd reduction(+:sum)
+		for( k = row_start[i] ; k < row_start[i + 1] ; k++ )
+		{
+			sum += values[k] * x[cols[k]];
+		}
+		y[i] += sum;
+	}
+}
+
+/*
+ * local_y += remote columns times the halo, for the rows that have any
+ */
+static void Remote_mult(const DIST_CSR_T *A,	/* in */
+			float local_y[]					/* in/out */
+			)
+{
+	const int *row_start = A->remote.row_start;
+	const int *cols = A->remote.cols;
+	const float *values = A->remote.values;
+	const float *halo = A->halo;
+	float sum;
+	int r, k;
+
+	for( r = 0 ; r < A->remote.rows ; r++ )
+	{
+		sum = 0.0f;
+		for( k = row_start[r] ; k < row_start[r + 1] ; k++ )
+		{
+			sum += values[k] * halo[cols[k]];
+		}
+		local_y[A->remote_rows[r]] += sum;
+	}
+}
+
+/********************************************************************/
+/* Function Dist_csr_spmv
+ * Algorithm:
+ *     1.  Start the receives of the halo.
+ *     2.  Pack the entries of local_x each neighbour needs and start
+ *         the sends.
+ *     3.  local_y = local columns times local_x, SPMV_ROWS rows at a
+ *         time, testing the requests in between.
+ *     4.  Wait for the halo, then local_y += remote columns times halo.
+ ********************************************************************/
+void Dist_csr_spmv(DIST_CSR_T *A,	/* in/out */
+			const float local_x[],	/* in */
+			float local_y[]			/* out */
+			)
+{
+	HALO_PLAN_T *plan = &A->plan;
+	int no_of_requests = plan->no_of_recvs + plan->no_of_sends;
+	CSR_BLOCK_T piece;	// Rows first_row .. of A->local, sharing its arrays
+	int first_row, k;
+	int flag;
+
+	/* 1. */
+	if( plan->no_of_recvs > 0 )
+	{
+		MPI_Startall(plan->no_of_recvs, plan->requests);
+	}
+
+	/* 2. */
+	for( k = 0 ; k < plan->no_of_entries ; k++ )
+	{
+		plan->send_buffer[k] = local_x[plan->send_indices[k]];
+	}
+	if( plan->no_of_sends > 0 )
+	{
+		MPI_Startall(plan->no_of_sends, &plan->requests[plan->no_of_recvs]);
+	}
+
+	/* 3. */
+	memset(local_y, 0, A->local.rows * sizeof(float));
+	piece = A->local;
+	for( first_row = 0 ; first_row < A->local.rows ; first_row += SPMV_ROWS )
+	{
+		piece.rows = (A->local.rows - first_row < SPMV_ROWS) ? A->local.rows - first_row : SPMV_ROWS;
+		piece.row_start = &A->local.row_start[first_row];
+		Csr_block_mult(&piece, local_x, &local_y[first_row]);
+
+		if( no_of_requests > 0 )
+		{
+			MPI_Testall(no_of_requests, plan->requests, &flag, MPI_STATUSES_IGNORE);
+		}
+	}
+
+	/* 4. */
+	MPI_Waitall(no_of_requests, plan->requests, MPI_STATUSES_IGNORE);
+	Remote_mult(A, local_y);
+}
@@ -0,0 +1,97 @@
+/*
+ * dist_csr.h
+ *
+ *  Created on: 16-Oct-2026
+ *      Author: prateek
+ *      Desc : Header for dist_csr.c -- a square sparse matrix distributed by
+ *      	block rows in compressed sparse row ( CSR ) form, and y = Ax on it
+ *      	exchanging only the entries of x that each process really needs.
+ */
+#ifndef DIST_CSR_H
+#define DIST_CSR_H
+
+#include <mpi/mpi.h>
+
+/* Tag of the halo messages */
+#define HALO_TAG		7401
+
+/* Rows in CSR form : the entries of row i are values[row_start[i] ..
+ * row_start[i+1] - 1], in the columns cols[row_start[i] .. ] */
+typedef struct {
+	int rows;
+	int *row_start;		/* rows + 1 offsets */
+	int *cols;
+	float *values;
+} CSR_BLOCK_T;
+
+/* Who sends which entries of x to whom, worked out once */
+typedef struct {
+	int no_of_recvs;		/* Processes I receive from            */
+	int *recv_ranks;
+	int *recv_counts;		/* Entries from each of them           */
+	int *recv_offsets;		/* Where they go in the halo           */
+	int no_of_sends;		/* Processes I send to                 */
+	int *send_ranks;
+	int *send_counts;
+	int *send_offsets;		/* Into send_indices and send_buffer   */
+	int no_of_entries;		/* Entries I send, to all of them      */
+	int *send_indices;		/* Local index of each entry I send    */
+	float *send_buffer;
+	MPI_Request *requests;	/* Persistent : receives, then sends   */
+} HALO_PLAN_T;
+
+/* My block rows of an n x n matrix. x and y are distributed like the
+ * rows : process r holds rows and entries first_rows[r] .. first_rows[r+1] - 1.
+ * The columns are split in two :
+ *     local  : the columns of my own block of x, numbered from 0
+ *     remote : the other columns I use, numbered from 0 in the order of
+ *              their global column, which is the order of the halo.
+ *              Only the rows with a remote entry are kept; row r of
+ *              remote is my row remote_rows[r] */
+typedef struct {
+	int n;
+	int first_row;
+	int *first_rows;		/* p + 1 entries                       */
+	CSR_BLOCK_T local;
+	CSR_BLOCK_T remote;
+	int *remote_rows;
+	int halo_size;			/* No of remote columns                */
+	int *halo_cols;			/* Their global columns                */
+	float *halo;			/* Their entries of x, filled by spmv  */
+	HALO_PLAN_T plan;
+	MPI_Comm comm;
+} DIST_CSR_T;
+
+/* Build A from my rows of the matrix, given in CSR form with global
+ * columns ( rows->rows rows starting at first_row ). The rows of the
+ * processes must follow each other in rank order. Works out the halo
+ * plan and sets up its persistent requests. Collective over comm.
+ * Returns 0 if memory ran out on any process */
+int Dist_csr_create(
+		int n,						/* in */
+		int first_row,				/* in */
+		const CSR_BLOCK_T *rows,	/* in */
+		MPI_Comm comm,				/* in */
+		DIST_CSR_T *A				/* out */
+		);
+
+void Dist_csr_free(
+		DIST_CSR_T *A				/* in/out */
+		);
+
+/* local_y = my rows of A x. The halo exchange runs while the local
+ * columns are multiplied. Collective over A->comm */
+void Dist_csr_spmv(
+		DIST_CSR_T *A,				/* in/out */
+		const float local_x[],		/* in */
+		float local_y[]				/* out */
+		);
+
+/* y += block x for one CSR block */
+void Csr_block_mult(
+		const CSR_BLOCK_T *block,	/* in */
+		const float x[],			/* in */
+		float y[]					/* in/out */
+		);
+
+#endif /* DIST_CSR_H */
@@ -0,0 +1,258 @@
+/*
+ * sparse_mat_vec.c
+ *
+ *  Created on: 16-Oct-2026
+ *      Author: prateek
+ *      Desc : Times y = Ax for a distributed sparse matrix, with the halo plan
+ *      	of dist_csr.c against gathering all of x with MPI_Allgatherv.
+ *      Input :
+ *      	g : side of the grid, the matrix has order n = g * g
+ *      Output :
+ *      	The entries of x each process receives and the time of one product
+ *      	( slowest process ) for both ways, and whether y is right.
+ *
+ *      NOTES:
+ *      	1. A is the 5 point Laplacian of a g x g grid, 4 on the diagonal and -1
+ *      	   for each neighbour, plus A(i, (i + n/2) % n) = 1 in every FAR_EVERY'th
+ *      	   row, so that every process also needs a few entries from a process
+ *      	   far away.
+ *      	2. x(j) = j % 5 - 2, so every y(i) is an integer, exact in float, and
+ *      	   is checked against the sum worked out from the formula.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <mpi/mpi.h>
+#include "dist_csr.h"
+
+#define REPS		50
+#define ROW_MAX		6		/* Most nonzeros in a row of A */
+#define FAR_EVERY	64		/* Rows per far entry */
+
+void Get_data(int *g_ptr, int my_rank);
+void Block_range(int n, int no_of_blocks, int block, int *first_ptr, int *count_ptr);
+int Generate_rows(int g, int first_row, int local_n, CSR_BLOCK_T *rows);
+float X_entry(int j);
+
+int main(int argc, char **argv)
+{
+	int my_rank;
+	int p;
+	int g, n;
+	int local_n, first_row;
+	int *counts, *displacements;
+	CSR_BLOCK_T rows;
+	DIST_CSR_T A;
+	float *local_x, *global_x, *local_y, *gather_y;
+	double start, elapsed, seconds[2];
+	int received, total_received;
+	float expected;
+	int ok, all_ok;
+	int rank, rep, i, k;
+
+	MPI_Init(&argc, &argv);
+	MPI_Comm_size(MPI_COMM_WORLD, &p);
+	MPI_Comm_rank(MPI_COMM_WORLD, &my_rank);
+
+	Get_data(&g, my_rank);
+	n = g * g;
+
+	Block_range(n, p, my_rank, &first_row, &local_n);
+	counts = malloc(p * sizeof(int));
+	displacements = malloc(p * sizeof(int));
+	for( rank = 0 ; rank < p ; rank++ )
+	{
+		Block_range(n, p, rank, &displacements[rank], &counts[rank]);
+	}
+
+	local_x = malloc((local_n + 1) * sizeof(float));
+	global_x = malloc((n + 1) * sizeof(float));
+	local_y = malloc((local_n + 1) * sizeof(float));
+	gather_y = malloc((local_n + 1) * sizeof(float));
+	ok = Generate_rows(g, first_row, local_n, &rows) && local_x != NULL && global_x != NULL && local_y != NULL
+			&& gather_y != NULL;
+	MPI_Allreduce(&ok, &all_ok, 1, MPI_INT, MPI_MIN, MPI_COMM_WORLD);
+	if( !all_ok || !Dist_csr_create(n, first_row, &rows, MPI_COMM_WORLD, &A) )
+	{
+		if( my_rank == 0 )
+		{
+			fprintf(stderr, "Cannot allocate the matrix \n");
+		}
+		MPI_Abort(MPI_COMM_WORLD, 1);
+	}
+
+	for( i = 0 ; i < local_n ; i++ )
+	{
+		local_x[i] = X_entry(first_row + i);
+	}
+
+	/* All of x, then the rows with their global columns */
+	MPI_Barrier(MPI_COMM_WORLD);
+	start = MPI_Wtime();
+	for( rep = 0 ; rep < REPS ; rep++ )
+	{
+		MPI_Allgatherv(local_x, local_n, MPI_FLOAT, global_x, counts, displacements, MPI_FLOAT, MPI_COMM_WORLD);
+		for( i = 0 ; i < local_n ; i++ )
+		{
+			gather_y[i] = 0.0f;
+		}
+		Csr_block_mult(&rows, global_x, gather_y);
+	}
+	elapsed = (MPI_Wtime() - start) / REPS;
+	MPI_Reduce(&elapsed, &seconds[0], 1, MPI_DOUBLE, MPI_MAX, 0, MPI_COMM_WORLD);
+
+	/* The halo plan */
+	MPI_Barrier(MPI_COMM_WORLD);
+	start = MPI_Wtime();
+	for( rep = 0 ; rep < REPS ; rep++ )
+	{
+		Dist_csr_spmv(&A, local_x, local_y);
+	}
+	elapsed = (MPI_Wtime() - start) / REPS;
+	MPI_Reduce(&elapsed, &seconds[1], 1, MPI_DOUBLE, MPI_MAX, 0, MPI_COMM_WORLD);
+
+	ok = 1;
+	for( i = 0 ; i < local_n ; i++ )
+	{
+		expected = 0.0f;
+		for( k = rows.row_start[i] ; k < rows.row_start[i + 1] ; k++ )
+		{
+			expected += rows.values[k] * X_entry(rows.cols[k]);
+		}
+		ok &= (local_y[i] == expected && gather_y[i] == expected);
+	}
+	MPI_Reduce(&ok, &all_ok, 1, MPI_INT, MPI_MIN, 0, MPI_COMM_WORLD);
+
+	received = A.halo_size;
+	MPI_Reduce(&received, &total_received, 1, MPI_INT, MPI_SUM, 0, MPI_COMM_WORLD);
+
+	if( my_rank == 0 )
+	{
+		printf("n = %d , p = %d \n", n, p);
+		printf("allgatherv : %e s per product , %d entries of x received in all \n", seconds[0],
+				(p - 1) * n);
+		printf("halo plan  : %e s per product , %d entries of x received in all \n", seconds[1],
+				total_received);
+		printf("y is %s \n", all_ok ? "right" : "WRONG");
+	}
+
+	Dist_csr_free(&A);
+	free(rows.row_start);
+	free(rows.cols);
+	free(rows.values);
+	free(local_x);
+	free(global_x);
+	free(local_y);
+	free(gather_y);
+	free(counts);
+	free(displacements);
+	MPI_Finalize();
+
+	return 0;
+}
+
+/*
+ * Process 0 reads the side of the grid and broadcasts it
+ */
+void Get_data(int *g_ptr,	/* out */
+			int my_rank		/* in */
+			)
+{
+	if( my_rank == 0 )
+	{
+		printf("Enter the side of the grid\n");
+		scanf("%d", g_ptr);
+	}
+
+	MPI_Bcast(g_ptr, 1, MPI_INT, 0, MPI_COMM_WORLD);
+}
+
+/*
+ * First index and length of block number block of n split into no_of_blocks.
+ * The first n % no_of_blocks blocks get one more.
+ */
+void Block_range(int n,			/* in */
+			int no_of_blocks,	/* in */
+			int block,			/* in */
+			int *first_ptr,		/* out */
+			int *count_ptr		/* out */
+			)
+{
+	int quotient = n / no_of_blocks;
+	int remainder = n % no_of_blocks;
+
+	*count_ptr = quotient + (block < remainder ? 1 : 0);
+	*first_ptr = block * quotient + (block < remainder ? block : remainder);
+}
+
+/*
+ * Rows first_row .. first_row + local_n - 1 of A ( see NOTES ), with
+ * global columns. Returns 0 if there is not enough memory
+ */
+int Generate_rows(int g,			/* in */
+			int first_row,			/* in */
+			int local_n,			/* in */
+			CSR_BLOCK_T *rows		/* out */
+			)
+{
+	int n = g * g;
+	int i, i_global, row, col, far, nonzeros;
+
+	rows->rows = local_n;
+	rows->row_start = malloc((local_n + 1) * sizeof(int));
+	rows->cols = malloc(((size_t) local_n * ROW_MAX + 1) * sizeof(int));
+	rows->values = malloc(((size_t) local_n * ROW_MAX + 1) * sizeof(float));
+	if( rows->row_start == NULL || rows->cols == NULL || rows->values == NULL )
+	{
+		return 0;
+	}
+
+	nonzeros = 0;
+	for( i = 0 ; i < local_n ; i++ )
+	{
+		i_global = first_row + i;
+		row = i_global / g;
+		col = i_global % g;
+		far = (i_global + n / 2) % n;
+		rows->row_start[i] = nonzeros;
+
+		if( row > 0 )
+		{
+			rows->cols[nonzeros] = i_global - g;
+			rows->values[nonzeros++] = -1.0f;
+		}
+		if( col > 0 )
+		{
+			rows->cols[nonzeros] = i_global - 1;
+			rows->values[nonzeros++] = -1.0f;
+		}
+		rows->cols[nonzeros] = i_global;
+		rows->values[nonzeros++] = 4.0f;
+		if( col < g - 1 )
+		{
+			rows->cols[nonzeros] = i_global + 1;
+			rows->values[nonzeros++] = -1.0f;
+		}
+		if( row < g - 1 )
+		{
+			rows->cols[nonzeros] = i_global + g;
+			rows->values[nonzeros++] = -1.0f;
+		}
+		if( i_global % FAR_EVERY == 0 && far != i_global && far != i_global - g && far != i_global + g
+				&& far != i_global - 1 && far != i_global + 1 )
+		{
+			rows->cols[nonzeros] = far;
+			rows->values[nonzeros++] = 1.0f;
+		}
+	}
+	rows->row_start[local_n] = nonzeros;
+
+	return 1;
+}
+
+/*
+ * Entry j of x
+ */
+float X_entry(int j	/* in */)
+{
+	return (float) (j % 5 - 2);
+}
@@ -0,0 +1,404 @@
+/*
+ * dist_transpose.c
+ *
+ *  Created on: 16-Oct-2026
+ *      Author: prateek
+ *      Desc : Transpose of a matrix distributed by block rows.
+ *      	chap06/send_col_to_row.c sends a column of A as one MPI_Type_vector
+ *      	and receives it as a row, one float from every row of A. Done for the
+ *      	whole matrix that reads and writes a float per cache line. Here it
+ *      	goes in three steps :
+ *
+ *      	1. Every process transposes its rows of A locally into work, n x rows,
+ *      	   splitting the longer side until the blocks fit in cache. Rows
+ *      	   first_cols[q] .. of work are now everything q gets, one after the
+ *      	   other.
+ *      	2. One all-to-all. What process q sends me is cols rows of rows_q
+ *      	   floats, and they belong in columns first_rows[q] .. of my rows of
+ *      	   B : an MPI_Type_vector of cols blocks, m apart. So the blocks go
+ *      	   from work straight to where they end up, MPI_Alltoall when p
+ *      	   divides m and n, MPI_Alltoallw ( one type per process ) otherwise.
+ *      	3. The last reorder, putting the pieces into the rows of B, is the
+ *      	   receive datatype, so nothing is left to do by hand.
+ *
+ *      	When m == n and p divides n, block q of my rows of A is square and
+ *      	ends up as block ( my rank ) of q's rows of B, so every block is
+ *      	transposed where it is and MPI_Alltoall swaps them with MPI_IN_PLACE.
+ *      	Then no work array is needed at all.
+ *
+ *      NOTES:
+ *      	1. The byte displacements of MPI_Alltoallw are ints, so my rows of
+ *      	   A and of B have to stay below 2 GB.
+ *      	2. Splitting the longer side keeps the blocks square, so the one that
+ *      	   is read by columns uses whole cache lines while it is in cache.
+ */
+#include <stdlib.h>
+#include <string.h>
+#include "dist_transpose.h"
+
+/*
+ * First index and length of block number block of n split into no_of_blocks.
+ * The first n % no_of_blocks blocks get one more.
+ */
+static void Block_range(int n,	/* in */
+			int no_of_blocks,	/* in */
+			int block,			/* in */
+			int *first_ptr,		/* out */
+			int *count_ptr		/* out */
+			)
+{
+	int quotient = n / no_of_blocks;
+	int remainder = n % no_of_blocks;
+
+	*count_ptr = quotient + (block < remainder ? 1 : 0);
+	*first_ptr = block * quotient + (block < remainder ? block : remainder);
+}
+
+/********************************************************************/
+/* Function Transpose_plan_create
+ * Algorithm:
+ *     1.  Split the rows of A and of B.
+ *     2.  Allocate the arguments of MPI_Alltoallw and the work array;
+ *         if any process fails, all free what they got.
+ *     3.  What goes to q is cols_q rows of work, contiguous; what comes
+ *         from q is a vector of cols blocks of rows_q floats, m apart,
+ *         starting at column first_rows[q].
+ *     4.  If the blocks are all the same, one type of them, resized so
+ *         block q starts q blocks in, for MPI_Alltoall.
+ ********************************************************************/
+TRANSPOSE_PLAN_T *Transpose_plan_create(int m,	/* in */
+			int n,								/* in */
+			MPI_Comm comm						/* in */
+			)
+{
+	TRANSPOSE_PLAN_T *plan;
+	int my_rank;
+	int p;
+	int ok, q, first, count;
+	MPI_Datatype vector_mpi_t;
+
+	MPI_Comm_size(comm, &p);
+	MPI_Comm_rank(comm, &my_rank);
+
+	plan = calloc(1, sizeof(TRANSPOSE_PLAN_T));
+	ok = (plan != NULL);
+	if( ok )
+	{
+		plan->m = m;
+		plan->n = n;
+		plan->comm = comm;
+		plan->block_mpi_t = MPI_DATATYPE_NULL;
+		plan->in_place = (m == n && n % p == 0);
+		plan->equal_blocks = (m % p == 0 && n % p == 0);
+		plan->first_rows = malloc((p + 1) * sizeof(int));
+		plan->first_cols = malloc((p + 1) * sizeof(int));
+		ok = (plan->first_rows != NULL && plan->first_cols != NULL);
+	}
+
+	/* 1. */
+	if( ok )
+	{
+		for( q = 0 ; q < p ; q++ )
+		{
+			Block_range(m, p, q, &plan->first_rows[q], &count);
+			Block_range(n, p, q, &plan->first_cols[q], &count);
+		}
+		plan->first_rows[p] = m;
+		plan->first_cols[p] = n;
+		plan->first_row = plan->first_rows[my_rank];
+		plan->rows = plan->first_rows[my_rank + 1] - plan->first_row;
+		plan->first_col = plan->first_cols[my_rank];
+		plan->cols = plan->first_cols[my_rank + 1] - plan->first_col;
+
+		/* 2. */
+		plan->send_counts = malloc(p * sizeof(int));
+		plan->send_displacements = malloc(p * sizeof(int));
+		plan->send_types = malloc(p * sizeof(MPI_Datatype));
+		plan->recv_counts = malloc(p * sizeof(int));
+		plan->recv_displacements = malloc(p * sizeof(int));
+		plan->recv_types = malloc(p * sizeof(MPI_Datatype));
+		if( plan->recv_types != NULL )
+		{
+			/* So Transpose_plan_free has nothing to free if a process fails */
+			for( q = 0 ; q < p ; q++ )
+			{
+				plan->recv_types[q] = MPI_DATATYPE_NULL;
+			}
+		}
+		ok = (plan->send_counts != NULL && plan->send_displacements != NULL && plan->send_types != NULL
+				&& plan->recv_counts != NULL && plan->recv_displacements != NULL && plan->recv_types != NULL);
+		if( ok && !plan->in_place )
+		{
+			plan->work = malloc(((size_t) plan->rows * n + 1) * sizeof(float));
+			ok = (plan->work != NULL);
+		}
+	}
+
+	MPI_Allreduce(MPI_IN_PLACE, &ok, 1, MPI_INT, MPI_MIN, comm);
+	if( !ok )
+	{
+		Transpose_plan_free(&plan);
+		return NULL;
+	}
+
+	/* 3. */
+	for( q = 0 ; q < p ; q++ )
+	{
+		first = plan->first_cols[q];
+		count = plan->first_cols[q + 1] - first;
+		plan->send_counts[q] = count * plan->rows;
+		plan->send_displacements[q] = (int) ((size_t) first * plan->rows * sizeof(float));
+		plan->send_types[q] = MPI_FLOAT;
+
+		first = plan->first_rows[q];
+		count = plan->first_rows[q + 1] - first;
+		plan->recv_displacements[q] = (int) (first * sizeof(float));
+		if( count > 0 && plan->cols > 0 )
+		{
+			MPI_Type_vector(plan->cols, count, m, MPI_FLOAT, &plan->recv_types[q]);
+			MPI_Type_commit(&plan->recv_types[q]);
+			plan->recv_counts[q] = 1;
+		}
+		else
+		{
+			plan->recv_types[q] = MPI_FLOAT;
+			plan->recv_counts[q] = 0;
+		}
+	}
+
+	/* 4. */
+	if( plan->equal_blocks )
+	{
+		MPI_Type_vector(plan->cols, m / p, m, MPI_FLOAT, &vector_mpi_t);
+		MPI_Type_create_resized(vector_mpi_t, 0, (MPI_Aint) (m / p) * sizeof(float), &plan->block_mpi_t);
+		MPI_Type_commit(&plan->block_mpi_t);
+		MPI_Type_free(&vector_mpi_t);
+	}
+
+	return plan;
+}
+
+void Transpose_plan_free(TRANSPOSE_PLAN_T **plan	/* in/out */)
+{
+	int p, q;
+
+	if( *plan == NULL )
+	{
+		return;
+	}
+	if( (*plan)->recv_types != NULL )
+	{
+		MPI_Comm_size((*plan)->comm, &p);
+		for( q = 0 ; q < p ; q++ )
+		{
+			if( (*plan)->recv_types[q] != MPI_FLOAT && (*plan)->recv_types[q] != MPI_DATATYPE_NULL )
+			{
+				MPI_Type_free(&(*plan)->recv_types[q]);
+			}
+		}
+	}
+	if( (*plan)->block_mpi_t != MPI_DATATYPE_NULL )
+	{
+		MPI_Type_free(&(*plan)->block_mpi_t);
+	}
+	free((*plan)->first_rows);
+	free((*plan)->first_cols);
+	free((*plan)->send_counts);
+	free((*plan)->send_displacements);
+	free((*plan)->send_types);
+	free((*plan)->recv_counts);
+	free((*plan)->recv_displacements);
+	free((*plan)->recv_types);
+	free((*plan)->work);
+	free(*plan);
+	*plan = NULL;
+}
+
+size_t Transpose_local_size(const TRANSPOSE_PLAN_T *plan	/* in */)
+{
+	size_t a_size = (size_t) plan->rows * plan->n;
+	size_t b_size = (size_t) plan->cols * plan->m;
+
+	return (a_size > b_size) ? a_size : b_size;
+}
+
+/********************************************************************/
+/* Function Dist_transpose
+ * Algorithm:
+ *     If plan->in_place :
+ *     1.  Transpose each n/p x n/p block of my rows, from local_a into
+ *         the same place in local_b.
+ *     2.  MPI_Alltoall in place on local_b, one block per process.
+ *     Otherwise :
+ *     1.  work = my rows of A transposed.
+ *     2.  MPI_Alltoall or MPI_Alltoallw from work into local_b, the
+ *         receive types putting every piece in its place.
+ ********************************************************************/
+void Dist_transpose(TRANSPOSE_PLAN_T *plan,	/* in/out */
+			const float local_a[],			/* in */
+			float local_b[]					/* out */
+			)
+{
+	int p;
+	int n = plan->n;
+	int block, q;
+
+	MPI_Comm_size(plan->comm, &p);
+
+	if( plan->in_place )
+	{
+		/* 1. */
+		block = n / p;
+		for( q = 0 ; q < p ; q++ )
+		{
+			if( local_a == local_b )
+			{
+				Transpose_square_in_place(&local_b[q * block], n, block);
+			}
+			else
+			{
+				Transpose_local(&local_a[q * block], n, &local_b[q * block], n, block, block);
+			}
+		}
+
+		/* 2. */
+		MPI_Alltoall(MPI_IN_PLACE, 0, MPI_DATATYPE_NULL, local_b, 1, plan->block_mpi_t, plan->comm);
+		return;
+	}
+
+	/* 1. */
+	Transpose_local(local_a, n, plan->work, plan->rows, plan->rows, n);
+
+	/* 2. */
+	if( plan->equal_blocks )
+	{
+		MPI_Alltoall(plan->work, (n / p) * plan->rows, MPI_FLOAT, local_b, 1, plan->block_mpi_t, plan->comm);
+	}
+	else
+	{
+		MPI_Alltoallw(plan->work, plan->send_counts, plan->send_displacements, plan->send_types, local_b,
+				plan->recv_counts, plan->recv_displacements, plan->recv_types, plan->comm);
+	}
+}
+
+/********************************************************************/
+/* Function Transpose_local
+ * Algorithm:
+ *     1.  If both sides are at most TRANSPOSE_LEAF, transpose directly.
+ *     2.  Otherwise split the longer side in two and transpose each
+ *         half into its place in b.
+ ********************************************************************/
+void Transpose_local(const float a[],	/* in */
+			int lda,					/* in */
+			float b[],					/* out */
+			int ldb,					/* in */
+			int rows,					/* in */
+			int cols					/* in */
+			)
+{
+	int half, i, j;
+
+	/* 1. */
+	if( rows <= TRANSPOSE_LEAF && cols <= TRANSPOSE_LEAF )
+	{
+		for( i = 0 ; i < rows ; i++ )
+		{
+			for( j = 0 ; j < cols ; j++ )
+			{
+				b[(size_t) j * ldb + i] = a[(size_t) i * lda + j];
+			}
+		}
+	}
+
+	/* 2. */
+	else if( rows >= cols )
+	{
+		half = rows / 2;
+		Transpose_local(a, lda, b, ldb, half, cols);
+		Transpose_local(&a[(size_t) half * lda], lda, &b[half], ldb, rows - half, cols);
+	}
+	else
+	{
+		half = cols / 2;
+		Transpose_local(a, lda, b, ldb, rows, half);
+		Transpose_local(&a[half], lda, &b[(size_t) half * ldb], ldb, rows, cols - half);
+	}
+}
+
+/*
+ * Swap the rows x cols block a with the transpose of the cols x rows
+ * block b, splitting like Transpose_local
+ */
+static void Swap_transposed(float a[],	/* in/out */
+			float b[],					/* in/out */
+			int ld,						/* in */
+			int rows,					/* in */
+			int cols					/* in */
+			)
+{
+	float temp;
+	int half, i, j;
+
+	if( rows <= TRANSPOSE_LEAF && cols <= TRANSPOSE_LEAF )
+	{
+		for( i = 0 ; i < rows ; i++ )
+		{
+			for( j = 0 ; j < cols ; j++ )
+			{
+				temp = a[(size_t) i * ld + j];
+				a[(size_t) i * ld + j] = b[(size_t) j * ld + i];
+				b[(size_t) j * ld + i] = temp;
+			}
+		}
+	}
+	else if( rows >= cols )
+	{
+		half = rows / 2;
+		Swap_transposed(a, b, ld, half, cols);
+		Swap_transposed(&a[(size_t) half * ld], &b[half], ld, rows - half, cols);
+	}
+	else
+	{
+		half = cols / 2;
+		Swap_transposed(a, b, ld, rows, half);
+		Swap_transposed(&a[half], &b[(size_t) half * ld], ld, rows, cols - half);
+	}
+}
+
+/********************************************************************/
+/* Function Transpose_square_in_place
+ * Algorithm:
+ *     1.  Small enough : swap every entry above the diagonal with the
+ *         one below.
+ *     2.  Otherwise transpose the two diagonal blocks in place and swap
+ *         the upper right block with the transpose of the lower left.
+ ********************************************************************/
+void Transpose_square_in_place(float a[],	/* in/out */
+			int ld,							/* in */
+			int order						/* in */
+			)
+{
+	float temp;
+	int half, i, j;
+
+	/* 1. */
+	if( order <= TRANSPOSE_LEAF )
+	{
+		for( i = 0 ; i < order ; i++ )
+		{
+			for( j = i + 1 ; j < order ; j++ )
+			{
+				temp = a[(size_t) i * ld + j];
+				a[(size_t) i * ld + j] = a[(size_t) j * ld + i];
+				a[(size_t) j * ld + i] = temp;
+			}
+		}
+		return;
+	}
+
+	/* 2. */
+	half = order / 2;
+	Transpose_square_in_place(a, ld, half);
+	Transpose_square_in_place(&a[(size_t) half * ld + half], ld, order - half);
+	Swap_transposed(&a[half], &a[(size_t) half * ld], ld, half, order - half);
+}
@@ -0,0 +1,96 @@
+/*
+ * dist_transpose.h
+ *
+ *  Created on: 16-Oct-2026
+ *      Author: prateek
+ *      Desc : Header for dist_transpose.c -- B = A^T for an m x n float
+ *      	matrix A distributed by block rows, B coming out distributed by block
+ *      	rows too, with one all-to-all and no packing by hand.
+ */
+#ifndef DIST_TRANSPOSE_H
+#define DIST_TRANSPOSE_H
+
+#include <mpi/mpi.h>
+
+/* Side of the blocks the local transposes stop splitting at : two 32 x 32
+ * float blocks, 8 KB, sit in the L1 cache together */
+#define TRANSPOSE_LEAF		32
+
+/* Everything a transpose of one shape needs, worked out once. Rows are
+ * split with the remainder going to the first processes : process q has
+ * rows first_rows[q] .. first_rows[q+1] - 1 of A and first_cols[q] ..
+ * first_cols[q+1] - 1 of B. My rows of A and of B are row-major, n and
+ * m floats long */
+typedef struct {
+	int m;
+	int n;
+	int first_row;				/* My rows of A                         */
+	int rows;
+	int first_col;				/* My rows of B, columns of A           */
+	int cols;
+	int *first_rows;			/* p + 1 entries                        */
+	int *first_cols;			/* p + 1 entries                        */
+	int in_place;				/* 1 if m == n and p divides n          */
+	int equal_blocks;			/* 1 if p divides both m and n          */
+	int *send_counts;			/* MPI_Alltoallw arguments, bytes for   */
+	int *send_displacements;	/* the displacements                    */
+	MPI_Datatype *send_types;
+	int *recv_counts;
+	int *recv_displacements;
+	MPI_Datatype *recv_types;
+	MPI_Datatype block_mpi_t;	/* Block of B from one process, if      */
+								/* equal_blocks                         */
+	float *work;				/* My rows of A transposed, n x rows,   */
+								/* unless in_place                      */
+	MPI_Comm comm;
+} TRANSPOSE_PLAN_T;
+
+/* Plan for an m x n A over comm. Collective over comm. Returns NULL on
+ * every process if memory ran out on any */
+TRANSPOSE_PLAN_T *Transpose_plan_create(
+		int m,						/* in */
+		int n,						/* in */
+		MPI_Comm comm				/* in */
+		);
+
+void Transpose_plan_free(
+		TRANSPOSE_PLAN_T **plan		/* in/out */
+		);
+
+/* Floats local_b must hold : my rows of B, or for local_b == local_a
+ * the larger of my rows of A and of B */
+size_t Transpose_local_size(
+		const TRANSPOSE_PLAN_T *plan	/* in */
+		);
+
+/* local_b = my rows of A^T. local_b may be local_a; then local_a is
+ * overwritten and must hold Transpose_local_size floats. If
+ * plan->in_place no memory besides local_b is used. Collective over
+ * plan->comm */
+void Dist_transpose(
+		TRANSPOSE_PLAN_T *plan,		/* in/out */
+		const float local_a[],		/* in */
+		float local_b[]				/* out */
+		);
+
+/* b = a^T for a rows x cols block a, lda floats from one row of a to the
+ * next and ldb for b. Splits the longer side in two until the blocks are
+ * TRANSPOSE_LEAF wide, so it fits every level of cache without knowing
+ * their sizes */
+void Transpose_local(
+		const float a[],			/* in */
+		int lda,					/* in */
+		float b[],					/* out */
+		int ldb,					/* in */
+		int rows,					/* in */
+		int cols					/* in */
+		);
+
+/* a = a^T for an order x order block, ld floats from row to row */
+void Transpose_square_in_place(
+		float a[],					/* in/out */
+		int ld,						/* in */
+		int order					/* in */
+		);
+
+#endif /* DIST_TRANSPOSE_H */
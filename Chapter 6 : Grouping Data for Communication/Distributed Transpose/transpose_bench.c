@@ -0,0 +1,299 @@
+/*
+ * transpose_bench.c
+ *
+ *  Created on: 16-Oct-2026
+ *      Author: prateek
+ *      Desc : Distributed transposes of square and rectangular matrices :
+ *      	datatypes only, the way of chap06/send_col_to_row.c ( every float of A
+ *      	sent as a column and received as a row ), against Dist_transpose out
+ *      	of place and in place.
+ *      Input :
+ *      	n : size of the matrices
+ *      Output :
+ *      	For n x n, 4n x n/4, n/4 x 4n and (n+1) x (n+1) : the GB/s per
+ *      	process of each way ( bytes of A over p, over the time of the slowest
+ *      	process ), the floats Dist_transpose used besides A and B, and whether
+ *      	every B was right.
+ *
+ *      NOTES:
+ *      	1. A(i,j) = (7i + 3j) % 1009, exact in float and checked with ==.
+ *      	2. Each run starts from a fresh copy of A, outside the timing, since
+ *      	   in place overwrites it.
+ *      	3. (n+1) x (n+1) is there so that p does not divide it, which takes
+ *      	   MPI_Alltoallw.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <mpi/mpi.h>
+#include "dist_transpose.h"
+
+#define REPS			10
+#define NO_OF_SHAPES	4
+#define NO_OF_WAYS		3
+
+void Get_data(int *n_ptr, int my_rank);
+float A_entry(int i, int j);
+void Fill_a(const TRANSPOSE_PLAN_T *plan, float local_a[]);
+int Check_b(const TRANSPOSE_PLAN_T *plan, const float local_b[]);
+void Datatype_transpose(const TRANSPOSE_PLAN_T *plan, const float local_a[], float local_b[]);
+double Max_time(double start);
+
+int main(int argc, char **argv)
+{
+	int my_rank;
+	int p;
+	int n;
+	int shapes[NO_OF_SHAPES][2];
+	const char *way_names[NO_OF_WAYS] = { "datatypes only", "out of place", "in place" };
+	TRANSPOSE_PLAN_T *plan;
+	float *fresh_a, *local_a, *local_b;
+	size_t size;
+	double start, seconds, bytes;
+	long long extra;
+	int ok, all_ok;
+	int shape, way, rep;
+
+	MPI_Init(&argc, &argv);
+	MPI_Comm_size(MPI_COMM_WORLD, &p);
+	MPI_Comm_rank(MPI_COMM_WORLD, &my_rank);
+
+	Get_data(&n, my_rank);
+	shapes[0][0] = n;			shapes[0][1] = n;
+	shapes[1][0] = 4 * n;		shapes[1][1] = n / 4;
+	shapes[2][0] = n / 4;		shapes[2][1] = 4 * n;
+	shapes[3][0] = n + 1;		shapes[3][1] = n + 1;
+
+	if( my_rank == 0 )
+	{
+		printf("p = %d , GB/s per process \n", p);
+		printf("%-14s %14s %14s %14s %14s  extra floats \n", "m x n", way_names[0], way_names[1], way_names[2],
+				"path");
+	}
+
+	for( shape = 0 ; shape < NO_OF_SHAPES ; shape++ )
+	{
+		plan = Transpose_plan_create(shapes[shape][0], shapes[shape][1], MPI_COMM_WORLD);
+		if( plan == NULL )
+		{
+			if( my_rank == 0 )
+			{
+				fprintf(stderr, "Cannot allocate the plan for %d x %d \n", shapes[shape][0], shapes[shape][1]);
+			}
+			MPI_Abort(MPI_COMM_WORLD, 1);
+		}
+		size = Transpose_local_size(plan);
+		fresh_a = malloc((size + 1) * sizeof(float));
+		local_a = malloc((size + 1) * sizeof(float));
+		local_b = malloc((size + 1) * sizeof(float));
+		if( fresh_a == NULL || local_a == NULL || local_b == NULL )
+		{
+			fprintf(stderr, "Process %d cannot allocate the matrices \n", my_rank);
+			MPI_Abort(MPI_COMM_WORLD, 1);
+		}
+		Fill_a(plan, fresh_a);
+		bytes = (double) plan->m * plan->n * sizeof(float) / p;
+		extra = plan->in_place ? 0 : (long long) plan->rows * plan->n;
+		MPI_Allreduce(MPI_IN_PLACE, &extra, 1, MPI_LONG_LONG, MPI_MAX, MPI_COMM_WORLD);
+
+		all_ok = 1;
+		if( my_rank == 0 )
+		{
+			printf("%6d x %-6d ", plan->m, plan->n);
+		}
+		for( way = 0 ; way < NO_OF_WAYS ; way++ )
+		{
+			seconds = 0.0;
+			for( rep = 0 ; rep < REPS ; rep++ )
+			{
+				memcpy(local_a, fresh_a, size * sizeof(float));
+				MPI_Barrier(MPI_COMM_WORLD);
+				start = MPI_Wtime();
+				if( way == 0 )
+				{
+					Datatype_transpose(plan, local_a, local_b);
+				}
+				else if( way == 1 )
+				{
+					Dist_transpose(plan, local_a, local_b);
+				}
+				else
+				{
+					Dist_transpose(plan, local_a, local_a);
+				}
+				seconds += Max_time(start);
+			}
+			ok = Check_b(plan, (way == 2) ? local_a : local_b);
+			MPI_Allreduce(MPI_IN_PLACE, &ok, 1, MPI_INT, MPI_MIN, MPI_COMM_WORLD);
+			all_ok &= ok;
+			if( my_rank == 0 )
+			{
+				printf(" %14.3f", bytes / (seconds / REPS) / 1.0e9);
+			}
+		}
+		if( my_rank == 0 )
+		{
+			printf(" %14s  %lld , B %s \n", plan->in_place ? "in place" : (plan->equal_blocks ? "Alltoall" :
+					"Alltoallw"), extra, all_ok ? "right" : "WRONG");
+		}
+
+		free(fresh_a);
+		free(local_a);
+		free(local_b);
+		Transpose_plan_free(&plan);
+	}
+
+	MPI_Finalize();
+
+	return 0;
+}
+
+/*
+ * Process 0 reads the size and broadcasts it
+ */
+void Get_data(int *n_ptr,	/* out */
+			int my_rank		/* in */
+			)
+{
+	if( my_rank == 0 )
+	{
+		printf("Enter the size of the matrices\n");
+		scanf("%d", n_ptr);
+	}
+
+	MPI_Bcast(n_ptr, 1, MPI_INT, 0, MPI_COMM_WORLD);
+}
+
+/*
+ * Entry of NOTES 1
+ */
+float A_entry(int i,	/* in */
+			int j		/* in */
+			)
+{
+	return (float) ((7 * (long long) i + 3 * (long long) j) % 1009);
+}
+
+/*
+ * My rows of A
+ */
+void Fill_a(const TRANSPOSE_PLAN_T *plan,	/* in */
+			float local_a[]					/* out */
+			)
+{
+	int i, j;
+
+	for( i = 0 ; i < plan->rows ; i++ )
+	{
+		for( j = 0 ; j < plan->n ; j++ )
+		{
+			local_a[(size_t) i * plan->n + j] = A_entry(plan->first_row + i, j);
+		}
+	}
+}
+
+/*
+ * 1 if my rows of B are my columns of A
+ */
+int Check_b(const TRANSPOSE_PLAN_T *plan,	/* in */
+			const float local_b[]			/* in */
+			)
+{
+	int ok = 1;
+	int i, j;
+
+	for( j = 0 ; j < plan->cols ; j++ )
+	{
+		for( i = 0 ; i < plan->m ; i++ )
+		{
+			ok &= (local_b[(size_t) j * plan->m + i] == A_entry(i, plan->first_col + j));
+		}
+	}
+	return ok;
+}
+
+/********************************************************************/
+/* Function Datatype_transpose
+ * chap06/send_col_to_row.c for the whole matrix, with no local
+ * transposes : to q go my rows of its columns, a vector of rows blocks
+ * of cols_q floats; from q come its rows of my columns, each float of
+ * them going down a column of my rows of B, so the receive type is
+ * rows_q of those columns, one float apart.
+ ********************************************************************/
+void Datatype_transpose(const TRANSPOSE_PLAN_T *plan,	/* in */
+			const float local_a[],						/* in */
+			float local_b[]								/* out */
+			)
+{
+	int p;
+	int *send_counts, *send_displacements, *recv_counts, *recv_displacements;
+	MPI_Datatype *send_types, *recv_types;
+	MPI_Datatype column_mpi_t;
+	int cols_q, rows_q, q;
+
+	MPI_Comm_size(plan->comm, &p);
+	send_counts = malloc(p * sizeof(int));
+	send_displacements = malloc(p * sizeof(int));
+	send_types = malloc(p * sizeof(MPI_Datatype));
+	recv_counts = malloc(p * sizeof(int));
+	recv_displacements = malloc(p * sizeof(int));
+	recv_types = malloc(p * sizeof(MPI_Datatype));
+
+	for( q = 0 ; q < p ; q++ )
+	{
+		cols_q = plan->first_cols[q + 1] - plan->first_cols[q];
+		rows_q = plan->first_rows[q + 1] - plan->first_rows[q];
+
+		send_counts[q] = (plan->rows > 0 && cols_q > 0) ? 1 : 0;
+		send_displacements[q] = (int) (plan->first_cols[q] * sizeof(float));
+		send_types[q] = MPI_FLOAT;
+		if( send_counts[q] )
+		{
+			MPI_Type_vector(plan->rows, cols_q, plan->n, MPI_FLOAT, &send_types[q]);
+			MPI_Type_commit(&send_types[q]);
+		}
+
+		recv_counts[q] = (rows_q > 0 && plan->cols > 0) ? 1 : 0;
+		recv_displacements[q] = (int) (plan->first_rows[q] * sizeof(float));
+		recv_types[q] = MPI_FLOAT;
+		if( recv_counts[q] )
+		{
+			MPI_Type_vector(plan->cols, 1, plan->m, MPI_FLOAT, &column_mpi_t);
+			MPI_Type_create_hvector(rows_q, 1, sizeof(float), column_mpi_t, &recv_types[q]);
+			MPI_Type_commit(&recv_types[q]);
+			MPI_Type_free(&column_mpi_t);
+		}
+	}
+
+	MPI_Alltoallw(local_a, send_counts, send_displacements, send_types, local_b, recv_counts,
+			recv_displacements, recv_types, plan->comm);
+
+	for( q = 0 ; q < p ; q++ )
+	{
+		if( send_counts[q] )
+		{
+			MPI_Type_free(&send_types[q]);
+		}
+		if( recv_counts[q] )
+		{
+			MPI_Type_free(&recv_types[q]);
+		}
+	}
+	free(send_counts);
+	free(send_displacements);
+	free(send_types);
+	free(recv_counts);
+	free(recv_displacements);
+	free(recv_types);
+}
+
+/*
+ * Time since start on the slowest process, on every process
+ */
+double Max_time(double start	/* in */)
+{
+	double elapsed = MPI_Wtime() - start;
+
+	MPI_Allreduce(MPI_IN_PLACE, &elapsed, 1, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+	return elapsed;
+}
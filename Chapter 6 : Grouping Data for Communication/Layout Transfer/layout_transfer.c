@@ -0,0 +1,600 @@
+/*
+ * layout_transfer.c
+ *
+ *  Created on: 16-Oct-2026
+ *      Author: prateek
+ *      Desc : Three ways to send a layout that is not contiguous, one per example
+ *      	of chapter 6 :
+ *      		TRANSFER_DATATYPE : MPI_Type_vector or MPI_Type_indexed over the
+ *      		                    layout, taken from a datatype cache
+ *      		TRANSFER_PACK     : MPI_Pack of every block into a buffer, sent as
+ *      		                    MPI_PACKED, MPI_Unpack at the other end
+ *      		TRANSFER_COPY     : a loop copying the blocks into a contiguous
+ *      		                    buffer, sent as base, copied out at the other end
+ *      	The packed and copied forms carry the same elements of base in the same
+ *      	order as the datatype, so they all match each other.
+ *
+ *      	Which is fastest depends on the size of the layout, on how long its blocks
+ *      	are and on the MPI. Layout_transfer_calibrate times all three between
+ *      	processes 0 and 1 for sizes of 2^LAYOUT_MIN_LOG_BYTES .. 2^LAYOUT_MAX_LOG_BYTES
+ *      	bytes and blocks of 1, 8, 64 and 512 floats, and Layout_send and
+ *      	Layout_recv then look up the method for the nearest size and block length.
+ *
+ *      NOTES:
+ *      	1. The packed and copied layouts go through one buffer, kept between
+ *      	   calls and grown when a larger layout comes, so a transfer does not
+ *      	   call malloc. Sends are blocking, so the buffer is free again when
+ *      	   Layout_send returns.
+ *      	2. As in param_bcast.c, the times are taken on process 0 and broadcast,
+ *      	   so every process has the same table, and the table is cached with
+ *      	   the communicator it was measured on.
+ */
+#include <stdlib.h>
+#include <string.h>
+#include "layout_transfer.h"
+#include "type_cache.h"
+
+#define NO_OF_SIZES			(LAYOUT_MAX_LOG_BYTES - LAYOUT_MIN_LOG_BYTES + 1)
+#define NO_OF_BLOCK_CLASSES	4
+#define CALIBRATE_TRIALS	3
+#define CALIBRATE_BYTES		(1 << 20)	/* Bytes moved per trial, at least 2 round trips */
+
+const char *transfer_method_names[NO_OF_TRANSFER_METHODS] = {
+	"datatype", "pack", "copy"
+};
+
+/* Block lengths ( floats ) the calibration uses */
+static const int class_block_lengths[NO_OF_BLOCK_CLASSES] = { 1, 8, 64, 512 };
+
+/* fastest[s][c] is the fastest method for 2^(LAYOUT_MIN_LOG_BYTES + s)
+ * bytes in blocks of class c. Each calibrated communicator keeps its own
+ * table under layout_key, as in param_bcast.c : it was measured between
+ * two of its processes, and says nothing about other communicators */
+typedef struct {
+	TRANSFER_METHOD_T fastest[NO_OF_SIZES][NO_OF_BLOCK_CLASSES];
+} CHOICE_TABLE_T;
+
+static int layout_key = MPI_KEYVAL_INVALID;
+
+static TYPE_CACHE_T *type_cache = NULL;
+static char *pool = NULL;			/* Contiguous buffer for pack and copy */
+static size_t pool_bytes = 0;
+
+/*
+ * The contiguous buffer, at least bytes long. NULL if it cannot grow
+ */
+static char *Pool_buffer(size_t bytes	/* in */)
+{
+	char *grown;
+
+	if( bytes > pool_bytes )
+	{
+		grown = realloc(pool, bytes);
+		if( grown == NULL )
+		{
+			return NULL;
+		}
+		pool = grown;
+		pool_bytes = bytes;
+	}
+	return pool;
+}
+
+/*
+ * The datatype over the layout, from the cache, or built on its own if
+ * there is no memory for a cache
+ */
+static MPI_Datatype Layout_type(const LAYOUT_T *layout	/* in */)
+{
+	MPI_Datatype layout_mpi_t;
+
+	if( type_cache == NULL )
+	{
+		type_cache = Type_cache_create(TYPE_CACHE_DEFAULT_SIZE);
+	}
+	if( type_cache == NULL )
+	{
+		MPI_Type_indexed(layout->count, layout->block_lengths, layout->displacements, layout->base,
+				&layout_mpi_t);
+		MPI_Type_commit(&layout_mpi_t);
+		return layout_mpi_t;
+	}
+	if( layout->regular )
+	{
+		return Type_cache_vector(type_cache, layout->count, layout->block_lengths[0], layout->stride,
+				layout->base);
+	}
+	return Type_cache_indexed(type_cache, layout->count, layout->block_lengths, layout->displacements,
+			layout->base);
+}
+
+/*
+ * Give back a type from Layout_type
+ */
+static void Layout_type_release(MPI_Datatype layout_mpi_t	/* in */)
+{
+	if( type_cache == NULL )
+	{
+		MPI_Type_free(&layout_mpi_t);
+	}
+	else
+	{
+		Type_cache_release(type_cache, layout_mpi_t);
+	}
+}
+
+/********************************************************************/
+/* Function Gather_blocks
+ * Copy the blocks of buffer one after the other into contiguous.
+ * Blocks of one float or double are copied with a fixed size, which
+ * the compiler makes a single load and store instead of a call.
+ ********************************************************************/
+static void Gather_blocks(const char *buffer,	/* in */
+			const LAYOUT_T *layout,			/* in */
+			char *contiguous				/* out */
+			)
+{
+	size_t size = layout->element_size;
+	size_t bytes;
+	int b;
+
+	for( b = 0 ; b < layout->count ; b++ )
+	{
+		bytes = layout->block_lengths[b] * size;
+		if( bytes == sizeof(float) )
+		{
+			memcpy(contiguous, &buffer[layout->displacements[b] * size], sizeof(float));
+		}
+		else if( bytes == sizeof(double) )
+		{
+			memcpy(contiguous, &buffer[layout->displacements[b] * size], sizeof(double));
+		}
+		else
+		{
+			memcpy(contiguous, &buffer[layout->displacements[b] * size], bytes);
+		}
+		contiguous += bytes;
+	}
+}
+
+/*
+ * The opposite of Gather_blocks
+ */
+static void Scatter_blocks(const char *contiguous,	/* in */
+			const LAYOUT_T *layout,				/* in */
+			char *buffer						/* out */
+			)
+{
+	size_t size = layout->element_size;
+	size_t bytes;
+	int b;
+
+	for( b = 0 ; b < layout->count ; b++ )
+	{
+		bytes = layout->block_lengths[b] * size;
+		if( bytes == sizeof(float) )
+		{
+			memcpy(&buffer[layout->displacements[b] * size], contiguous, sizeof(float));
+		}
+		else if( bytes == sizeof(double) )
+		{
+			memcpy(&buffer[layout->displacements[b] * size], contiguous, sizeof(double));
+		}
+		else
+		{
+			memcpy(&buffer[layout->displacements[b] * size], contiguous, bytes);
+		}
+		contiguous += bytes;
+	}
+}
+
+/*
+ * Delete function of layout_key : free the table with the communicator
+ */
+static int Free_table(MPI_Comm comm,	/* in */
+			int keyval,					/* in */
+			void *table,				/* in/out */
+			void *extra_state			/* in */
+			)
+{
+	(void) comm;
+	(void) keyval;
+	(void) extra_state;
+	free(table);
+	return MPI_SUCCESS;
+}
+
+/*
+ * Bytes the packed layout may need. MPI_Pack_size only bounds one
+ * MPI_Pack of that count, and the layout is packed block by block, so
+ * add up the bound of every block. The blocks of a regular layout are
+ * all the same length
+ */
+static int Pack_bytes(const LAYOUT_T *layout,	/* in */
+			MPI_Comm comm					/* in */
+			)
+{
+	int total = 0;
+	int block_bytes;
+	int b;
+
+	if( layout->regular )
+	{
+		MPI_Pack_size(layout->count > 0 ? layout->block_lengths[0] : 0, layout->base, comm, &block_bytes);
+		return layout->count * block_bytes;
+	}
+	for( b = 0 ; b < layout->count ; b++ )
+	{
+		MPI_Pack_size(layout->block_lengths[b], layout->base, comm, &block_bytes);
+		total += block_bytes;
+	}
+	return total;
+}
+
+/*
+ * Allocate the block arrays and fill in what does not depend on them
+ */
+static int Layout_allocate(LAYOUT_T *layout,	/* out */
+			int count,						/* in */
+			MPI_Datatype base				/* in */
+			)
+{
+	layout->count = count;
+	layout->block_lengths = malloc((count + 1) * sizeof(int));
+	layout->displacements = malloc((count + 1) * sizeof(int));
+	layout->base = base;
+	MPI_Type_size(base, &layout->element_size);
+	if( layout->block_lengths == NULL || layout->displacements == NULL )
+	{
+		Layout_free(layout);
+		return 0;
+	}
+	return 1;
+}
+
+int Layout_vector(LAYOUT_T *layout,	/* out */
+			int count,				/* in */
+			int block_length,		/* in */
+			int stride,				/* in */
+			MPI_Datatype base		/* in */
+			)
+{
+	int b;
+
+	if( !Layout_allocate(layout, count, base) )
+	{
+		return 0;
+	}
+	for( b = 0 ; b < count ; b++ )
+	{
+		layout->block_lengths[b] = block_length;
+		layout->displacements[b] = b * stride;
+	}
+	layout->regular = 1;
+	layout->stride = stride;
+	layout->total = count * block_length;
+	return 1;
+}
+
+int Layout_indexed(LAYOUT_T *layout,		/* out */
+			int count,					/* in */
+			const int block_lengths[],	/* in */
+			const int displacements[],	/* in */
+			MPI_Datatype base			/* in */
+			)
+{
+	int b;
+
+	if( !Layout_allocate(layout, count, base) )
+	{
+		return 0;
+	}
+	memcpy(layout->block_lengths, block_lengths, count * sizeof(int));
+	memcpy(layout->displacements, displacements, count * sizeof(int));
+	layout->regular = 0;
+	layout->stride = 0;
+	layout->total = 0;
+	for( b = 0 ; b < count ; b++ )
+	{
+		layout->total += block_lengths[b];
+	}
+	return 1;
+}
+
+void Layout_free(LAYOUT_T *layout	/* in/out */)
+{
+	free(layout->block_lengths);
+	free(layout->displacements);
+	layout->block_lengths = NULL;
+	layout->displacements = NULL;
+	layout->count = layout->total = 0;
+}
+
+/********************************************************************/
+/* Function Layout_send_with
+ * If the contiguous buffer cannot grow, pack and copy fall back on
+ * the datatype, which sends the same elements.
+ ********************************************************************/
+void Layout_send_with(TRANSFER_METHOD_T method,	/* in */
+			const void *buffer,					/* in */
+			const LAYOUT_T *layout,				/* in */
+			int dest,							/* in */
+			int tag,							/* in */
+			MPI_Comm comm						/* in */
+			)
+{
+	MPI_Datatype layout_mpi_t;
+	char *contiguous = NULL;
+	int pack_bytes, position, b;
+
+	switch( method )
+	{
+	case TRANSFER_PACK:
+		pack_bytes = Pack_bytes(layout, comm);
+		contiguous = Pool_buffer(pack_bytes);
+		if( contiguous != NULL )
+		{
+			position = 0;
+			for( b = 0 ; b < layout->count ; b++ )
+			{
+				MPI_Pack((const char *) buffer + (size_t) layout->displacements[b] * layout->element_size,
+						layout->block_lengths[b], layout->base, contiguous, pack_bytes, &position, comm);
+			}
+			MPI_Send(contiguous, position, MPI_PACKED, dest, tag, comm);
+		}
+		break;
+	case TRANSFER_COPY:
+		contiguous = Pool_buffer((size_t) layout->total * layout->element_size);
+		if( contiguous != NULL )
+		{
+			Gather_blocks(buffer, layout, contiguous);
+			MPI_Send(contiguous, layout->total, layout->base, dest, tag, comm);
+		}
+		break;
+	default:
+		break;
+	}
+
+	if( contiguous == NULL )
+	{
+		layout_mpi_t = Layout_type(layout);
+		MPI_Send(buffer, 1, layout_mpi_t, dest, tag, comm);
+		Layout_type_release(layout_mpi_t);
+	}
+}
+
+void Layout_recv_with(TRANSFER_METHOD_T method,	/* in */
+			void *buffer,						/* out */
+			const LAYOUT_T *layout,				/* in */
+			int source,							/* in */
+			int tag,							/* in */
+			MPI_Comm comm						/* in */
+			)
+{
+	MPI_Datatype layout_mpi_t;
+	char *contiguous = NULL;
+	int pack_bytes, position, b;
+
+	switch( method )
+	{
+	case TRANSFER_PACK:
+		pack_bytes = Pack_bytes(layout, comm);
+		contiguous = Pool_buffer(pack_bytes);
+		if( contiguous != NULL )
+		{
+			MPI_Recv(contiguous, pack_bytes, MPI_PACKED, source, tag, comm, MPI_STATUS_IGNORE);
+			position = 0;
+			for( b = 0 ; b < layout->count ; b++ )
+			{
+				MPI_Unpack(contiguous, pack_bytes, &position,
+						(char *) buffer + (size_t) layout->displacements[b] * layout->element_size,
+						layout->block_lengths[b], layout->base, comm);
+			}
+		}
+		break;
+	case TRANSFER_COPY:
+		contiguous = Pool_buffer((size_t) layout->total * layout->element_size);
+		if( contiguous != NULL )
+		{
+			MPI_Recv(contiguous, layout->total, layout->base, source, tag, comm, MPI_STATUS_IGNORE);
+			Scatter_blocks(contiguous, layout, buffer);
+		}
+		break;
+	default:
+		break;
+	}
+
+	if( contiguous == NULL )
+	{
+		layout_mpi_t = Layout_type(layout);
+		MPI_Recv(buffer, 1, layout_mpi_t, source, tag, comm, MPI_STATUS_IGNORE);
+		Layout_type_release(layout_mpi_t);
+	}
+}
+
+/********************************************************************/
+/* Function Layout_transfer_time
+ * Process 0 sends the layout to process 1, which sends it back, as
+ * many times as it takes to move CALIBRATE_BYTES. The best trial is
+ * broadcast from process 0.
+ ********************************************************************/
+double Layout_transfer_time(TRANSFER_METHOD_T method,	/* in */
+			void *buffer,							/* in/out */
+			const LAYOUT_T *layout,					/* in */
+			MPI_Comm comm							/* in */
+			)
+{
+	int my_rank, p;
+	int bytes = layout->total * layout->element_size;
+	int reps = (CALIBRATE_BYTES / 2) / (bytes > 0 ? bytes : 1);
+	double start, elapsed;
+	double best = 0.0;
+	int trial, rep;
+
+	MPI_Comm_rank(comm, &my_rank);
+	MPI_Comm_size(comm, &p);
+	if( p < 2 )
+	{
+		return 0.0;
+	}
+	if( reps < 2 )
+	{
+		reps = 2;
+	}
+
+	for( trial = 0 ; trial < CALIBRATE_TRIALS ; trial++ )
+	{
+		MPI_Barrier(comm);
+		start = MPI_Wtime();
+		for( rep = 0 ; rep < reps ; rep++ )
+		{
+			if( my_rank == 0 )
+			{
+				Layout_send_with(method, buffer, layout, 1, LAYOUT_TAG, comm);
+				Layout_recv_with(method, buffer, layout, 1, LAYOUT_TAG, comm);
+			}
+			else if( my_rank == 1 )
+			{
+				Layout_recv_with(method, buffer, layout, 0, LAYOUT_TAG, comm);
+				Layout_send_with(method, buffer, layout, 0, LAYOUT_TAG, comm);
+			}
+		}
+		elapsed = (MPI_Wtime() - start) / (2 * reps);
+		if( trial == 0 || elapsed < best )
+		{
+			best = elapsed;
+		}
+	}
+
+	MPI_Bcast(&best, 1, MPI_DOUBLE, 0, comm);
+	return best;
+}
+
+/********************************************************************/
+/* Function Layout_transfer_calibrate
+ * For every size 2^(LAYOUT_MIN_LOG_BYTES + s) bytes and every block
+ * class c, a vector of blocks of class_block_lengths[c] floats ( or
+ * fewer, for small sizes ) with a gap as long as a block, timed with
+ * each method.
+ ********************************************************************/
+void Layout_transfer_calibrate(MPI_Comm comm	/* in */)
+{
+	CHOICE_TABLE_T *table;
+	LAYOUT_T layout;
+	float *buffer;
+	double seconds, best_seconds;
+	int elements, block_length;
+	int size, block_class, method;
+
+	if( layout_key == MPI_KEYVAL_INVALID )
+	{
+		MPI_Comm_create_keyval(MPI_COMM_NULL_COPY_FN, Free_table, &layout_key, NULL);
+	}
+	buffer = calloc((size_t) 2 << LAYOUT_MAX_LOG_BYTES, 1);
+	table = malloc(sizeof(CHOICE_TABLE_T));
+	if( buffer == NULL || table == NULL )
+	{
+		free(buffer);
+		free(table);
+		return;
+	}
+
+	for( size = 0 ; size < NO_OF_SIZES ; size++ )
+	{
+		elements = (1 << (LAYOUT_MIN_LOG_BYTES + size)) / sizeof(float);
+		for( block_class = 0 ; block_class < NO_OF_BLOCK_CLASSES ; block_class++ )
+		{
+			block_length = (class_block_lengths[block_class] < elements) ? class_block_lengths[block_class]
+					: elements;
+			if( !Layout_vector(&layout, elements / block_length, block_length, 2 * block_length, MPI_FLOAT) )
+			{
+				table->fastest[size][block_class] = TRANSFER_DATATYPE;
+				continue;
+			}
+
+			best_seconds = 0.0;
+			for( method = 0 ; method < NO_OF_TRANSFER_METHODS ; method++ )
+			{
+				seconds = Layout_transfer_time(method, buffer, &layout, comm);
+				if( method == 0 || seconds < best_seconds )
+				{
+					best_seconds = seconds;
+					table->fastest[size][block_class] = method;
+				}
+			}
+			Layout_free(&layout);
+		}
+	}
+	MPI_Comm_set_attr(comm, layout_key, table);
+
+	free(buffer);
+}
+
+/*
+ * The method measured on comm for the smallest calibrated size that
+ * holds the layout, and the block class nearest its mean block ( on a
+ * log scale )
+ */
+TRANSFER_METHOD_T Layout_transfer_choice(const LAYOUT_T *layout,	/* in */
+			MPI_Comm comm										/* in */
+			)
+{
+	CHOICE_TABLE_T *table;
+	int flag = 0;
+	double bytes = (double) layout->total * layout->element_size;
+	double block_bytes = (layout->count > 0) ? bytes / layout->count : bytes;
+	double class_bytes, next_class_bytes;
+	int size = 0, block_class = 0;
+
+	if( layout_key != MPI_KEYVAL_INVALID )
+	{
+		MPI_Comm_get_attr(comm, layout_key, &table, &flag);
+	}
+	if( !flag )
+	{
+		return TRANSFER_DATATYPE;
+	}
+	while( size < NO_OF_SIZES - 1 && (double) (1 << (LAYOUT_MIN_LOG_BYTES + size)) < bytes )
+	{
+		size++;
+	}
+	while( block_class < NO_OF_BLOCK_CLASSES - 1 )
+	{
+		class_bytes = class_block_lengths[block_class] * sizeof(float);
+		next_class_bytes = class_block_lengths[block_class + 1] * sizeof(float);
+		if( block_bytes * block_bytes <= class_bytes * next_class_bytes )
+		{
+			break;
+		}
+		block_class++;
+	}
+	return table->fastest[size][block_class];
+}
+
+void Layout_send(const void *buffer,	/* in */
+			const LAYOUT_T *layout,		/* in */
+			int dest,					/* in */
+			int tag,					/* in */
+			MPI_Comm comm				/* in */
+			)
+{
+	Layout_send_with(Layout_transfer_choice(layout, comm), buffer, layout, dest, tag, comm);
+}
+
+void Layout_recv(void *buffer,			/* out */
+			const LAYOUT_T *layout,		/* in */
+			int source,					/* in */
+			int tag,					/* in */
+			MPI_Comm comm				/* in */
+			)
+{
+	Layout_recv_with(Layout_transfer_choice(layout, comm), buffer, layout, source, tag, comm);
+}
+
+void Layout_transfer_finalize(void)
+{
+	Type_cache_free(&type_cache);
+	free(pool);
+	pool = NULL;
+	pool_bytes = 0;
+}
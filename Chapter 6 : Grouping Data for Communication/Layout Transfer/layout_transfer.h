@@ -0,0 +1,135 @@
+/*
+ * layout_transfer.h
+ *
+ *  Created on: 16-Oct-2026
+ *      Author: prateek
+ *      Desc : Header for layout_transfer.c -- sends and receives of a
+ *      	non-contiguous layout, by a derived datatype, by MPI_Pack or by copying
+ *      	it into a contiguous buffer, whichever was measured to be fastest.
+ */
+#ifndef LAYOUT_TRANSFER_H
+#define LAYOUT_TRANSFER_H
+
+#include <mpi/mpi.h>
+
+/* Tag of the calibration messages */
+#define LAYOUT_TAG			7701
+
+/* Smallest and largest layout (in bytes) the calibration covers */
+#define LAYOUT_MIN_LOG_BYTES	6
+#define LAYOUT_MAX_LOG_BYTES	22
+
+/* The ways to move a layout */
+typedef enum {
+	TRANSFER_DATATYPE,	/* MPI_Type_vector / indexed (chap06/send_col.c, send_triangle.c) */
+	TRANSFER_PACK,		/* MPI_Pack each block, send MPI_PACKED (chap06/sparse_row.c)    */
+	TRANSFER_COPY,		/* Copy the blocks into a contiguous buffer by hand             */
+	NO_OF_TRANSFER_METHODS
+} TRANSFER_METHOD_T;
+
+/* Blocks of elements of base in a buffer : block i has block_lengths[i]
+ * elements and starts displacements[i] elements from the start. All the
+ * methods send the same type signature, total elements of base, so the
+ * sender and the receiver may each use any of them */
+typedef struct {
+	int count;				/* No of blocks                          */
+	int *block_lengths;
+	int *displacements;
+	int regular;			/* 1 if it came from Layout_vector       */
+	int stride;				/* Elements between blocks, if regular   */
+	MPI_Datatype base;
+	int element_size;		/* Bytes of one element of base          */
+	int total;				/* Elements in all the blocks            */
+} LAYOUT_T;
+
+extern const char *transfer_method_names[NO_OF_TRANSFER_METHODS];
+
+/* count blocks of block_length elements, stride elements apart, like
+ * MPI_Type_vector. Returns 0 if there is not enough memory */
+int Layout_vector(
+		LAYOUT_T *layout,			/* out */
+		int count,					/* in */
+		int block_length,			/* in */
+		int stride,					/* in */
+		MPI_Datatype base			/* in */
+		);
+
+/* Blocks like MPI_Type_indexed. Returns 0 if there is not enough memory */
+int Layout_indexed(
+		LAYOUT_T *layout,			/* out */
+		int count,					/* in */
+		const int block_lengths[],	/* in */
+		const int displacements[],	/* in */
+		MPI_Datatype base			/* in */
+		);
+
+void Layout_free(
+		LAYOUT_T *layout			/* in/out */
+		);
+
+/* Send / receive the layout in buffer with the given method */
+void Layout_send_with(
+		TRANSFER_METHOD_T method,	/* in */
+		const void *buffer,			/* in */
+		const LAYOUT_T *layout,		/* in */
+		int dest,					/* in */
+		int tag,					/* in */
+		MPI_Comm comm				/* in */
+		);
+
+void Layout_recv_with(
+		TRANSFER_METHOD_T method,	/* in */
+		void *buffer,				/* out */
+		const LAYOUT_T *layout,		/* in */
+		int source,					/* in */
+		int tag,					/* in */
+		MPI_Comm comm				/* in */
+		);
+
+/* Half the round trip of the layout between processes 0 and 1 with the
+ * given method, best of a few trials. Collective over comm, every process
+ * gets the same time; 0 if comm has only one process */
+double Layout_transfer_time(
+		TRANSFER_METHOD_T method,	/* in */
+		void *buffer,				/* in/out */
+		const LAYOUT_T *layout,		/* in */
+		MPI_Comm comm				/* in */
+		);
+
+/* Time every method between processes 0 and 1 of comm for layouts of
+ * 2^LAYOUT_MIN_LOG_BYTES .. 2^LAYOUT_MAX_LOG_BYTES bytes in blocks of
+ * 1, 8, 64 and 512 floats, and remember the fastest, cached with comm
+ * ( not with its duplicates ). Collective over comm; every process ends
+ * up with the same table */
+void Layout_transfer_calibrate(
+		MPI_Comm comm				/* in */
+		);
+
+/* Method Layout_send and Layout_recv use for layout on comm */
+TRANSFER_METHOD_T Layout_transfer_choice(
+		const LAYOUT_T *layout,		/* in */
+		MPI_Comm comm				/* in */
+		);
+
+/* Send / receive with the fastest method measured on comm,
+ * TRANSFER_DATATYPE if Layout_transfer_calibrate was not called on comm */
+void Layout_send(
+		const void *buffer,			/* in */
+		const LAYOUT_T *layout,		/* in */
+		int dest,					/* in */
+		int tag,					/* in */
+		MPI_Comm comm				/* in */
+		);
+
+void Layout_recv(
+		void *buffer,				/* out */
+		const LAYOUT_T *layout,		/* in */
+		int source,					/* in */
+		int tag,					/* in */
+		MPI_Comm comm				/* in */
+		);
+
+/* Free the datatypes and the buffer the transfers keep between calls */
+void Layout_transfer_finalize(void);
+
+#endif /* LAYOUT_TRANSFER_H */
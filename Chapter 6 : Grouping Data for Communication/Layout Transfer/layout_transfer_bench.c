@@ -0,0 +1,236 @@
+/*
+ * layout_transfer_bench.c
+ *
+ *  Created on: 16-Oct-2026
+ *      Author: prateek
+ *      Desc : Times the three methods of layout_transfer.c on the layouts of
+ *      	chapter 6, for n x n float matrices of growing n :
+ *      		column   : one column, as chap06/send_col.c
+ *      		triangle : the upper triangle, as chap06/send_triangle.c
+ *      		strided  : every other block of 16 floats of the whole matrix
+ *      	and prints where the fastest method changes.
+ *      Input :
+ *      	n_max : largest order of the matrix, n goes 16, 32, ... n_max
+ *      Output :
+ *      	For every layout and n the time of one transfer by each method, the
+ *      	fastest, the method Layout_send would take after calibration, and the
+ *      	crossovers. Whether every method delivered the layout right.
+ *
+ *      NOTES:
+ *      	1. Needs at least 2 processes; the transfers are between 0 and 1.
+ *      	2. The check receives with a different method than the send, since
+ *      	   they all send the same elements in the same order.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <mpi/mpi.h>
+#include "layout_transfer.h"
+
+#define STRIDED_BLOCK	16		/* Floats per block of the strided layout */
+
+typedef enum {
+	COLUMN,
+	TRIANGLE,
+	STRIDED,
+	NO_OF_LAYOUT_KINDS
+} LAYOUT_KIND_T;
+
+static const char *layout_kind_names[NO_OF_LAYOUT_KINDS] = {
+	"column", "triangle", "strided"
+};
+
+void Get_data(int *n_max_ptr, int my_rank);
+int Build_layout(LAYOUT_T *layout, LAYOUT_KIND_T kind, int n);
+int Check_transfer(TRANSFER_METHOD_T method, float matrix[], float received[], const LAYOUT_T *layout, int n,
+		MPI_Comm comm);
+
+int main(int argc, char **argv)
+{
+	int my_rank;
+	int p;
+	int n_max, n;
+	float *matrix, *received;
+	LAYOUT_T layout;
+	LAYOUT_KIND_T kind;
+	double seconds[NO_OF_TRANSFER_METHODS];
+	TRANSFER_METHOD_T method, best, previous_best;
+	int ok, all_ok = 1;
+	int i;
+
+	MPI_Init(&argc, &argv);
+	MPI_Comm_size(MPI_COMM_WORLD, &p);
+	MPI_Comm_rank(MPI_COMM_WORLD, &my_rank);
+
+	if( p < 2 )
+	{
+		if( my_rank == 0 )
+		{
+			fprintf(stderr, "Run with at least 2 processes \n");
+		}
+		MPI_Finalize();
+		return 0;
+	}
+
+	Get_data(&n_max, my_rank);
+
+	matrix = malloc((size_t) n_max * n_max * sizeof(float));
+	received = malloc((size_t) n_max * n_max * sizeof(float));
+	for( i = 0 ; i < n_max * n_max ; i++ )
+	{
+		matrix[i] = (float) i;
+	}
+
+	Layout_transfer_calibrate(MPI_COMM_WORLD);
+
+	for( kind = 0 ; kind < NO_OF_LAYOUT_KINDS ; kind++ )
+	{
+		if( my_rank == 0 )
+		{
+			printf("\n%s \n", layout_kind_names[kind]);
+			printf("%6s %10s %12s %12s %12s %9s %9s \n", "n", "bytes", "datatype", "pack", "copy", "fastest",
+					"engine");
+		}
+		previous_best = TRANSFER_DATATYPE;
+		for( n = 16 ; n <= n_max ; n *= 2 )
+		{
+			if( !Build_layout(&layout, kind, n) )
+			{
+				break;
+			}
+
+			best = TRANSFER_DATATYPE;
+			for( method = 0 ; method < NO_OF_TRANSFER_METHODS ; method++ )
+			{
+				seconds[method] = Layout_transfer_time(method, matrix, &layout, MPI_COMM_WORLD);
+				if( seconds[method] < seconds[best] )
+				{
+					best = method;
+				}
+				ok = Check_transfer(method, matrix, received, &layout, n, MPI_COMM_WORLD);
+				all_ok &= ok;
+			}
+
+			if( my_rank == 0 )
+			{
+				printf("%6d %10d %12.3e %12.3e %12.3e %9s %9s \n", n, layout.total * (int) sizeof(float),
+						seconds[TRANSFER_DATATYPE], seconds[TRANSFER_PACK], seconds[TRANSFER_COPY],
+						transfer_method_names[best], transfer_method_names[Layout_transfer_choice(&layout, MPI_COMM_WORLD)]);
+				if( n > 16 && best != previous_best )
+				{
+					printf("       crossover between n = %d and %d : %s -> %s \n", n / 2, n,
+							transfer_method_names[previous_best], transfer_method_names[best]);
+				}
+			}
+			previous_best = best;
+			Layout_free(&layout);
+		}
+	}
+
+	if( my_rank == 0 )
+	{
+		printf("\nEvery method delivered the layouts right : %s \n", all_ok ? "yes" : "NO");
+	}
+
+	Layout_transfer_finalize();
+	free(matrix);
+	free(received);
+	MPI_Finalize();
+
+	return 0;
+}
+
+/*
+ * Process 0 reads the largest order and broadcasts it
+ */
+void Get_data(int *n_max_ptr,	/* out */
+			int my_rank			/* in */
+			)
+{
+	if( my_rank == 0 )
+	{
+		printf("Enter the largest order of the matrix\n");
+		scanf("%d", n_max_ptr);
+	}
+
+	MPI_Bcast(n_max_ptr, 1, MPI_INT, 0, MPI_COMM_WORLD);
+}
+
+/*
+ * The layout of kind in an n x n matrix of floats stored by rows.
+ * Returns 0 if there is not enough memory
+ */
+int Build_layout(LAYOUT_T *layout,	/* out */
+			LAYOUT_KIND_T kind,		/* in */
+			int n					/* in */
+			)
+{
+	int *block_lengths, *displacements;
+	int ok, i;
+
+	switch( kind )
+	{
+	case COLUMN:
+		return Layout_vector(layout, n, 1, n, MPI_FLOAT);
+	case TRIANGLE:
+		block_lengths = malloc(n * sizeof(int));
+		displacements = malloc(n * sizeof(int));
+		ok = (block_lengths != NULL && displacements != NULL);
+		if( ok )
+		{
+			for( i = 0 ; i < n ; i++ )
+			{
+				block_lengths[i] = n - i;
+				displacements[i] = i * (n + 1);
+			}
+			ok = Layout_indexed(layout, n, block_lengths, displacements, MPI_FLOAT);
+		}
+		free(block_lengths);
+		free(displacements);
+		return ok;
+	case STRIDED:
+	default:
+		return Layout_vector(layout, n * n / (2 * STRIDED_BLOCK), STRIDED_BLOCK, 2 * STRIDED_BLOCK, MPI_FLOAT);
+	}
+}
+
+/********************************************************************/
+/* Function Check_transfer
+ * Process 0 sends the layout of matrix with method, process 1
+ * receives it with the next method into a zeroed matrix and checks
+ * every element of the layout. Returns the same on every process.
+ ********************************************************************/
+int Check_transfer(TRANSFER_METHOD_T method,	/* in */
+			float matrix[],						/* in */
+			float received[],					/* scratch */
+			const LAYOUT_T *layout,				/* in */
+			int n,								/* in */
+			MPI_Comm comm						/* in */
+			)
+{
+	int my_rank;
+	int ok = 1;
+	int b, i, index;
+
+	MPI_Comm_rank(comm, &my_rank);
+	if( my_rank == 0 )
+	{
+		Layout_send_with(method, matrix, layout, 1, LAYOUT_TAG, comm);
+	}
+	else if( my_rank == 1 )
+	{
+		memset(received, 0, (size_t) n * n * sizeof(float));
+		Layout_recv_with((method + 1) % NO_OF_TRANSFER_METHODS, received, layout, 0, LAYOUT_TAG, comm);
+		for( b = 0 ; b < layout->count ; b++ )
+		{
+			for( i = 0 ; i < layout->block_lengths[b] ; i++ )
+			{
+				index = layout->displacements[b] + i;
+				ok &= (received[index] == matrix[index]);
+			}
+		}
+	}
+
+	MPI_Bcast(&ok, 1, MPI_INT, 1, comm);
+	return ok;
+}
@@ -0,0 +1,523 @@
+/*
+ * packed_matrix.c
+ *
+ *  Created on: 16-Oct-2026
+ *      Author: prateek
+ *      Desc : Packed lower triangular and symmetric matrices by block rows.
+ *      	chap06/send_triangle.c keeps the whole n x n array and picks the
+ *      	triangle out with an MPI_Type_indexed, so half of what is stored and
+ *      	scanned is zeros or copies. Here only the n(n+1)/2 entries on and below
+ *      	the diagonal are kept, row after row, and the rows of a process are one
+ *      	run of them.
+ *
+ *      	Symmetric y = Ax : each kept A(i,j), j < i, is used twice while it is
+ *      	in a register, y(i) += A(i,j) x(j) and y(j) += A(i,j) x(i). The second
+ *      	lands in rows of other processes, so every process builds a partial y
+ *      	of order n and MPI_Reduce_scatter adds them up into the blocks of y.
+ *
+ *      	L x = b : x(j) is known once rows 0 .. j are solved. Process q gets
+ *      	x in chunks of PACKED_SOLVE_CHUNK from q - 1, passes each on to q + 1
+ *      	at once and takes those columns off its sums, then solves its own rows
+ *      	and sends its own chunks the same way. Every process is updating with
+ *      	the first chunks while the ones before it are still solving.
+ *
+ *      	L^T x = b : the same upwards. x(i) needs the sum of L(j,i) x(j) over
+ *      	j > i, which the later processes hold. Process q receives those sums
+ *      	for its columns from q + 1 chunk by chunk from the top, solves its
+ *      	rows from the bottom as they come, and then, chunk by chunk, adds its
+ *      	part for the earlier columns to what q + 1 sent and passes it to q - 1.
+ *
+ *      NOTES:
+ *      	1. The rows are split by entries ( Balanced_rows ) : with equal rows
+ *      	   the last process would keep almost twice its share.
+ *      	2. Every solve reads each kept entry once, in row order, like y = Ax.
+ *      	3. Inlined into the loop over the rows, gcc keeps the 16 lanes of the
+ *      	   simd reduction of Dot and Dot_axpy in memory and adds them up from
+ *      	   there for every row, which made y = Ax 6 times slower. Out of line
+ *      	   they stay in registers.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "packed_matrix.h"
+
+/*
+ * First row of process q when n rows are split into p runs of about
+ * the same no of entries
+ */
+static int Balanced_rows(int n,	/* in */
+			int p,				/* in */
+			int q				/* in */
+			)
+{
+	double target = (double) Packed_offset(n) * q / p;
+	int i = (int) ((sqrt(8.0 * target + 1.0) - 1.0) / 2.0);
+
+	if( q >= p )
+	{
+		return n;
+	}
+	while( i < n && (double) Packed_offset(i) < target )
+	{
+		i++;
+	}
+	while( i > 0 && (double) Packed_offset(i - 1) >= target )
+	{
+		i--;
+	}
+	return i;
+}
+
+/********************************************************************/
+/* Function Packed_matrix_create
+ * Algorithm:
+ *     1.  Every process works out the same split of the rows.
+ *     2.  Allocate my rows, the two work vectors and the requests;
+ *         if any process fails, all free what they got.
+ ********************************************************************/
+PACKED_MATRIX_T *Packed_matrix_create(PACKED_KIND_T kind,	/* in */
+			int n,										/* in */
+			MPI_Comm comm								/* in */
+			)
+{
+	PACKED_MATRIX_T *A;
+	int my_rank;
+	int p;
+	int ok, q;
+
+	MPI_Comm_size(comm, &p);
+	MPI_Comm_rank(comm, &my_rank);
+
+	A = calloc(1, sizeof(PACKED_MATRIX_T));
+	ok = (A != NULL);
+	if( ok )
+	{
+		A->kind = kind;
+		A->n = n;
+		A->comm = comm;
+		A->first_rows = malloc((p + 1) * sizeof(int));
+		A->counts = malloc(p * sizeof(int));
+		ok = (A->first_rows != NULL && A->counts != NULL);
+	}
+
+	/* 1. */
+	if( ok )
+	{
+		for( q = 0 ; q <= p ; q++ )
+		{
+			A->first_rows[q] = Balanced_rows(n, p, q);
+		}
+		for( q = 0 ; q < p ; q++ )
+		{
+			A->counts[q] = A->first_rows[q + 1] - A->first_rows[q];
+		}
+		A->first_row = A->first_rows[my_rank];
+		A->rows = A->counts[my_rank];
+		A->no_of_entries = Packed_offset(A->first_row + A->rows) - Packed_offset(A->first_row);
+
+		/* 2. */
+		A->entries = malloc((A->no_of_entries + 1) * sizeof(float));
+		A->x_work = malloc((n + 1) * sizeof(float));
+		A->y_work = malloc((n + 1) * sizeof(float));
+		A->requests = malloc((n / PACKED_SOLVE_CHUNK + p + 1) * sizeof(MPI_Request));
+		ok = (A->entries != NULL && A->x_work != NULL && A->y_work != NULL && A->requests != NULL);
+	}
+
+	MPI_Allreduce(MPI_IN_PLACE, &ok, 1, MPI_INT, MPI_MIN, comm);
+	if( !ok )
+	{
+		Packed_matrix_free(&A);
+	}
+	return A;
+}
+
+void Packed_matrix_free(PACKED_MATRIX_T **A	/* in/out */)
+{
+	if( *A == NULL )
+	{
+		return;
+	}
+	free((*A)->first_rows);
+	free((*A)->counts);
+	free((*A)->entries);
+	free((*A)->x_work);
+	free((*A)->y_work);
+	free((*A)->requests);
+	free(*A);
+	*A = NULL;
+}
+
+/********************************************************************/
+/* Function Packed_full_rows_type
+ * Row first + k of the triangle is first + k + 1 floats starting at
+ * ( first + k ) n. The displacements are in bytes ( hindexed ) so that
+ * n^2 may pass 2^31.
+ ********************************************************************/
+MPI_Datatype Packed_full_rows_type(int n,	/* in */
+			int first,						/* in */
+			int rows						/* in */
+			)
+{
+	int *block_lengths = malloc((rows + 1) * sizeof(int));
+	MPI_Aint *displacements = malloc((rows + 1) * sizeof(MPI_Aint));
+	MPI_Datatype rows_mpi_t;
+	int k;
+
+	for( k = 0 ; k < rows ; k++ )
+	{
+		block_lengths[k] = first + k + 1;
+		displacements[k] = (MPI_Aint) (first + k) * n * sizeof(float);
+	}
+	MPI_Type_create_hindexed(rows, block_lengths, displacements, MPI_FLOAT, &rows_mpi_t);
+	MPI_Type_commit(&rows_mpi_t);
+
+	free(block_lengths);
+	free(displacements);
+	return rows_mpi_t;
+}
+
+void Packed_matrix_scatter_full(const float full[],	/* in ( root ) */
+			int root,								/* in */
+			PACKED_MATRIX_T *A						/* in/out */
+			)
+{
+	int my_rank;
+	int p;
+	MPI_Datatype rows_mpi_t;
+	int no_of_requests = 0;
+	int q, i;
+
+	MPI_Comm_size(A->comm, &p);
+	MPI_Comm_rank(A->comm, &my_rank);
+
+	if( my_rank == root )
+	{
+		for( q = 0 ; q < p ; q++ )
+		{
+			if( q == root )
+			{
+				for( i = A->first_row ; i < A->first_row + A->rows ; i++ )
+				{
+					memcpy(Packed_row(A, i), &full[(size_t) i * A->n], (i + 1) * sizeof(float));
+				}
+			}
+			else
+			{
+				rows_mpi_t = Packed_full_rows_type(A->n, A->first_rows[q], A->counts[q]);
+				MPI_Isend((void *) full, 1, rows_mpi_t, q, PACKED_TAG, A->comm, &A->requests[no_of_requests++]);
+				MPI_Type_free(&rows_mpi_t);
+			}
+		}
+		MPI_Waitall(no_of_requests, A->requests, MPI_STATUSES_IGNORE);
+	}
+	else
+	{
+		MPI_Recv(A->entries, (int) A->no_of_entries, MPI_FLOAT, root, PACKED_TAG, A->comm, MPI_STATUS_IGNORE);
+	}
+}
+
+/*
+ * Abort if A is not of the kind routine_name works on. kind is the same
+ * on every process, so they all abort or none does
+ */
+static void Check_kind(const PACKED_MATRIX_T *A,	/* in */
+			PACKED_KIND_T kind,						/* in */
+			const char *routine_name				/* in */
+			)
+{
+	if( A->kind != kind )
+	{
+		fprintf(stderr, "%s needs a %s matrix \n", routine_name,
+				(kind == PACKED_LOWER) ? "PACKED_LOWER" : "PACKED_SYMMETRIC");
+		MPI_Abort(A->comm, -1);
+	}
+}
+
+/*
+ * a . x over count entries. Kept out of line ( NOTE 3 )
+ */
+__attribute__((noinline))
+static float Dot(const float a[],	/* in */
+			const float x[],		/* in */
+			int count				/* in */
+			)
+{
+	float sum = 0.0f;
+	int j;
+
+#pragma omp simd reduction(+:sum)
+	for( j = 0 ; j < count ; j++ )
+	{
+		sum += a[j] * x[j];
+	}
+	return sum;
+}
+
+/*
+ * a . x over count entries, and y += alpha a in the same pass. Kept out
+ * of line ( NOTE 3 )
+ */
+__attribute__((noinline))
+static float Dot_axpy(const float a[],	/* in */
+			const float x[],			/* in */
+			float alpha,				/* in */
+			float y[],					/* in/out */
+			int count					/* in */
+			)
+{
+	float sum = 0.0f;
+	int j;
+
+#pragma omp simd reduction(+:sum)
+	for( j = 0 ; j < count ; j++ )
+	{
+		sum += a[j] * x[j];
+		y[j] += alpha * a[j];
+	}
+	return sum;
+}
+
+/********************************************************************/
+/* Function Packed_sym_mat_vec
+ * Algorithm:
+ *     1.  Gather all of x.
+ *     2.  For each of my rows i : one pass over A(i,0) .. A(i,i-1)
+ *         gives the dot product for y(i) and adds A(i,j) x(i) to
+ *         every y(j).
+ *     3.  MPI_Reduce_scatter the partial y's into the blocks of y.
+ ********************************************************************/
+void Packed_sym_mat_vec(PACKED_MATRIX_T *A,	/* in/out */
+			const float local_x[],			/* in */
+			float local_y[]					/* out */
+			)
+{
+	float *x = A->x_work;
+	float *y = A->y_work;
+	const float *row;
+	int i;
+
+	Check_kind(A, PACKED_SYMMETRIC, "Packed_sym_mat_vec");
+
+	/* 1. */
+	MPI_Allgatherv(local_x, A->rows, MPI_FLOAT, x, A->counts, A->first_rows, MPI_FLOAT, A->comm);
+
+	/* 2. */
+	memset(y, 0, A->n * sizeof(float));
+	for( i = A->first_row ; i < A->first_row + A->rows ; i++ )
+	{
+		row = Packed_row(A, i);
+		y[i] += Dot_axpy(row, x, x[i], y, i) + row[i] * x[i];
+	}
+
+	/* 3. */
+	MPI_Reduce_scatter(y, local_y, A->counts, MPI_FLOAT, MPI_SUM, A->comm);
+}
+
+/*
+ * sums[i - first] -= L(i, c0 .. c1 - 1) x(c0 .. c1 - 1) for my rows i
+ */
+static void Subtract_columns(const PACKED_MATRIX_T *L,	/* in */
+			int c0,										/* in */
+			int c1,										/* in */
+			const float x[],							/* in */
+			float sums[]								/* in/out */
+			)
+{
+	int i;
+
+	for( i = L->first_row ; i < L->first_row + L->rows ; i++ )
+	{
+		sums[i - L->first_row] -= Dot(&Packed_row(L, i)[c0], &x[c0], c1 - c0);
+	}
+}
+
+/********************************************************************/
+/* Function Packed_lower_solve
+ * Algorithm:
+ *     1.  sums = b.
+ *     2.  For the chunks of x of every process before me, in order :
+ *         receive it from my_rank - 1, pass it on to my_rank + 1 and
+ *         take its columns off the sums.
+ *     3.  For the chunks of my own rows : x(i) = ( sums(i) - the
+ *         columns of my rows before i ) / L(i,i), then send the chunk
+ *         to my_rank + 1.
+ *     4.  Wait for the sends; my block of x is in x_work.
+ ********************************************************************/
+void Packed_lower_solve(PACKED_MATRIX_T *L,	/* in/out */
+			const float local_b[],			/* in */
+			float local_x[]					/* out */
+			)
+{
+	float *x = L->x_work;
+	float *sums = L->y_work;
+	const float *row;
+	int my_rank;
+	int p;
+	int last = L->first_row + L->rows;
+	int no_of_requests = 0;
+	int q, c0, c1, i;
+
+	Check_kind(L, PACKED_LOWER, "Packed_lower_solve");
+	MPI_Comm_size(L->comm, &p);
+	MPI_Comm_rank(L->comm, &my_rank);
+
+	/* 1. */
+	memcpy(sums, local_b, L->rows * sizeof(float));
+
+	/* 2. */
+	for( q = 0 ; q < my_rank ; q++ )
+	{
+		for( c0 = L->first_rows[q] ; c0 < L->first_rows[q + 1] ; c0 += PACKED_SOLVE_CHUNK )
+		{
+			c1 = (c0 + PACKED_SOLVE_CHUNK < L->first_rows[q + 1]) ? c0 + PACKED_SOLVE_CHUNK : L->first_rows[q + 1];
+			MPI_Recv(&x[c0], c1 - c0, MPI_FLOAT, my_rank - 1, PACKED_SOLVE_TAG, L->comm, MPI_STATUS_IGNORE);
+			if( my_rank < p - 1 )
+			{
+				MPI_Isend(&x[c0], c1 - c0, MPI_FLOAT, my_rank + 1, PACKED_SOLVE_TAG, L->comm,
+						&L->requests[no_of_requests++]);
+			}
+			Subtract_columns(L, c0, c1, x, sums);
+		}
+	}
+
+	/* 3. */
+	for( c0 = L->first_row ; c0 < last ; c0 += PACKED_SOLVE_CHUNK )
+	{
+		c1 = (c0 + PACKED_SOLVE_CHUNK < last) ? c0 + PACKED_SOLVE_CHUNK : last;
+		for( i = c0 ; i < c1 ; i++ )
+		{
+			row = Packed_row(L, i);
+			x[i] = (sums[i - L->first_row] - Dot(&row[L->first_row], &x[L->first_row], i - L->first_row)) / row[i];
+		}
+		if( my_rank < p - 1 )
+		{
+			MPI_Isend(&x[c0], c1 - c0, MPI_FLOAT, my_rank + 1, PACKED_SOLVE_TAG, L->comm,
+					&L->requests[no_of_requests++]);
+		}
+	}
+
+	/* 4. */
+	MPI_Waitall(no_of_requests, L->requests, MPI_STATUSES_IGNORE);
+	memcpy(local_x, &x[L->first_row], L->rows * sizeof(float));
+}
+
+/*
+ * Start of chunk k of the rows of process q, counting from its first row
+ */
+static int Chunk_start(const PACKED_MATRIX_T *L,	/* in */
+			int q,								/* in */
+			int k								/* in */
+			)
+{
+	return L->first_rows[q] + k * PACKED_SOLVE_CHUNK;
+}
+
+/*
+ * No of chunks of the rows of process q
+ */
+static int No_of_chunks(const PACKED_MATRIX_T *L,	/* in */
+			int q								/* in */
+			)
+{
+	return (L->counts[q] + PACKED_SOLVE_CHUNK - 1) / PACKED_SOLVE_CHUNK;
+}
+
+/********************************************************************/
+/* Function Packed_upper_solve
+ * t(k) is the sum of L(j,k) x(j) over the rows j > k solved so far.
+ * The chunks go from the top : those of process my_rank - 1, last
+ * chunk first, then those of my_rank - 2, and so on.
+ * Algorithm:
+ *     1.  t = 0.
+ *     2.  For the chunks of my own columns, from the top : add what
+ *         my_rank + 1 sends to t, then for the rows of the chunk from
+ *         the bottom x(i) = ( b(i) - t(i) ) / L(i,i) and add
+ *         L(i,k) x(i) to t(k) for my columns k < i.
+ *     3.  For the chunks of the columns before mine, from the top :
+ *         add my rows times x to t, add what my_rank + 1 sends, and
+ *         pass it on to my_rank - 1.
+ *     4.  Wait for the sends.
+ ********************************************************************/
+void Packed_upper_solve(PACKED_MATRIX_T *L,	/* in/out */
+			const float local_b[],			/* in */
+			float local_x[]					/* out */
+			)
+{
+	float *t = L->x_work;
+	float *received = L->y_work;
+	const float *row;
+	float x_i;
+	int my_rank;
+	int p;
+	int no_of_requests = 0;
+	int q, k, c0, c1, i, j;
+
+	Check_kind(L, PACKED_LOWER, "Packed_upper_solve");
+	MPI_Comm_size(L->comm, &p);
+	MPI_Comm_rank(L->comm, &my_rank);
+
+	/* 1. */
+	memset(t, 0, (L->first_row + L->rows) * sizeof(float));
+
+	/* 2. */
+	for( k = No_of_chunks(L, my_rank) - 1 ; k >= 0 ; k-- )
+	{
+		c0 = Chunk_start(L, my_rank, k);
+		c1 = (c0 + PACKED_SOLVE_CHUNK < L->first_row + L->rows) ? c0 + PACKED_SOLVE_CHUNK : L->first_row + L->rows;
+		if( my_rank < p - 1 )
+		{
+			MPI_Recv(&received[c0], c1 - c0, MPI_FLOAT, my_rank + 1, PACKED_SOLVE_TAG, L->comm,
+					MPI_STATUS_IGNORE);
+			for( j = c0 ; j < c1 ; j++ )
+			{
+				t[j] += received[j];
+			}
+		}
+		for( i = c1 - 1 ; i >= c0 ; i-- )
+		{
+			row = Packed_row(L, i);
+			x_i = (local_b[i - L->first_row] - t[i]) / row[i];
+			local_x[i - L->first_row] = x_i;
+#pragma omp simd
+			for( j = L->first_row ; j < i ; j++ )
+			{
+				t[j] += row[j] * x_i;
+			}
+		}
+	}
+
+	/* 3. */
+	for( q = my_rank - 1 ; q >= 0 ; q-- )
+	{
+		for( k = No_of_chunks(L, q) - 1 ; k >= 0 ; k-- )
+		{
+			c0 = Chunk_start(L, q, k);
+			c1 = (c0 + PACKED_SOLVE_CHUNK < L->first_rows[q + 1]) ? c0 + PACKED_SOLVE_CHUNK : L->first_rows[q + 1];
+			for( i = L->first_row ; i < L->first_row + L->rows ; i++ )
+			{
+				row = Packed_row(L, i);
+				x_i = local_x[i - L->first_row];
+#pragma omp simd
+				for( j = c0 ; j < c1 ; j++ )
+				{
+					t[j] += row[j] * x_i;
+				}
+			}
+			if( my_rank < p - 1 )
+			{
+				MPI_Recv(&received[c0], c1 - c0, MPI_FLOAT, my_rank + 1, PACKED_SOLVE_TAG, L->comm,
+						MPI_STATUS_IGNORE);
+				for( j = c0 ; j < c1 ; j++ )
+				{
+					t[j] += received[j];
+				}
+			}
+			MPI_Isend(&t[c0], c1 - c0, MPI_FLOAT, my_rank - 1, PACKED_SOLVE_TAG, L->comm,
+					&L->requests[no_of_requests++]);
+		}
+	}
+
+	/* 4. */
+	MPI_Waitall(no_of_requests, L->requests, MPI_STATUSES_IGNORE);
+}
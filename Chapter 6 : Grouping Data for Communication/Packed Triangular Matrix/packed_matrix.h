@@ -0,0 +1,118 @@
+/*
+ * packed_matrix.h
+ *
+ *  Created on: 16-Oct-2026
+ *      Author: prateek
+ *      Desc : Header for packed_matrix.c -- a lower triangular or symmetric
+ *      	n x n matrix keeping only its n(n+1)/2 entries on and below the
+ *      	diagonal, distributed by block rows, with y = Ax for the symmetric
+ *      	one and Lx = b, L^T x = b for the triangular one.
+ */
+#ifndef PACKED_MATRIX_H
+#define PACKED_MATRIX_H
+
+#include <mpi/mpi.h>
+
+/* Tags of the distribution and of the pipelined solves */
+#define PACKED_TAG			7801
+#define PACKED_SOLVE_TAG	7802
+
+/* Columns of x ( or partial sums ) in one message of the solves */
+#define PACKED_SOLVE_CHUNK	512
+
+typedef enum {
+	PACKED_LOWER,		/* L : the entries above the diagonal are 0       */
+	PACKED_SYMMETRIC	/* A : A(j,i) = A(i,j), only j <= i is kept       */
+} PACKED_KIND_T;
+
+/* Packed by rows : row i holds A(i,0) .. A(i,i) and starts
+ * Packed_offset(i) entries from row 0. The rows of process q are
+ * first_rows[q] .. first_rows[q+1] - 1, and since the rows follow each
+ * other they are one run of entries. The rows are split so every
+ * process keeps about the same no of entries, not of rows */
+typedef struct {
+	PACKED_KIND_T kind;
+	int n;
+	int first_row;			/* My rows                              */
+	int rows;
+	int *first_rows;		/* p + 1 entries                        */
+	int *counts;			/* Rows of each process, for x and y    */
+	float *entries;			/* My rows, packed                      */
+	size_t no_of_entries;
+	float *x_work;			/* n floats, x gathered / sums passed   */
+	float *y_work;			/* n floats, the partial y              */
+	MPI_Request *requests;	/* One per chunk a solve sends          */
+	MPI_Comm comm;
+} PACKED_MATRIX_T;
+
+/* Entries in rows 0 .. i - 1 */
+#define Packed_offset(i)	((size_t) (i) * ((size_t) (i) + 1) / 2)
+
+/* A(i,j) for j <= i and i one of my rows */
+#define Packed_entry(A,i,j)	((A)->entries[Packed_offset(i) - Packed_offset((A)->first_row) + (j)])
+
+/* My row i, A(i,0) .. A(i,i) */
+#define Packed_row(A,i)		(&(A)->entries[Packed_offset(i) - Packed_offset((A)->first_row)])
+
+/* Empty n x n matrix over comm, rows split by entries. Collective over
+ * comm. Returns NULL on every process if memory ran out on any */
+PACKED_MATRIX_T *Packed_matrix_create(
+		PACKED_KIND_T kind,			/* in */
+		int n,						/* in */
+		MPI_Comm comm				/* in */
+		);
+
+void Packed_matrix_free(
+		PACKED_MATRIX_T **A			/* in/out */
+		);
+
+/* Datatype picking the lower triangle of rows first .. first + rows - 1
+ * out of a full row-major n x n float array, like the upper triangle of
+ * chap06/send_triangle.c. It matches Packed_offset(first + rows) -
+ * Packed_offset(first) contiguous floats. Committed; free it after use */
+MPI_Datatype Packed_full_rows_type(
+		int n,						/* in */
+		int first,					/* in */
+		int rows					/* in */
+		);
+
+/* Fill every process's rows from the full row-major n x n array on
+ * root ( ignored elsewhere ). Root sends each process its rows with
+ * Packed_full_rows_type, the others receive them straight into their
+ * packed rows. Collective over A->comm */
+void Packed_matrix_scatter_full(
+		const float full[],			/* in ( root ) */
+		int root,					/* in */
+		PACKED_MATRIX_T *A			/* in/out */
+		);
+
+/* local_y = my rows of A x for a symmetric A, x and y distributed like
+ * the rows. Every entry kept is read once, for both A(i,j) and A(j,i).
+ * Aborts unless A is PACKED_SYMMETRIC. Collective over A->comm */
+void Packed_sym_mat_vec(
+		PACKED_MATRIX_T *A,			/* in/out */
+		const float local_x[],		/* in */
+		float local_y[]				/* out */
+		);
+
+/* Solve L x = b, b and x distributed like the rows. x moves down the
+ * processes PACKED_SOLVE_CHUNK entries at a time, so process q updates
+ * its sums with the first entries of x while the ones before it are
+ * still solving. Aborts unless L is PACKED_LOWER. Collective over
+ * L->comm */
+void Packed_lower_solve(
+		PACKED_MATRIX_T *L,			/* in/out */
+		const float local_b[],		/* in */
+		float local_x[]				/* out */
+		);
+
+/* Solve L^T x = b, the upper triangular system, the same way upwards :
+ * the partial sums of the earlier entries move up in chunks. Aborts
+ * unless L is PACKED_LOWER */
+void Packed_upper_solve(
+		PACKED_MATRIX_T *L,			/* in/out */
+		const float local_b[],		/* in */
+		float local_x[]				/* out */
+		);
+
+#endif /* PACKED_MATRIX_H */
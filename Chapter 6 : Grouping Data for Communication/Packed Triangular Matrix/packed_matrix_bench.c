@@ -0,0 +1,319 @@
+/*
+ * packed_matrix_bench.c
+ *
+ *  Created on: 16-Oct-2026
+ *      Author: prateek
+ *      Desc : A symmetric matrix kept packed ( packed_matrix.c ) against the
+ *      	same matrix kept whole by block rows ( dense_matrix.c ) : the floats
+ *      	each process stores, the time to hand it out from process 0 and the
+ *      	time of y = Ax. Then the pipelined solves with a packed L and L^T.
+ *      Input :
+ *      	n : order of the matrices
+ *      Output :
+ *      	Floats kept ( largest process ), and the time ( slowest process ) of
+ *      	handing out, of y = Ax and of each solve, and whether the results
+ *      	are right.
+ *
+ *      NOTES:
+ *      	1. A(i,j) = (i + j) % 7 - 3, L(i,j) = (i + 2j) % 5 - 2 below the
+ *      	   diagonal and 1 on it, x(j) = j % 5 - 2. Every sum and every step of
+ *      	   the solves is an integer well below 2^24, so the results are exact
+ *      	   in float and are checked with ==.
+ *      	2. The dense rows are split evenly, the packed ones by entries.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <mpi/mpi.h>
+#include "packed_matrix.h"
+#include "dense_matrix.h"
+
+#define REPS	20
+
+void Get_data(int *n_ptr, int my_rank);
+void Block_range(int n, int no_of_blocks, int block, int *first_ptr, int *count_ptr);
+float A_entry(int i, int j);
+float L_entry(int i, int j);
+float X_entry(int j);
+double Max_time(double start);
+
+int main(int argc, char **argv)
+{
+	int my_rank;
+	int p;
+	int n;
+	float *full = NULL, *dense_rows;
+	int *counts, *displacements;
+	int local_n, first_row;
+	DENSE_MATRIX_T *dense;
+	PACKED_MATRIX_T *A, *L;
+	float *x, *y, *global_x;
+	float *b, *solved;
+	double start, seconds[6];
+	long long kept[2];
+	float expected;
+	int ok[3], all_ok[3];
+	int rank, rep, i, j;
+
+	MPI_Init(&argc, &argv);
+	MPI_Comm_size(MPI_COMM_WORLD, &p);
+	MPI_Comm_rank(MPI_COMM_WORLD, &my_rank);
+
+	Get_data(&n, my_rank);
+
+	/* The whole symmetric matrix on process 0 */
+	if( my_rank == 0 )
+	{
+		full = malloc((size_t) n * n * sizeof(float));
+		for( i = 0 ; i < n ; i++ )
+		{
+			for( j = 0 ; j < n ; j++ )
+			{
+				full[(size_t) i * n + j] = A_entry(i, j);
+			}
+		}
+	}
+
+	/* Dense block rows, handed out with MPI_Scatterv */
+	counts = malloc(p * sizeof(int));
+	displacements = malloc(p * sizeof(int));
+	for( rank = 0 ; rank < p ; rank++ )
+	{
+		Block_range(n, p, rank, &displacements[rank], &counts[rank]);
+		counts[rank] *= n;
+		displacements[rank] *= n;
+	}
+	Block_range(n, p, my_rank, &first_row, &local_n);
+	dense_rows = malloc(((size_t) local_n * n + 1) * sizeof(float));
+	dense = Dense_matrix_allocate(local_n, n);
+
+	MPI_Barrier(MPI_COMM_WORLD);
+	start = MPI_Wtime();
+	MPI_Scatterv(full, counts, displacements, MPI_FLOAT, dense_rows, local_n * n, MPI_FLOAT, 0, MPI_COMM_WORLD);
+	seconds[0] = Max_time(start);
+	for( i = 0 ; i < local_n ; i++ )
+	{
+		memcpy(Row(dense, i), &dense_rows[(size_t) i * n], n * sizeof(float));
+	}
+	free(dense_rows);
+
+	/* Packed rows, handed out with Packed_full_rows_type */
+	A = Packed_matrix_create(PACKED_SYMMETRIC, n, MPI_COMM_WORLD);
+	L = Packed_matrix_create(PACKED_LOWER, n, MPI_COMM_WORLD);
+	if( A == NULL || L == NULL )
+	{
+		if( my_rank == 0 )
+		{
+			fprintf(stderr, "Cannot allocate the packed matrices \n");
+		}
+		MPI_Abort(MPI_COMM_WORLD, 1);
+	}
+	MPI_Barrier(MPI_COMM_WORLD);
+	start = MPI_Wtime();
+	Packed_matrix_scatter_full(full, 0, A);
+	seconds[1] = Max_time(start);
+	free(full);
+
+	kept[0] = (long long) local_n * n;
+	kept[1] = (long long) A->no_of_entries;
+	MPI_Allreduce(MPI_IN_PLACE, kept, 2, MPI_LONG_LONG, MPI_MAX, MPI_COMM_WORLD);
+
+	/* y = Ax both ways */
+	global_x = malloc(n * sizeof(float));
+	x = malloc((n + 1) * sizeof(float));
+	y = malloc((n + 1) * sizeof(float));
+	for( rank = 0 ; rank < p ; rank++ )
+	{
+		counts[rank] /= n;
+		displacements[rank] /= n;
+	}
+	for( i = 0 ; i < local_n ; i++ )
+	{
+		x[i] = X_entry(first_row + i);
+	}
+	MPI_Barrier(MPI_COMM_WORLD);
+	start = MPI_Wtime();
+	for( rep = 0 ; rep < REPS ; rep++ )
+	{
+		MPI_Allgatherv(x, local_n, MPI_FLOAT, global_x, counts, displacements, MPI_FLOAT, MPI_COMM_WORLD);
+		Dense_gemv(dense, global_x, y);
+	}
+	seconds[2] = Max_time(start) / REPS;
+	ok[0] = 1;
+	for( i = 0 ; i < local_n ; i++ )
+	{
+		expected = 0.0f;
+		for( j = 0 ; j < n ; j++ )
+		{
+			expected += A_entry(first_row + i, j) * X_entry(j);
+		}
+		ok[0] &= (y[i] == expected);
+	}
+
+	for( i = 0 ; i < A->rows ; i++ )
+	{
+		x[i] = X_entry(A->first_row + i);
+	}
+	MPI_Barrier(MPI_COMM_WORLD);
+	start = MPI_Wtime();
+	for( rep = 0 ; rep < REPS ; rep++ )
+	{
+		Packed_sym_mat_vec(A, x, y);
+	}
+	seconds[3] = Max_time(start) / REPS;
+	for( i = 0 ; i < A->rows ; i++ )
+	{
+		expected = 0.0f;
+		for( j = 0 ; j < n ; j++ )
+		{
+			expected += A_entry(A->first_row + i, j) * X_entry(j);
+		}
+		ok[0] &= (y[i] == expected);
+	}
+
+	/* L x = b and L^T x = b, with b made from the known x */
+	for( i = L->first_row ; i < L->first_row + L->rows ; i++ )
+	{
+		for( j = 0 ; j <= i ; j++ )
+		{
+			Packed_entry(L, i, j) = L_entry(i, j);
+		}
+	}
+	b = malloc((L->rows + 1) * sizeof(float));
+	solved = malloc((L->rows + 1) * sizeof(float));
+
+	for( i = 0 ; i < L->rows ; i++ )
+	{
+		b[i] = 0.0f;
+		for( j = 0 ; j <= L->first_row + i ; j++ )
+		{
+			b[i] += L_entry(L->first_row + i, j) * X_entry(j);
+		}
+	}
+	MPI_Barrier(MPI_COMM_WORLD);
+	start = MPI_Wtime();
+	for( rep = 0 ; rep < REPS ; rep++ )
+	{
+		Packed_lower_solve(L, b, solved);
+	}
+	seconds[4] = Max_time(start) / REPS;
+	ok[1] = 1;
+	for( i = 0 ; i < L->rows ; i++ )
+	{
+		ok[1] &= (solved[i] == X_entry(L->first_row + i));
+	}
+
+	for( i = 0 ; i < L->rows ; i++ )
+	{
+		b[i] = 0.0f;
+		for( j = L->first_row + i ; j < n ; j++ )
+		{
+			b[i] += L_entry(j, L->first_row + i) * X_entry(j);
+		}
+	}
+	MPI_Barrier(MPI_COMM_WORLD);
+	start = MPI_Wtime();
+	for( rep = 0 ; rep < REPS ; rep++ )
+	{
+		Packed_upper_solve(L, b, solved);
+	}
+	seconds[5] = Max_time(start) / REPS;
+	ok[2] = 1;
+	for( i = 0 ; i < L->rows ; i++ )
+	{
+		ok[2] &= (solved[i] == X_entry(L->first_row + i));
+	}
+
+	MPI_Reduce(ok, all_ok, 3, MPI_INT, MPI_MIN, 0, MPI_COMM_WORLD);
+	if( my_rank == 0 )
+	{
+		printf("n = %d , p = %d \n", n, p);
+		printf("                 dense rows      packed \n");
+		printf("floats kept    : %12lld  %12lld ( largest process ) \n", kept[0], kept[1]);
+		printf("hand out       : %e s  %e s \n", seconds[0], seconds[1]);
+		printf("y = Ax         : %e s  %e s , y %s \n", seconds[2], seconds[3], all_ok[0] ? "right" : "WRONG");
+		printf("L x = b        :                 %e s , x %s \n", seconds[4], all_ok[1] ? "right" : "WRONG");
+		printf("L^T x = b      :                 %e s , x %s \n", seconds[5], all_ok[2] ? "right" : "WRONG");
+	}
+
+	Packed_matrix_free(&A);
+	Packed_matrix_free(&L);
+	Dense_matrix_free(&dense);
+	free(global_x);
+	free(x);
+	free(y);
+	free(b);
+	free(solved);
+	free(counts);
+	free(displacements);
+	MPI_Finalize();
+
+	return 0;
+}
+
+/*
+ * Process 0 reads the order and broadcasts it
+ */
+void Get_data(int *n_ptr,	/* out */
+			int my_rank		/* in */
+			)
+{
+	if( my_rank == 0 )
+	{
+		printf("Enter the order of the matrices\n");
+		scanf("%d", n_ptr);
+	}
+
+	MPI_Bcast(n_ptr, 1, MPI_INT, 0, MPI_COMM_WORLD);
+}
+
+/*
+ * First index and length of block number block of n split into no_of_blocks.
+ * The first n % no_of_blocks blocks get one more.
+ */
+void Block_range(int n,			/* in */
+			int no_of_blocks,	/* in */
+			int block,			/* in */
+			int *first_ptr,		/* out */
+			int *count_ptr		/* out */
+			)
+{
+	int quotient = n / no_of_blocks;
+	int remainder = n % no_of_blocks;
+
+	*count_ptr = quotient + (block < remainder ? 1 : 0);
+	*first_ptr = block * quotient + (block < remainder ? block : remainder);
+}
+
+/*
+ * Entries of NOTES 1
+ */
+float A_entry(int i,	/* in */
+			int j		/* in */
+			)
+{
+	return (float) ((i + j) % 7 - 3);
+}
+
+float L_entry(int i,	/* in */
+			int j		/* in */
+			)
+{
+	return (i == j) ? 1.0f : (float) ((i + 2 * j) % 5 - 2);
+}
+
+float X_entry(int j	/* in */)
+{
+	return (float) (j % 5 - 2);
+}
+
+/*
+ * Time since start on the slowest process, on every process
+ */
+double Max_time(double start	/* in */)
+{
+	double elapsed = MPI_Wtime() - start;
+
+	MPI_Allreduce(MPI_IN_PLACE, &elapsed, 1, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+	return elapsed;
+}
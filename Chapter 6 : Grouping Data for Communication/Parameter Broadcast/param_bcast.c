@@ -0,0 +1,304 @@
+/*
+ * param_bcast.c
+ *
+ *  Created on: 16-Oct-2026
+ *      Author: prateek
+ *      Desc : The five ways of the book to send the input parameters from one
+ *      	process to all the others, for a block of any number of floats and ints
+ *      	instead of just a, b and n :
+ *      		PARAM_LINEAR : root sends the floats and the ints to each process in turn
+ *      		PARAM_TREE   : binomial tree of Tree_bcast, one message per field per edge
+ *      		PARAM_BCAST  : one MPI_Bcast per field
+ *      		PARAM_STRUCT : derived datatype over both fields, one MPI_Bcast
+ *      		PARAM_PACK   : MPI_Pack into a buffer, one MPI_Bcast, MPI_Unpack
+ *
+ *      	Param_bcast_calibrate times all five on a communicator for blocks of
+ *      	8 .. PARAM_MAX_BYTES bytes and keeps the fastest for every size, so that
+ *      	Param_bcast can pick a strategy at runtime. The table is cached with the
+ *      	communicator, so each communicator uses what was measured on it.
+ *
+ *      NOTES:
+ *      	1. As in get_data3.c the struct datatype is built, committed and freed on
+ *      	   every call, so its cost is part of the time of PARAM_STRUCT.
+ *      	2. The times compared are the max over processes, reduced with
+ *      	   MPI_Allreduce, so every process picks the same strategy. It has to :
+ *      	   the strategies do not match each other's messages.
+ */
+#include <stdlib.h>
+#include "param_bcast.h"
+#include "tree_bcast.h"
+
+#define CALIBRATE_REPS		10
+#define CALIBRATE_TRIALS	3
+#define MIN_LOG_BYTES		3		/* Smallest calibrated block : 8 bytes */
+#define NO_OF_SIZES			12		/* 8 .. 16384 bytes, by powers of 2 */
+
+const char *param_strategy_names[NO_OF_PARAM_STRATEGIES] = {
+	"linear", "tree", "bcast", "struct", "pack"
+};
+
+/* Each calibrated communicator keeps its own table under this key :
+ * fastest[s] is the fastest strategy for blocks of up to
+ * 2^(MIN_LOG_BYTES + s) bytes. The crossovers depend on the no of
+ * processes and where they are, so a table is only good for the
+ * communicator it was measured on, and is not copied to its duplicates */
+static int param_key = MPI_KEYVAL_INVALID;
+
+/*
+ * Delete function of param_key : free the table with the communicator
+ */
+static int Free_table(MPI_Comm comm,	/* in */
+			int keyval,					/* in */
+			void *table,				/* in/out */
+			void *extra_state			/* in */
+			)
+{
+	(void) comm;
+	(void) keyval;
+	(void) extra_state;
+	free(table);
+	return MPI_SUCCESS;
+}
+
+/*
+ * Root sends every field to every other process, like chap04/get_data.c
+ */
+static void Linear_bcast(PARAM_BLOCK_T *block,	/* in/out */
+			int root,							/* in */
+			MPI_Comm comm						/* in */
+			)
+{
+	int my_rank, p;
+	int dest;
+
+	MPI_Comm_rank(comm, &my_rank);
+	MPI_Comm_size(comm, &p);
+
+	if( my_rank == root )
+	{
+		for( dest = 0 ; dest < p ; dest++ )
+		{
+			if( dest != root )
+			{
+				MPI_Send(block->floats, block->no_of_floats, MPI_FLOAT, dest, PARAM_BCAST_TAG, comm);
+				MPI_Send(block->ints, block->no_of_ints, MPI_INT, dest, PARAM_BCAST_TAG + 1, comm);
+			}
+		}
+	}
+	else
+	{
+		MPI_Recv(block->floats, block->no_of_floats, MPI_FLOAT, root, PARAM_BCAST_TAG, comm, MPI_STATUS_IGNORE);
+		MPI_Recv(block->ints, block->no_of_ints, MPI_INT, root, PARAM_BCAST_TAG + 1, comm, MPI_STATUS_IGNORE);
+	}
+}
+
+/*
+ * One derived datatype over the floats and the ints, like chap06/get_data3.c.
+ * The displacements are absolute addresses, so the broadcast is from MPI_BOTTOM.
+ */
+static void Struct_bcast(PARAM_BLOCK_T *block,	/* in/out */
+			int root,							/* in */
+			MPI_Comm comm						/* in */
+			)
+{
+	int block_lengths[2];
+	MPI_Aint displacements[2];
+	MPI_Datatype typelist[2] = { MPI_FLOAT, MPI_INT };
+	MPI_Datatype param_mpi_t;
+
+	block_lengths[0] = block->no_of_floats;
+	block_lengths[1] = block->no_of_ints;
+	MPI_Get_address(block->floats, &displacements[0]);
+	MPI_Get_address(block->ints, &displacements[1]);
+
+	MPI_Type_create_struct(2, block_lengths, displacements, typelist, &param_mpi_t);
+	MPI_Type_commit(&param_mpi_t);
+	MPI_Bcast(MPI_BOTTOM, 1, param_mpi_t, root, comm);
+	MPI_Type_free(&param_mpi_t);
+}
+
+/*
+ * Pack both fields into one buffer, like chap06/get_data4.c
+ */
+static void Pack_bcast(PARAM_BLOCK_T *block,	/* in/out */
+			int root,							/* in */
+			MPI_Comm comm						/* in */
+			)
+{
+	int my_rank;
+	int float_bytes, int_bytes;
+	int buffer_size;
+	int position = 0;
+	char *buffer;
+
+	MPI_Comm_rank(comm, &my_rank);
+	MPI_Pack_size(block->no_of_floats, MPI_FLOAT, comm, &float_bytes);
+	MPI_Pack_size(block->no_of_ints, MPI_INT, comm, &int_bytes);
+	buffer_size = float_bytes + int_bytes;
+	buffer = malloc(buffer_size > 0 ? buffer_size : 1);
+
+	if( my_rank == root )
+	{
+		MPI_Pack(block->floats, block->no_of_floats, MPI_FLOAT, buffer, buffer_size, &position, comm);
+		MPI_Pack(block->ints, block->no_of_ints, MPI_INT, buffer, buffer_size, &position, comm);
+		MPI_Bcast(buffer, buffer_size, MPI_PACKED, root, comm);
+	}
+	else
+	{
+		MPI_Bcast(buffer, buffer_size, MPI_PACKED, root, comm);
+		MPI_Unpack(buffer, buffer_size, &position, block->floats, block->no_of_floats, MPI_FLOAT, comm);
+		MPI_Unpack(buffer, buffer_size, &position, block->ints, block->no_of_ints, MPI_INT, comm);
+	}
+
+	free(buffer);
+}
+
+/*
+ * Broadcast block from root with the given strategy
+ */
+void Param_bcast_with(PARAM_STRATEGY_T strategy,	/* in */
+			PARAM_BLOCK_T *block,					/* in/out */
+			int root,								/* in */
+			MPI_Comm comm							/* in */
+			)
+{
+	switch( strategy )
+	{
+	case PARAM_LINEAR:
+		Linear_bcast(block, root, comm);
+		break;
+	case PARAM_TREE:
+		Tree_bcast(block->floats, block->no_of_floats, MPI_FLOAT, root, comm, TREE_BINOMIAL, 0, 0);
+		Tree_bcast(block->ints, block->no_of_ints, MPI_INT, root, comm, TREE_BINOMIAL, 0, 0);
+		break;
+	case PARAM_BCAST:
+		MPI_Bcast(block->floats, block->no_of_floats, MPI_FLOAT, root, comm);
+		MPI_Bcast(block->ints, block->no_of_ints, MPI_INT, root, comm);
+		break;
+	case PARAM_PACK:
+		Pack_bcast(block, root, comm);
+		break;
+	case PARAM_STRUCT:
+	default:
+		Struct_bcast(block, root, comm);
+		break;
+	}
+}
+
+/*
+ * Best over CALIBRATE_TRIALS of the slowest process's time for one broadcast
+ */
+double Param_bcast_time(PARAM_STRATEGY_T strategy,	/* in */
+			PARAM_BLOCK_T *block,					/* in/out */
+			int root,								/* in */
+			MPI_Comm comm							/* in */
+			)
+{
+	double start, elapsed, max_elapsed;
+	double best = 0.0;
+	int trial, rep;
+
+	for( trial = 0 ; trial < CALIBRATE_TRIALS ; trial++ )
+	{
+		MPI_Barrier(comm);
+		start = MPI_Wtime();
+		for( rep = 0 ; rep < CALIBRATE_REPS ; rep++ )
+		{
+			Param_bcast_with(strategy, block, root, comm);
+		}
+		elapsed = (MPI_Wtime() - start) / CALIBRATE_REPS;
+
+		MPI_Allreduce(&elapsed, &max_elapsed, 1, MPI_DOUBLE, MPI_MAX, comm);
+		if( trial == 0 || max_elapsed < best )
+		{
+			best = max_elapsed;
+		}
+	}
+
+	return best;
+}
+
+/********************************************************************/
+/* Function Param_bcast_calibrate
+ * For every size 2^(MIN_LOG_BYTES + s) bytes, half floats and half
+ * ints, time each strategy from process 0 and remember the fastest
+ * in a table cached with comm, replacing any earlier one.
+ ********************************************************************/
+void Param_bcast_calibrate(MPI_Comm comm	/* in */)
+{
+	PARAM_STRATEGY_T *fastest;
+	PARAM_BLOCK_T block;
+	double seconds, best_seconds;
+	int bytes;
+	int size, strategy;
+
+	if( param_key == MPI_KEYVAL_INVALID )
+	{
+		MPI_Comm_create_keyval(MPI_COMM_NULL_COPY_FN, Free_table, &param_key, NULL);
+	}
+	fastest = malloc(NO_OF_SIZES * sizeof(PARAM_STRATEGY_T));
+	block.floats = calloc(PARAM_MAX_BYTES / 2 / sizeof(float), sizeof(float));
+	block.ints = calloc(PARAM_MAX_BYTES / 2 / sizeof(int), sizeof(int));
+
+	for( size = 0 ; size < NO_OF_SIZES ; size++ )
+	{
+		bytes = 1 << (MIN_LOG_BYTES + size);
+		block.no_of_floats = bytes / 2 / sizeof(float);
+		block.no_of_ints = bytes / 2 / sizeof(int);
+
+		best_seconds = 0.0;
+		for( strategy = 0 ; strategy < NO_OF_PARAM_STRATEGIES ; strategy++ )
+		{
+			seconds = Param_bcast_time(strategy, &block, 0, comm);
+			if( strategy == 0 || seconds < best_seconds )
+			{
+				best_seconds = seconds;
+				fastest[size] = strategy;
+			}
+		}
+	}
+	MPI_Comm_set_attr(comm, param_key, fastest);
+
+	free(block.floats);
+	free(block.ints);
+}
+
+/*
+ * Strategy for a block of bytes bytes on comm : the one measured on comm
+ * for the smallest calibrated size that holds it
+ */
+PARAM_STRATEGY_T Param_bcast_choice(int bytes,	/* in */
+			MPI_Comm comm						/* in */
+			)
+{
+	PARAM_STRATEGY_T *fastest;
+	int flag = 0;
+	int size = 0;
+
+	if( param_key != MPI_KEYVAL_INVALID )
+	{
+		MPI_Comm_get_attr(comm, param_key, &fastest, &flag);
+	}
+	if( !flag )
+	{
+		return PARAM_STRUCT;
+	}
+	while( size < NO_OF_SIZES - 1 && (1 << (MIN_LOG_BYTES + size)) < bytes )
+	{
+		size++;
+	}
+	return fastest[size];
+}
+
+/*
+ * Broadcast block from root with the fastest strategy for its size
+ */
+void Param_bcast(PARAM_BLOCK_T *block,	/* in/out */
+			int root,					/* in */
+			MPI_Comm comm				/* in */
+			)
+{
+	int bytes = block->no_of_floats * (int) sizeof(float) + block->no_of_ints * (int) sizeof(int);
+
+	Param_bcast_with(Param_bcast_choice(bytes, comm), block, root, comm);
+}
@@ -0,0 +1,80 @@
+/*
+ * param_bcast.h
+ *
+ *  Created on: 16-Oct-2026
+ *      Author: prateek
+ *      Desc : Header for param_bcast.c -- the five ways of the book to get input
+ *      	parameters to every process, and a broadcast that picks the fastest one.
+ */
+#ifndef PARAM_BCAST_H
+#define PARAM_BCAST_H
+
+#include <mpi/mpi.h>
+
+/* Tags used by PARAM_LINEAR for the floats and the ints */
+#define PARAM_BCAST_TAG		7101
+
+/* Largest block (in bytes) the calibration covers */
+#define PARAM_MAX_BYTES		16384
+
+/* The ways to ship a parameter block */
+typedef enum {
+	PARAM_LINEAR,		/* Root sends each field to each process (chap04/get_data.c)   */
+	PARAM_TREE,			/* Binomial tree, one message per field (chap05/get_data1.c)   */
+	PARAM_BCAST,		/* One MPI_Bcast per field (chap05/get_data2.c)                */
+	PARAM_STRUCT,		/* One MPI_Bcast of a struct datatype (chap06/get_data3.c)     */
+	PARAM_PACK,			/* MPI_Pack, one MPI_Bcast, MPI_Unpack (chap06/get_data4.c)    */
+	NO_OF_PARAM_STRATEGIES
+} PARAM_STRATEGY_T;
+
+/* A block of parameters : floats and ints, like a, b and n.
+ * Every process must know the counts before the broadcast. */
+typedef struct {
+	float *floats;
+	int no_of_floats;
+	int *ints;
+	int no_of_ints;
+} PARAM_BLOCK_T;
+
+extern const char *param_strategy_names[NO_OF_PARAM_STRATEGIES];
+
+/* Broadcast block from root with the given strategy */
+void Param_bcast_with(
+		PARAM_STRATEGY_T strategy,	/* in */
+		PARAM_BLOCK_T *block,		/* in/out */
+		int root,					/* in */
+		MPI_Comm comm				/* in */
+		);
+
+/* Best over a few trials of the slowest process's time for one
+ * Param_bcast_with. Collective over comm, every process gets the same time */
+double Param_bcast_time(
+		PARAM_STRATEGY_T strategy,	/* in */
+		PARAM_BLOCK_T *block,		/* in/out */
+		int root,					/* in */
+		MPI_Comm comm				/* in */
+		);
+
+/* Time every strategy on comm for block sizes up to PARAM_MAX_BYTES and
+ * remember the fastest per size, cached with comm ( not with its
+ * duplicates ). Collective over comm; every process ends up with the
+ * same table */
+void Param_bcast_calibrate(
+		MPI_Comm comm				/* in */
+		);
+
+/* Strategy Param_bcast will use for a block of bytes bytes on comm */
+PARAM_STRATEGY_T Param_bcast_choice(
+		int bytes,					/* in */
+		MPI_Comm comm				/* in */
+		);
+
+/* Broadcast block from root with the fastest strategy measured on comm,
+ * PARAM_STRUCT if Param_bcast_calibrate was not called on comm */
+void Param_bcast(
+		PARAM_BLOCK_T *block,		/* in/out */
+		int root,					/* in */
+		MPI_Comm comm				/* in */
+		);
+
+#endif /* PARAM_BCAST_H */
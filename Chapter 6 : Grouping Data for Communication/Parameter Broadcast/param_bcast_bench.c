@@ -0,0 +1,204 @@
+/*
+ * param_bcast_bench.c
+ *
+ *  Created on: 16-Oct-2026
+ *      Author: prateek
+ *      Desc : Times the five ways of getting the input parameters to every process
+ *      	(linear sends, tree, one MPI_Bcast per field, struct datatype, MPI_Pack)
+ *      	for parameter blocks from the 12 bytes of a, b and n up to 8 KB, on 2, 4,
+ *      	8, ... and p processes.
+ *      Input : None
+ *      Output :
+ *      	For every no of processes and every block size : the time of one
+ *      	broadcast with each strategy (slowest process, best of the trials) and the
+ *      	fastest one. Then the strategy Param_bcast picks for every size after
+ *      	calibrating on all the processes.
+ *
+ *      Algorithm:
+ *      1) The first q processes of MPI_COMM_WORLD are split off into their own
+ *         communicator, for q = 2, 4, 8, ... and q = p.
+ *      2) A block of SCALE floats and SCALE/2 ints is shaped like a, b and n
+ *         (SCALE = 2 is exactly a, b and n). For every strategy first check that
+ *         the block arrives intact on every process, then time it.
+ *      3) Param_bcast_calibrate on MPI_COMM_WORLD and print its choices.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <mpi/mpi.h>
+#include "param_bcast.h"
+
+#define MAX_SCALE	1366	/* 1366 floats + 683 ints = 8196 bytes */
+
+static const int scales[] = { 2, 8, 32, 128, 512, MAX_SCALE };
+#define NO_OF_SCALES	((int) (sizeof(scales) / sizeof(scales[0])))
+
+void Fill_block(PARAM_BLOCK_T *block, int scale, int my_rank);
+int Check(PARAM_STRATEGY_T strategy, PARAM_BLOCK_T *block, int scale, int my_rank, MPI_Comm comm);
+void Time_group(int q, int my_rank, PARAM_BLOCK_T *block);
+
+int main(int argc, char **argv)
+{
+	int my_rank;
+	int no_of_process;
+	PARAM_BLOCK_T block;
+	int q;
+	int bytes;
+
+	MPI_Init(&argc, &argv);
+	MPI_Comm_rank(MPI_COMM_WORLD, &my_rank);
+	MPI_Comm_size(MPI_COMM_WORLD, &no_of_process);
+
+	block.floats = malloc(MAX_SCALE * sizeof(float));
+	block.ints = malloc((MAX_SCALE / 2) * sizeof(int));
+
+	for( q = 2 ; q < 2 * no_of_process ; q *= 2 )
+	{
+		if( q > no_of_process )
+		{
+			q = no_of_process;
+		}
+		Time_group(q, my_rank, &block);
+		if( q == no_of_process )
+		{
+			break;
+		}
+	}
+
+	Param_bcast_calibrate(MPI_COMM_WORLD);
+	if( my_rank == 0 )
+	{
+		printf("Param_bcast on %d processes picks : \n", no_of_process);
+		for( bytes = 8 ; bytes <= PARAM_MAX_BYTES ; bytes *= 2 )
+		{
+			printf("%10d bytes : %s \n", bytes, param_strategy_names[Param_bcast_choice(bytes, MPI_COMM_WORLD)]);
+		}
+	}
+
+	free(block.floats);
+	free(block.ints);
+	MPI_Finalize();
+
+	return 0;
+}
+
+/********************************************************************/
+/* Function Time_group
+ * Times every strategy for every block size on the first q processes
+ * of MPI_COMM_WORLD. Collective over MPI_COMM_WORLD.
+ ********************************************************************/
+void Time_group(int q,				/* in */
+			int my_rank,			/* in */
+			PARAM_BLOCK_T *block	/* scratch */
+			)
+{
+	MPI_Comm comm;
+	double seconds[NO_OF_PARAM_STRATEGIES];
+	int s, strategy, best;
+
+	MPI_Comm_split(MPI_COMM_WORLD, (my_rank < q) ? 0 : MPI_UNDEFINED, my_rank, &comm);
+	if( comm == MPI_COMM_NULL )
+	{
+		return;
+	}
+
+	if( my_rank == 0 )
+	{
+		printf("Broadcast time in microseconds , p = %d \n", q);
+		printf("%10s", "bytes");
+		for( strategy = 0 ; strategy < NO_OF_PARAM_STRATEGIES ; strategy++ )
+		{
+			printf(" %10s", param_strategy_names[strategy]);
+		}
+		printf("   fastest \n");
+	}
+
+	for( s = 0 ; s < NO_OF_SCALES ; s++ )
+	{
+		for( strategy = 0 ; strategy < NO_OF_PARAM_STRATEGIES ; strategy++ )
+		{
+			if( !Check(strategy, block, scales[s], my_rank, comm) )
+			{
+				if( my_rank == 0 )
+				{
+					fprintf(stderr, "%s delivered wrong data for scale %d \n", param_strategy_names[strategy],
+							scales[s]);
+				}
+				MPI_Abort(MPI_COMM_WORLD, 1);
+			}
+			seconds[strategy] = Param_bcast_time(strategy, block, 0, comm);
+		}
+
+		if( my_rank == 0 )
+		{
+			best = 0;
+			printf("%10d", block->no_of_floats * (int) sizeof(float) + block->no_of_ints * (int) sizeof(int));
+			for( strategy = 0 ; strategy < NO_OF_PARAM_STRATEGIES ; strategy++ )
+			{
+				printf(" %10.2f", seconds[strategy] * 1.0e6);
+				if( seconds[strategy] < seconds[best] )
+				{
+					best = strategy;
+				}
+			}
+			printf("   %s \n", param_strategy_names[best]);
+		}
+	}
+
+	if( my_rank == 0 )
+	{
+		printf("\n");
+	}
+	MPI_Comm_free(&comm);
+}
+
+/*
+ * Sizes the block for scale; process 0 gets the values, the others zeros
+ */
+void Fill_block(PARAM_BLOCK_T *block,	/* out */
+			int scale,					/* in */
+			int my_rank					/* in */
+			)
+{
+	int i;
+
+	block->no_of_floats = scale;
+	block->no_of_ints = scale / 2;
+	for( i = 0 ; i < block->no_of_floats ; i++ )
+	{
+		block->floats[i] = (my_rank == 0) ? 0.5f * i + scale : 0.0f;
+	}
+	for( i = 0 ; i < block->no_of_ints ; i++ )
+	{
+		block->ints[i] = (my_rank == 0) ? 3 * i - scale : 0;
+	}
+}
+
+/*
+ * Returns 1 on every process if every process got the right block
+ */
+int Check(PARAM_STRATEGY_T strategy,	/* in */
+			PARAM_BLOCK_T *block,		/* scratch */
+			int scale,					/* in */
+			int my_rank,				/* in */
+			MPI_Comm comm				/* in */
+			)
+{
+	int ok = 1;
+	int all_ok;
+	int i;
+
+	Fill_block(block, scale, my_rank);
+	Param_bcast_with(strategy, block, 0, comm);
+
+	for( i = 0 ; i < block->no_of_floats ; i++ )
+	{
+		ok &= (block->floats[i] == 0.5f * i + scale);
+	}
+	for( i = 0 ; i < block->no_of_ints ; i++ )
+	{
+		ok &= (block->ints[i] == 3 * i - scale);
+	}
+
+	MPI_Allreduce(&ok, &all_ok, 1, MPI_INT, MPI_MIN, comm);
+	return all_ok;
+}
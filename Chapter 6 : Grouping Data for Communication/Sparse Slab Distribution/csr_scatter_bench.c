@@ -0,0 +1,389 @@
+/*
+ * csr_scatter_bench.c
+ *
+ *  Created on: 16-Oct-2026
+ *      Author: prateek
+ *      Desc : Process 0 builds a sparse matrix and hands out its block rows,
+ *      	with Csr_scatter_slabs of csr_slab.c and the way of chap06/sparse_row.c,
+ *      	one MPI_PACKED message per row ( with a buffer sized by MPI_Pack_size,
+ *      	so long rows do not overrun it ).
+ *      Input :
+ *      	n : order of the matrix
+ *      	m : mean no of nonzeros in a row
+ *      Output :
+ *      	Nonzeros and messages of each way, the time to hand out the matrix
+ *      	( slowest process ), and whether every process got its rows right.
+ *
+ *      NOTES:
+ *      	1. Row i has 1 + (7919 i) % (2m - 1) nonzeros, and every LONG_EVERY'th
+ *      	   row LONG_ROW of them, far more than fit in sparse_row.c's HUGE bytes.
+ *      	   Entry k of row i is (i + 3k) % 1000 in column (i + 97k) % n, so
+ *      	   every process can check its rows from the formula.
+ *      	2. The row by row way is skipped above PACK_ROWS_MAX rows; it needs a
+ *      	   message per row and takes too long.
+ *      	3. n = 10^7 , m = 10 gives 10^8 nonzeros, about 800 MB on process 0.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <mpi/mpi.h>
+#include "csr_slab.h"
+
+#define LONG_EVERY		10007
+#define LONG_ROW		1000
+#define PACK_ROWS_MAX	(1 << 21)
+#define ROW_TAG			7403
+
+void Get_data(int *n_ptr, int *m_ptr, int my_rank);
+void Block_range(int n, int no_of_blocks, int block, int *first_ptr, int *count_ptr);
+int Row_length(int i, int m);
+int Generate_matrix(int n, int m, CSR_BLOCK_T *matrix);
+int Scatter_rows_packed(const CSR_BLOCK_T *matrix, const int first_rows[], int my_rows, MPI_Comm comm,
+		CSR_BLOCK_T *slab);
+int Check_slab(const CSR_BLOCK_T *slab, int first_row, int n, int m);
+
+int main(int argc, char **argv)
+{
+	int my_rank;
+	int p;
+	int n, m;
+	int *first_rows;
+	int first_row, local_n;
+	CSR_BLOCK_T matrix, slab;
+	long long nonzeros = 0, entries;
+	double start, elapsed, seconds[2] = { 0.0, 0.0 };
+	int ok, slab_ok = 1, pack_ok = 1, packed = 0;
+	int slab_messages = 0;
+	int q;
+
+	MPI_Init(&argc, &argv);
+	MPI_Comm_size(MPI_COMM_WORLD, &p);
+	MPI_Comm_rank(MPI_COMM_WORLD, &my_rank);
+
+	Get_data(&n, &m, my_rank);
+
+	first_rows = malloc((p + 1) * sizeof(int));
+	for( q = 0 ; q < p ; q++ )
+	{
+		Block_range(n, p, q, &first_rows[q], &local_n);
+	}
+	first_rows[p] = n;
+	Block_range(n, p, my_rank, &first_row, &local_n);
+
+	memset(&matrix, 0, sizeof(CSR_BLOCK_T));
+	ok = 1;
+	if( my_rank == 0 )
+	{
+		ok = Generate_matrix(n, m, &matrix);
+		if( ok )
+		{
+			nonzeros = matrix.row_start[n];
+			for( q = 1 ; q < p ; q++ )
+			{
+				entries = first_rows[q + 1] - first_rows[q] + 1
+						+ 2LL * (matrix.row_start[first_rows[q + 1]] - matrix.row_start[first_rows[q]]);
+				slab_messages += (int) ((entries + SLAB_CHUNK_ENTRIES - 1) / SLAB_CHUNK_ENTRIES);
+			}
+		}
+	}
+	MPI_Bcast(&ok, 1, MPI_INT, 0, MPI_COMM_WORLD);
+	if( !ok )
+	{
+		if( my_rank == 0 )
+		{
+			fprintf(stderr, "Cannot allocate the matrix, or it has 2^31 nonzeros or more \n");
+		}
+		MPI_Finalize();
+		return 0;
+	}
+
+	/* Whole slabs */
+	MPI_Barrier(MPI_COMM_WORLD);
+	start = MPI_Wtime();
+	ok = Csr_scatter_slabs(&matrix, first_rows, 0, MPI_COMM_WORLD, &slab);
+	elapsed = MPI_Wtime() - start;
+	MPI_Reduce(&elapsed, &seconds[0], 1, MPI_DOUBLE, MPI_MAX, 0, MPI_COMM_WORLD);
+	slab_ok = ok && Check_slab(&slab, first_row, n, m);
+	Csr_slab_free(&slab);
+	MPI_Allreduce(MPI_IN_PLACE, &slab_ok, 1, MPI_INT, MPI_MIN, MPI_COMM_WORLD);
+
+	/* A packed message per row */
+	if( n <= PACK_ROWS_MAX )
+	{
+		packed = 1;
+		MPI_Barrier(MPI_COMM_WORLD);
+		start = MPI_Wtime();
+		ok = Scatter_rows_packed(&matrix, first_rows, local_n, MPI_COMM_WORLD, &slab);
+		elapsed = MPI_Wtime() - start;
+		MPI_Reduce(&elapsed, &seconds[1], 1, MPI_DOUBLE, MPI_MAX, 0, MPI_COMM_WORLD);
+		pack_ok = ok && Check_slab(&slab, first_row, n, m);
+		Csr_slab_free(&slab);
+		MPI_Allreduce(MPI_IN_PLACE, &pack_ok, 1, MPI_INT, MPI_MIN, MPI_COMM_WORLD);
+	}
+
+	if( my_rank == 0 )
+	{
+		printf("n = %d , %lld nonzeros , p = %d \n", n, nonzeros, p);
+		printf("whole slabs     : %6d messages %e s , rows %s \n", slab_messages, seconds[0],
+				slab_ok ? "right" : "WRONG");
+		if( packed )
+		{
+			printf("packed per row  : %6d messages %e s , rows %s \n", n - (first_rows[1] - first_rows[0]),
+					seconds[1], pack_ok ? "right" : "WRONG");
+		}
+		else
+		{
+			printf("packed per row  : skipped, more than %d rows \n", PACK_ROWS_MAX);
+		}
+	}
+
+	Csr_slab_free(&matrix);
+	free(first_rows);
+	MPI_Finalize();
+
+	return 0;
+}
+
+/*
+ * Process 0 reads the order and the mean row length and broadcasts them
+ */
+void Get_data(int *n_ptr,	/* out */
+			int *m_ptr,		/* out */
+			int my_rank		/* in */
+			)
+{
+	int data[2];
+
+	if( my_rank == 0 )
+	{
+		printf("Enter the order of the matrix and the mean nonzeros in a row\n");
+		scanf("%d %d", &data[0], &data[1]);
+	}
+
+	MPI_Bcast(data, 2, MPI_INT, 0, MPI_COMM_WORLD);
+	*n_ptr = data[0];
+	*m_ptr = (data[1] < 1) ? 1 : data[1];
+}
+
+/*
+ * First index and length of block number block of n split into no_of_blocks.
+ * The first n % no_of_blocks blocks get one more.
+ */
+void Block_range(int n,			/* in */
+			int no_of_blocks,	/* in */
+			int block,			/* in */
+			int *first_ptr,		/* out */
+			int *count_ptr		/* out */
+			)
+{
+	int quotient = n / no_of_blocks;
+	int remainder = n % no_of_blocks;
+
+	*count_ptr = quotient + (block < remainder ? 1 : 0);
+	*first_ptr = block * quotient + (block < remainder ? block : remainder);
+}
+
+/*
+ * Nonzeros in row i ( see NOTES )
+ */
+int Row_length(int i,	/* in */
+			int m		/* in */
+			)
+{
+	if( i % LONG_EVERY == LONG_EVERY - 1 )
+	{
+		return LONG_ROW;
+	}
+	return 1 + (int) ((7919LL * i) % (2 * m - 1));
+}
+
+/*
+ * The whole matrix in CSR form. Returns 0 if there is not enough memory
+ * or the nonzeros do not fit in an int
+ */
+int Generate_matrix(int n,			/* in */
+			int m,					/* in */
+			CSR_BLOCK_T *matrix		/* out */
+			)
+{
+	long long nonzeros = 0;
+	int i, k, length;
+
+	matrix->rows = n;
+	matrix->row_start = malloc(((size_t) n + 1) * sizeof(int));
+	if( matrix->row_start == NULL )
+	{
+		return 0;
+	}
+	for( i = 0 ; i < n ; i++ )
+	{
+		matrix->row_start[i] = (int) nonzeros;
+		nonzeros += Row_length(i, m);
+		if( nonzeros > 0x7fffffffLL )
+		{
+			return 0;
+		}
+	}
+	matrix->row_start[n] = (int) nonzeros;
+
+	matrix->cols = malloc(((size_t) nonzeros + 1) * sizeof(int));
+	matrix->values = malloc(((size_t) nonzeros + 1) * sizeof(float));
+	if( matrix->cols == NULL || matrix->values == NULL )
+	{
+		return 0;
+	}
+	for( i = 0 ; i < n ; i++ )
+	{
+		length = matrix->row_start[i + 1] - matrix->row_start[i];
+		for( k = 0 ; k < length ; k++ )
+		{
+			matrix->cols[matrix->row_start[i] + k] = (int) ((i + 97LL * k) % n);
+			matrix->values[matrix->row_start[i] + k] = (float) ((i + 3 * k) % 1000);
+		}
+	}
+	return 1;
+}
+
+/********************************************************************/
+/* Function Scatter_rows_packed
+ * The rows of process q go from process 0 one at a time as in
+ * chap06/sparse_row.c : the nonzeros, the row number, the entries and
+ * the columns packed into one MPI_PACKED message. The buffer is sized
+ * with MPI_Pack_size, and the receiver probes for the size of each
+ * message. Process 0 copies its own rows. Returns 0 if there is not
+ * enough memory.
+ ********************************************************************/
+int Scatter_rows_packed(const CSR_BLOCK_T *matrix,	/* in ( process 0 ) */
+			const int first_rows[],				/* in */
+			int my_rows,						/* in */
+			MPI_Comm comm,						/* in */
+			CSR_BLOCK_T *slab					/* out */
+			)
+{
+	int my_rank;
+	int p;
+	char *buffer = NULL;
+	int buffer_size = 0, size, part;
+	int position;
+	int nonzeros, row_number, capacity;
+	MPI_Status status;
+	int q, i, row;
+
+	MPI_Comm_size(comm, &p);
+	MPI_Comm_rank(comm, &my_rank);
+
+	capacity = 1024;
+	slab->rows = my_rows;
+	slab->row_start = malloc((my_rows + 1) * sizeof(int));
+	slab->cols = malloc(capacity * sizeof(int));
+	slab->values = malloc(capacity * sizeof(float));
+	if( slab->row_start == NULL || slab->cols == NULL || slab->values == NULL )
+	{
+		return 0;
+	}
+	slab->row_start[0] = 0;
+
+	if( my_rank == 0 )
+	{
+		for( q = 1 ; q < p ; q++ )
+		{
+			for( row = first_rows[q] ; row < first_rows[q + 1] ; row++ )
+			{
+				nonzeros = matrix->row_start[row + 1] - matrix->row_start[row];
+				MPI_Pack_size(2, MPI_INT, comm, &size);
+				MPI_Pack_size(nonzeros, MPI_FLOAT, comm, &part);
+				size += part;
+				MPI_Pack_size(nonzeros, MPI_INT, comm, &part);
+				size += part;
+				if( size > buffer_size )
+				{
+					free(buffer);
+					buffer_size = 2 * size;
+					buffer = malloc(buffer_size);
+					if( buffer == NULL )
+					{
+						return 0;
+					}
+				}
+				position = 0;
+				MPI_Pack(&nonzeros, 1, MPI_INT, buffer, buffer_size, &position, comm);
+				MPI_Pack(&row, 1, MPI_INT, buffer, buffer_size, &position, comm);
+				MPI_Pack(&matrix->values[matrix->row_start[row]], nonzeros, MPI_FLOAT, buffer, buffer_size,
+						&position, comm);
+				MPI_Pack(&matrix->cols[matrix->row_start[row]], nonzeros, MPI_INT, buffer, buffer_size,
+						&position, comm);
+				MPI_Send(buffer, position, MPI_PACKED, q, ROW_TAG, comm);
+			}
+		}
+		nonzeros = matrix->row_start[first_rows[1]];
+		if( nonzeros > capacity )
+		{
+			slab->cols = realloc(slab->cols, nonzeros * sizeof(int));
+			slab->values = realloc(slab->values, nonzeros * sizeof(float));
+		}
+		memcpy(slab->row_start, matrix->row_start, (my_rows + 1) * sizeof(int));
+		memcpy(slab->cols, matrix->cols, nonzeros * sizeof(int));
+		memcpy(slab->values, matrix->values, nonzeros * sizeof(float));
+	}
+	else
+	{
+		for( i = 0 ; i < my_rows ; i++ )
+		{
+			MPI_Probe(0, ROW_TAG, comm, &status);
+			MPI_Get_count(&status, MPI_PACKED, &size);
+			if( size > buffer_size )
+			{
+				free(buffer);
+				buffer_size = 2 * size;
+				buffer = malloc(buffer_size);
+				if( buffer == NULL )
+				{
+					return 0;
+				}
+			}
+			MPI_Recv(buffer, buffer_size, MPI_PACKED, 0, ROW_TAG, comm, MPI_STATUS_IGNORE);
+			position = 0;
+			MPI_Unpack(buffer, buffer_size, &position, &nonzeros, 1, MPI_INT, comm);
+			MPI_Unpack(buffer, buffer_size, &position, &row_number, 1, MPI_INT, comm);
+			while( slab->row_start[i] + nonzeros > capacity )
+			{
+				capacity *= 2;
+				slab->cols = realloc(slab->cols, capacity * sizeof(int));
+				slab->values = realloc(slab->values, capacity * sizeof(float));
+			}
+			MPI_Unpack(buffer, buffer_size, &position, &slab->values[slab->row_start[i]], nonzeros, MPI_FLOAT,
+					comm);
+			MPI_Unpack(buffer, buffer_size, &position, &slab->cols[slab->row_start[i]], nonzeros, MPI_INT, comm);
+			slab->row_start[i + 1] = slab->row_start[i] + nonzeros;
+		}
+	}
+
+	free(buffer);
+	return slab->cols != NULL && slab->values != NULL;
+}
+
+/*
+ * 1 if slab holds rows first_row .. of the matrix of NOTES, counting from 0
+ */
+int Check_slab(const CSR_BLOCK_T *slab,	/* in */
+			int first_row,				/* in */
+			int n,						/* in */
+			int m						/* in */
+			)
+{
+	int ok = (slab->row_start[0] == 0);
+	int i, k, row, length;
+
+	for( i = 0 ; ok && i < slab->rows ; i++ )
+	{
+		row = first_row + i;
+		length = Row_length(row, m);
+		ok = (slab->row_start[i + 1] - slab->row_start[i] == length);
+		for( k = 0 ; ok && k < length ; k++ )
+		{
+			ok = (slab->cols[slab->row_start[i] + k] == (int) ((row + 97LL * k) % n)
+					&& slab->values[slab->row_start[i] + k] == (float) ((row + 3 * k) % 1000));
+		}
+	}
+	return ok;
+}
@@ -0,0 +1,260 @@
+/*
+ * csr_slab.c
+ *
+ *  Created on: 16-Oct-2026
+ *      Author: prateek
+ *      Desc : Block rows of a CSR matrix from one process to all of them.
+ *      	chap06/sparse_row.c packs a row into a buffer of HUGE bytes and sends
+ *      	it as MPI_PACKED, so a matrix goes as one message per row and a row
+ *      	longer than the buffer silently overruns it. Here a process's whole
+ *      	slab, row_start, cols and values, goes at once.
+ *
+ *      	The sizes go first : an MPI_Scatter gives every process the rows and
+ *      	nonzeros of its slab, so it can allocate before anything else
+ *      	arrives. Then the three arrays of the slab, taken one after the
+ *      	other, are cut into pieces of at most SLAB_CHUNK_ENTRIES ints and
+ *      	floats. Each piece is described by an MPI_Type_create_struct on the
+ *      	absolute addresses of its parts, as in Parameter Broadcast, and sent
+ *      	from MPI_BOTTOM. The sender sends straight out of the matrix and the
+ *      	receiver receives straight into its slab; nothing is packed or copied.
+ *
+ *      NOTES:
+ *      	1. A slab of up to 2^24 entries goes in one message. Bigger ones go
+ *      	   in a few messages of 64 MB, which keeps every count well inside an
+ *      	   int and lets the first pieces move while the last are still queued.
+ *      	2. row_start of the matrix and of the slabs are ints, so the matrix
+ *      	   can have up to 2^31 - 1 nonzeros.
+ */
+#include <stdlib.h>
+#include <string.h>
+#include "csr_slab.h"
+
+/*
+ * Datatype of entries first .. first + count - 1 of a slab, counting
+ * the rows + 1 entries of row_start, then the nonzeros of cols, then
+ * those of values. Displacements are absolute : send / receive from
+ * MPI_BOTTOM. The type is committed.
+ */
+static MPI_Datatype Chunk_type(int row_start[],	/* in */
+			int cols[],						/* in */
+			float values[],					/* in */
+			int rows,						/* in */
+			int nonzeros,					/* in */
+			long long first,				/* in */
+			int count						/* in */
+			)
+{
+	void *starts[3];
+	long long lengths[3];
+	MPI_Datatype types[3] = { MPI_INT, MPI_INT, MPI_FLOAT };
+	int block_lengths[3];
+	MPI_Aint displacements[3];
+	MPI_Datatype typelist[3];
+	MPI_Datatype chunk_mpi_t;
+	long long segment_start = 0, begin, end;
+	int no_of_blocks = 0;
+	int s;
+
+	starts[0] = row_start;
+	starts[1] = cols;
+	starts[2] = values;
+	lengths[0] = (long long) rows + 1;
+	lengths[1] = nonzeros;
+	lengths[2] = nonzeros;
+
+	for( s = 0 ; s < 3 ; s++ )
+	{
+		begin = (first > segment_start) ? first : segment_start;
+		end = (first + count < segment_start + lengths[s]) ? first + count : segment_start + lengths[s];
+		if( begin < end )
+		{
+			/* Ints and floats are both 4 bytes */
+			MPI_Get_address((char *) starts[s] + (begin - segment_start) * 4, &displacements[no_of_blocks]);
+			block_lengths[no_of_blocks] = (int) (end - begin);
+			typelist[no_of_blocks] = types[s];
+			no_of_blocks++;
+		}
+		segment_start += lengths[s];
+	}
+
+	MPI_Type_create_struct(no_of_blocks, block_lengths, displacements, typelist, &chunk_mpi_t);
+	MPI_Type_commit(&chunk_mpi_t);
+	return chunk_mpi_t;
+}
+
+/*
+ * Messages a slab of rows rows and nonzeros entries goes in
+ */
+static int No_of_chunks(int rows,	/* in */
+			int nonzeros			/* in */
+			)
+{
+	long long entries = (long long) rows + 1 + 2 * (long long) nonzeros;
+
+	return (int) ((entries + SLAB_CHUNK_ENTRIES - 1) / SLAB_CHUNK_ENTRIES);
+}
+
+/*
+ * Start sending ( send != 0 ) or receiving the chunks of a slab to / from
+ * partner, one request each in requests. Returns the no of requests
+ */
+static int Start_chunks(int send,	/* in */
+			int row_start[],		/* in/out */
+			int cols[],				/* in/out */
+			float values[],			/* in/out */
+			int rows,				/* in */
+			int nonzeros,			/* in */
+			int partner,			/* in */
+			MPI_Comm comm,			/* in */
+			MPI_Request requests[]	/* out */
+			)
+{
+	long long entries = (long long) rows + 1 + 2 * (long long) nonzeros;
+	long long first;
+	int count, k = 0;
+	MPI_Datatype chunk_mpi_t;
+
+	for( first = 0 ; first < entries ; first += SLAB_CHUNK_ENTRIES )
+	{
+		count = (entries - first < SLAB_CHUNK_ENTRIES) ? (int) (entries - first) : SLAB_CHUNK_ENTRIES;
+		chunk_mpi_t = Chunk_type(row_start, cols, values, rows, nonzeros, first, count);
+		if( send )
+		{
+			MPI_Isend(MPI_BOTTOM, 1, chunk_mpi_t, partner, SLAB_TAG, comm, &requests[k++]);
+		}
+		else
+		{
+			MPI_Irecv(MPI_BOTTOM, 1, chunk_mpi_t, partner, SLAB_TAG, comm, &requests[k++]);
+		}
+		/* Only marked for freeing : the request keeps it alive */
+		MPI_Type_free(&chunk_mpi_t);
+	}
+	return k;
+}
+
+/********************************************************************/
+/* Function Csr_scatter_slabs
+ * Algorithm:
+ *     1.  Root works out the rows and nonzeros of every slab and
+ *         scatters them, two ints per process.
+ *     2.  Every process allocates its slab; if any of them fails,
+ *         all return 0.
+ *     3.  Root starts sending every chunk of every other slab, the
+ *         others start receiving theirs, and root copies its own.
+ *     4.  Wait, then make row_start count from 0.
+ ********************************************************************/
+int Csr_scatter_slabs(const CSR_BLOCK_T *matrix,	/* in ( root ) */
+			const int first_rows[],				/* in ( root ) */
+			int root,							/* in */
+			MPI_Comm comm,						/* in */
+			CSR_BLOCK_T *slab					/* out */
+			)
+{
+	int my_rank;
+	int p;
+	int *sizes = NULL;
+	int my_sizes[2];
+	int rows, nonzeros, offset;
+	MPI_Request *requests = NULL;
+	int no_of_requests = 0;
+	int ok, q, i;
+
+	MPI_Comm_size(comm, &p);
+	MPI_Comm_rank(comm, &my_rank);
+	memset(slab, 0, sizeof(CSR_BLOCK_T));
+
+	/* 1. */
+	ok = 1;
+	if( my_rank == root )
+	{
+		sizes = malloc(2 * p * sizeof(int));
+		ok = (sizes != NULL);
+		for( q = 0 ; ok && q < p ; q++ )
+		{
+			sizes[2 * q] = first_rows[q + 1] - first_rows[q];
+			sizes[2 * q + 1] = matrix->row_start[first_rows[q + 1]] - matrix->row_start[first_rows[q]];
+		}
+	}
+	MPI_Bcast(&ok, 1, MPI_INT, root, comm);
+	if( !ok )
+	{
+		return 0;
+	}
+	MPI_Scatter(sizes, 2, MPI_INT, my_sizes, 2, MPI_INT, root, comm);
+
+	/* 2. */
+	slab->rows = my_sizes[0];
+	slab->row_start = malloc((my_sizes[0] + 1) * sizeof(int));
+	slab->cols = malloc(((size_t) my_sizes[1] + 1) * sizeof(int));
+	slab->values = malloc(((size_t) my_sizes[1] + 1) * sizeof(float));
+	if( my_rank == root )
+	{
+		for( q = 0 ; q < p ; q++ )
+		{
+			no_of_requests += (q == root) ? 0 : No_of_chunks(sizes[2 * q], sizes[2 * q + 1]);
+		}
+	}
+	else
+	{
+		no_of_requests = No_of_chunks(my_sizes[0], my_sizes[1]);
+	}
+	requests = malloc((no_of_requests + 1) * sizeof(MPI_Request));
+	ok = (slab->row_start != NULL && slab->cols != NULL && slab->values != NULL && requests != NULL);
+	MPI_Allreduce(MPI_IN_PLACE, &ok, 1, MPI_INT, MPI_MIN, comm);
+	if( !ok )
+	{
+		Csr_slab_free(slab);
+		free(requests);
+		free(sizes);
+		return 0;
+	}
+
+	/* 3. */
+	if( my_rank == root )
+	{
+		no_of_requests = 0;
+		for( q = 0 ; q < p ; q++ )
+		{
+			rows = sizes[2 * q];
+			nonzeros = sizes[2 * q + 1];
+			offset = matrix->row_start[first_rows[q]];
+			if( q == root )
+			{
+				memcpy(slab->row_start, &matrix->row_start[first_rows[q]], (rows + 1) * sizeof(int));
+				memcpy(slab->cols, &matrix->cols[offset], (size_t) nonzeros * sizeof(int));
+				memcpy(slab->values, &matrix->values[offset], (size_t) nonzeros * sizeof(float));
+			}
+			else
+			{
+				no_of_requests += Start_chunks(1, (int *) &matrix->row_start[first_rows[q]],
+						(int *) &matrix->cols[offset], (float *) &matrix->values[offset], rows, nonzeros, q, comm,
+						&requests[no_of_requests]);
+			}
+		}
+	}
+	else
+	{
+		Start_chunks(0, slab->row_start, slab->cols, slab->values, my_sizes[0], my_sizes[1], root, comm,
+				requests);
+	}
+
+	/* 4. */
+	MPI_Waitall(no_of_requests, requests, MPI_STATUSES_IGNORE);
+	offset = slab->row_start[0];
+	for( i = 0 ; i <= slab->rows ; i++ )
+	{
+		slab->row_start[i] -= offset;
+	}
+
+	free(requests);
+	free(sizes);
+	return 1;
+}
+
+void Csr_slab_free(CSR_BLOCK_T *slab	/* in/out */)
+{
+	free(slab->row_start);
+	free(slab->cols);
+	free(slab->values);
+	memset(slab, 0, sizeof(CSR_BLOCK_T));
+}
@@ -0,0 +1,42 @@
+/*
+ * csr_slab.h
+ *
+ *  Created on: 16-Oct-2026
+ *      Author: prateek
+ *      Desc : Header for csr_slab.c -- a sparse matrix in CSR form on one
+ *      	process handed out to all of them by block rows, each process getting
+ *      	its whole slab in a few large messages instead of a packed message
+ *      	per row ( chap06/sparse_row.c ).
+ */
+#ifndef CSR_SLAB_H
+#define CSR_SLAB_H
+
+#include <mpi/mpi.h>
+#include "dist_csr.h"
+
+/* Tag of the slab messages */
+#define SLAB_TAG			7402
+
+/* Most ints and floats in one message : 64 MB. A larger slab goes in
+ * ceil(( rows + 1 + 2 nonzeros ) / SLAB_CHUNK_ENTRIES ) messages */
+#define SLAB_CHUNK_ENTRIES	(1 << 24)
+
+/* Give process q rows first_rows[q] .. first_rows[q+1] - 1 of matrix,
+ * which only root needs to hold ( matrix and first_rows, p + 1 entries,
+ * are ignored elsewhere ). Every process gets its rows in slab, with
+ * row_start starting from 0 and the global columns. Collective over
+ * comm. Returns 0 on every process if memory ran out on any of them;
+ * nothing is sent then and slab is empty */
+int Csr_scatter_slabs(
+		const CSR_BLOCK_T *matrix,	/* in ( root ) */
+		const int first_rows[],		/* in ( root ) */
+		int root,					/* in */
+		MPI_Comm comm,				/* in */
+		CSR_BLOCK_T *slab			/* out */
+		);
+
+void Csr_slab_free(
+		CSR_BLOCK_T *slab			/* in/out */
+		);
+
+#endif /* CSR_SLAB_H */
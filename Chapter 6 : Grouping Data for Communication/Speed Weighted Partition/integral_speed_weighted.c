@@ -0,0 +1,304 @@
+/*
+ * integral_speed_weighted.c
+ *
+ *  Created on: 16-Oct-2026
+ *      Author: prateek
+ *      Desc : Parallel Trapezoidal Rule for processes of different speed.
+ *      Input :
+ *      	a, b : Limits of integration
+ *      	n : no of trapezoids
+ *      Output :
+ *      	Estimate of the integral from a to b of f(x), the share of the trapezoids
+ *      	given to every process and the elapsed time.
+ *
+ *      Algorithm:
+ *      1) Process 0 reads a, b and n and broadcasts them with one derived datatype,
+ *         as in Get_data3.
+ *      2) Every process times calculate_integral() on CALIBRATION_N trapezoids and
+ *         process 0 gathers the throughputs (trapezoids per second).
+ *      3) Process 0 hands out the n trapezoids in proportion to the throughputs.
+ *         What is left after rounding down goes, one trapezoid each, to the processes
+ *         with the largest fractional shares, so no trapezoid is dropped.
+ *      4) The (local_a, local_n) pair of every process is scattered with a derived
+ *         datatype built for PARTITION_T.
+ *      5) Each process integrates its interval and MPI_Reduce adds the results.
+ *
+ *      NOTE : f(x) is hardwired. n does not have to be divisible by the no of processes.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stddef.h>
+#include <mpi/mpi.h>
+
+#define CALIBRATION_N		65536	/* Trapezoids per calibration run */
+#define CALIBRATION_TIME	0.01	/* Min seconds spent calibrating */
+
+/* The part of [a,b] given to one process */
+typedef struct {
+	float local_a;
+	int local_n;
+} PARTITION_T;
+
+void Build_input_type(float *a_ptr, float *b_ptr, int *n_ptr, MPI_Datatype *input_mpi_t_ptr);
+void Build_partition_type(MPI_Datatype *partition_mpi_t_ptr);
+void Get_data(float *a_ptr, float *b_ptr, int *n_ptr, int my_rank);
+double Calibrate(void);
+void Partition(float a, float h, int n, double speed[], int no_of_process, PARTITION_T partition[]);
+float calculate_integral( float local_a, float local_b , int local_n , float h );
+float f(float x);
+
+int main(int argc, char **argv)
+{
+	int my_rank;					// My process rank
+	int no_of_process;				// No of processes
+	float a;						// Left endpoint
+	float b;						// Right endpoint
+	int n;							// No of trapezoids
+	float h;						// Trapezoids base length
+	double my_speed;				// My trapezoids per second
+	double *speed = NULL;			// Trapezoids per second of every process
+	PARTITION_T *partition = NULL;	// Share of every process
+	PARTITION_T my_partition;		// My share
+	MPI_Datatype partition_mpi_t;
+	float integral;					// Integral over my interval
+	float total;					// Total integral
+	double start, finish;
+	int process;
+
+	MPI_Init(&argc, &argv);
+	MPI_Comm_rank(MPI_COMM_WORLD, &my_rank);
+	MPI_Comm_size(MPI_COMM_WORLD, &no_of_process);
+
+	Get_data(&a, &b, &n, my_rank);
+	h = (b - a) / n;
+
+	MPI_Barrier(MPI_COMM_WORLD);
+	start = MPI_Wtime();
+
+	/* Measure how fast everyone is */
+	my_speed = Calibrate();
+	if( my_rank == 0 )
+	{
+		speed = malloc(no_of_process * sizeof(double));
+		partition = malloc(no_of_process * sizeof(PARTITION_T));
+	}
+	MPI_Gather(&my_speed, 1, MPI_DOUBLE, speed, 1, MPI_DOUBLE, 0, MPI_COMM_WORLD);
+
+	if( my_rank == 0 )
+	{
+		Partition(a, h, n, speed, no_of_process, partition);
+	}
+
+	/* Everyone gets its own (local_a, local_n) pair */
+	Build_partition_type(&partition_mpi_t);
+	MPI_Scatter(partition, 1, partition_mpi_t, &my_partition, 1, partition_mpi_t, 0, MPI_COMM_WORLD);
+	MPI_Type_free(&partition_mpi_t);
+
+	integral = 0.0;
+	if( my_partition.local_n > 0 )
+	{
+		integral = calculate_integral(my_partition.local_a,
+				my_partition.local_a + my_partition.local_n * h, my_partition.local_n, h);
+	}
+
+	MPI_Reduce(&integral, &total, 1, MPI_FLOAT, MPI_SUM, 0, MPI_COMM_WORLD);
+
+	MPI_Barrier(MPI_COMM_WORLD);
+	finish = MPI_Wtime();
+
+	if( my_rank == 0 )
+	{
+		printf("With n = %d trapezoids , our estimate \n", n);
+		printf("of the integral from %f to %f = %f \n", a, b, total);
+		for( process = 0 ; process < no_of_process ; process++ )
+		{
+			printf("Process %d ==> %e trapezoids/s , %d trapezoids from %f \n", process,
+					speed[process], partition[process].local_n, partition[process].local_a);
+		}
+		printf("Elapsed time in seconds (with calibration) = %e \n", finish - start);
+		free(speed);
+		free(partition);
+	}
+
+	MPI_Finalize();
+
+	return 0;
+}
+
+/********************************************************************/
+/* Function Build_input_type
+ * Builds a derived datatype holding a, b and n, as in get_data3.c
+ ********************************************************************/
+void Build_input_type(float *a_ptr,				/* in */
+			float *b_ptr,						/* in */
+			int *n_ptr,							/* in */
+			MPI_Datatype *input_mpi_t_ptr		/* out */
+			)
+{
+	int block_lengths[3] = { 1, 1, 1 };
+	MPI_Datatype typelist[3] = { MPI_FLOAT, MPI_FLOAT, MPI_INT };
+	MPI_Aint displacements[3];
+	MPI_Aint start_address;
+	MPI_Aint address;
+
+	/* Displacements relative to a */
+	MPI_Get_address(a_ptr, &start_address);
+	displacements[0] = 0;
+	MPI_Get_address(b_ptr, &address);
+	displacements[1] = address - start_address;
+	MPI_Get_address(n_ptr, &address);
+	displacements[2] = address - start_address;
+
+	MPI_Type_create_struct(3, block_lengths, displacements, typelist, input_mpi_t_ptr);
+	MPI_Type_commit(input_mpi_t_ptr);
+}
+
+/********************************************************************/
+/* Function Build_partition_type
+ * Builds a derived datatype matching PARTITION_T. The extent is set to
+ * sizeof(PARTITION_T) so an array of partitions can be scattered.
+ ********************************************************************/
+void Build_partition_type(MPI_Datatype *partition_mpi_t_ptr	/* out */)
+{
+	int block_lengths[2] = { 1, 1 };
+	MPI_Datatype typelist[2] = { MPI_FLOAT, MPI_INT };
+	MPI_Aint displacements[2] = { offsetof(PARTITION_T, local_a), offsetof(PARTITION_T, local_n) };
+	MPI_Datatype struct_mpi_t;
+
+	MPI_Type_create_struct(2, block_lengths, displacements, typelist, &struct_mpi_t);
+	MPI_Type_create_resized(struct_mpi_t, 0, sizeof(PARTITION_T), partition_mpi_t_ptr);
+	MPI_Type_commit(partition_mpi_t_ptr);
+	MPI_Type_free(&struct_mpi_t);
+}
+
+/*
+ * Process 0 reads a, b and n and broadcasts them with one derived datatype
+ */
+void Get_data(float *a_ptr,	/* out */
+			float *b_ptr,	/* out */
+			int *n_ptr,		/* out */
+			int my_rank		/* in */
+			)
+{
+	MPI_Datatype input_mpi_t;
+
+	if( my_rank == 0 )
+	{
+		printf("Enter a , b and n \n");
+		scanf("%f %f %d", a_ptr, b_ptr, n_ptr);
+	}
+
+	Build_input_type(a_ptr, b_ptr, n_ptr, &input_mpi_t);
+	MPI_Bcast(a_ptr, 1, input_mpi_t, 0, MPI_COMM_WORLD);
+	MPI_Type_free(&input_mpi_t);
+}
+
+/********************************************************************/
+/* Function Calibrate
+ * Runs calculate_integral() on CALIBRATION_N trapezoids until at least
+ * CALIBRATION_TIME seconds have passed.
+ * Returns the no of trapezoids this process does per second.
+ ********************************************************************/
+double Calibrate(void)
+{
+	volatile float sink;	// Keeps the compiler from dropping the calls
+	double start, elapsed;
+	long runs = 0;
+
+	start = MPI_Wtime();
+	do
+	{
+		sink = calculate_integral(0.0, 1.0, CALIBRATION_N, 1.0 / CALIBRATION_N);
+		runs++;
+		elapsed = MPI_Wtime() - start;
+	} while( elapsed < CALIBRATION_TIME );
+	(void) sink;
+
+	return (double) runs * CALIBRATION_N / elapsed;
+}
+
+/********************************************************************/
+/* Function Partition
+ * Gives process i about n * speed[i] / sum(speed) trapezoids. The
+ * trapezoids left over after rounding down go to the processes with the
+ * largest fractional parts (largest remainder method).
+ * Output : partition[i] = first point and no of trapezoids of process i
+ ********************************************************************/
+void Partition(float a,				/* in */
+			float h,				/* in */
+			int n,					/* in */
+			double speed[],			/* in */
+			int no_of_process,		/* in */
+			PARTITION_T partition[]	/* out */
+			)
+{
+	double *fraction = malloc(no_of_process * sizeof(double));
+	double total_speed = 0.0;
+	double share;
+	long assigned = 0;
+	long first = 0;
+	int process, best;
+
+	for( process = 0 ; process < no_of_process ; process++ )
+	{
+		total_speed += speed[process];
+	}
+
+	for( process = 0 ; process < no_of_process ; process++ )
+	{
+		share = (double) n * speed[process] / total_speed;
+		partition[process].local_n = (int) share;
+		fraction[process] = share - partition[process].local_n;
+		assigned += partition[process].local_n;
+	}
+
+	/* Hand out the remainder */
+	for( ; assigned < n ; assigned++ )
+	{
+		best = 0;
+		for( process = 1 ; process < no_of_process ; process++ )
+		{
+			if( fraction[process] > fraction[best] )
+			{
+				best = process;
+			}
+		}
+		partition[best].local_n++;
+		fraction[best] = -1.0;
+	}
+
+	/* Intervals follow each other in rank order */
+	for( process = 0 ; process < no_of_process ; process++ )
+	{
+		partition[process].local_a = a + first * h;
+		first += partition[process].local_n;
+	}
+
+	free(fraction);
+}
+
+/* Function to calculate integral */
+float calculate_integral( float local_a, float local_b , int local_n , float h )
+{
+	float integral;		// Store result of integral
+	float x ;
+	int i;
+
+	integral = ( f(local_a) + f(local_b)) / 2.0;
+	x = local_a;
+
+	for( i = 1 ; i <= local_n-1 ; i++ )
+	{
+		x = x+h;
+		integral = integral + f(x);
+	}
+
+	integral = integral * h;
+	return integral;
+}
+
+// f(x) = x^2
+float f(float x)
+{
+	return (x*x);
+}
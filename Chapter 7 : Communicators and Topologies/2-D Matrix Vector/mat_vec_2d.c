@@ -0,0 +1,403 @@
+/*
+ * mat_vec_2d.c
+ *
+ *  Created on: 16-Oct-2026
+ *      Author: prateek
+ *      Desc : Matrix-vector product y = Ax with A split into blocks over a 2-D grid
+ *      	of processes, timed against the row panels of chap05/parallel_mat_vect.c.
+ *      Input :
+ *      	m, n : order of the matrix
+ *      Output :
+ *      	The process grid, the floats each process sends or receives per product,
+ *      	the time of one product with each layout and the largest difference between them.
+ *
+ *      Algorithm:
+ *      	1-D ( parallel_mat_vect.c ) : process r has rows block r of A and block r
+ *      	of x. MPI_Allgatherv gives everyone all of x, then every process does its
+ *      	rows. Every process receives about n floats.
+ *
+ *      	2-D : MPI_Dims_create picks a rows x cols grid and the row and column
+ *      	communicators are made with MPI_Cart_sub as in chap07/fox.c. Process (r,c)
+ *      	has block (r,c) of A : the rows of block r and the columns of block c.
+ *      	1) x is split into cols blocks; block c is held by process (0,c) and is
+ *      	   broadcast down column c.
+ *      	2) Process (r,c) multiplies its block of A by block c of x : a partial
+ *      	   result for the rows of block r.
+ *      	3) The partial results are added along row r with MPI_Reduce onto
+ *      	   process (r,0), which then holds block r of y.
+ *      	Every process receives about n/cols and sends about m/rows floats.
+ *
+ *      	        x0      x1      x2      ( bcast down the columns )
+ *      	     +-------+-------+-------+
+ *      	     | A00   | A01   | A02   |  --> y0 on (0,0)  ( reduce along the rows )
+ *      	     +-------+-------+-------+
+ *      	     | A10   | A11   | A12   |  --> y1 on (1,0)
+ *      	     +-------+-------+-------+
+ *
+ *      NOTES:
+ *      	1. A(i,j) = (i + 2j) % 7 - 3 and x(j) = j % 5 - 2. All the products and
+ *      	   sums are small integers, exact in float, so both layouts must agree
+ *      	   exactly.
+ *      	2. Any p, m and n work : the first blocks get one row or column more.
+ *      	3. x comes in on grid row 0 and y goes out on grid column 0. To use y as
+ *      	   the next x, send block r of y from (r,0) to (0,r) when rows == cols.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <mpi/mpi.h>
+
+#define REPS	20
+
+typedef struct {
+	int p;				/* Total number of processes    */
+	MPI_Comm comm;		/* Communicator for entire grid */
+	MPI_Comm row_comm;	/* Communicator for my row      */
+	MPI_Comm col_comm;	/* Communicator for my col      */
+	int rows;			/* Rows of the grid             */
+	int cols;			/* Columns of the grid          */
+	int my_row;			/* My row number                */
+	int my_col;			/* My column number             */
+	int my_rank;		/* My rank in the grid comm     */
+} GRID_INFO_T;
+
+void Setup_grid(GRID_INFO_T *grid);
+void Get_data(int *m_ptr, int *n_ptr, GRID_INFO_T *grid);
+void Block_range(int n, int no_of_blocks, int block, int *first_ptr, int *count_ptr);
+void Fill_matrix(float A[], int first_row, int no_of_rows, int first_col, int no_of_cols);
+void Fill_vector(float x[], int first, int count);
+void Local_mat_vec(const float A[], int no_of_rows, int no_of_cols, const float x[], float y[]);
+void Mat_vec_1d(const float local_A[], int local_m, int n, const float local_x[], int local_n,
+		const int x_counts[], const int x_displacements[], float global_x[], float local_y[], MPI_Comm comm);
+void Mat_vec_2d(const float local_A[], int local_m, int local_n, float local_x[], float partial_y[],
+		float local_y[], GRID_INFO_T *grid);
+float Gather_and_compare(const float y_1d[], int local_m_1d, const float y_2d[], int local_m_2d, int m,
+		GRID_INFO_T *grid);
+
+int main(int argc, char **argv)
+{
+	GRID_INFO_T grid;
+	int m, n;
+	/* 1-D layout */
+	int local_m_1d, first_row_1d, local_n_1d, first_col_1d;
+	int *x_counts, *x_displacements;
+	float *A_1d, *x_1d, *global_x, *y_1d;
+	/* 2-D layout */
+	int local_m_2d, first_row_2d, local_n_2d, first_col_2d;
+	float *A_2d, *x_2d, *partial_y, *y_2d;
+	double start, elapsed, seconds_1d, seconds_2d;
+	float max_difference;
+	int rank, rep;
+
+	MPI_Init(&argc, &argv);
+	Setup_grid(&grid);
+	Get_data(&m, &n, &grid);
+
+	/* 1-D : row panels and blocks of x over all p */
+	Block_range(m, grid.p, grid.my_rank, &first_row_1d, &local_m_1d);
+	Block_range(n, grid.p, grid.my_rank, &first_col_1d, &local_n_1d);
+	x_counts = malloc(grid.p * sizeof(int));
+	x_displacements = malloc(grid.p * sizeof(int));
+	for( rank = 0 ; rank < grid.p ; rank++ )
+	{
+		Block_range(n, grid.p, rank, &x_displacements[rank], &x_counts[rank]);
+	}
+	A_1d = malloc(((size_t) local_m_1d * n + 1) * sizeof(float));
+	x_1d = malloc((local_n_1d + 1) * sizeof(float));
+	global_x = malloc(n * sizeof(float));
+	y_1d = malloc((local_m_1d + 1) * sizeof(float));
+	Fill_matrix(A_1d, first_row_1d, local_m_1d, 0, n);
+	Fill_vector(x_1d, first_col_1d, local_n_1d);
+
+	/* 2-D : block (my_row, my_col) of A, block my_col of x on grid row 0 */
+	Block_range(m, grid.rows, grid.my_row, &first_row_2d, &local_m_2d);
+	Block_range(n, grid.cols, grid.my_col, &first_col_2d, &local_n_2d);
+	A_2d = malloc(((size_t) local_m_2d * local_n_2d + 1) * sizeof(float));
+	x_2d = malloc((local_n_2d + 1) * sizeof(float));
+	partial_y = malloc((local_m_2d + 1) * sizeof(float));
+	y_2d = malloc((local_m_2d + 1) * sizeof(float));
+	Fill_matrix(A_2d, first_row_2d, local_m_2d, first_col_2d, local_n_2d);
+	if( grid.my_row == 0 )
+	{
+		Fill_vector(x_2d, first_col_2d, local_n_2d);
+	}
+
+	MPI_Barrier(grid.comm);
+	start = MPI_Wtime();
+	for( rep = 0 ; rep < REPS ; rep++ )
+	{
+		Mat_vec_1d(A_1d, local_m_1d, n, x_1d, local_n_1d, x_counts, x_displacements, global_x, y_1d, grid.comm);
+	}
+	elapsed = (MPI_Wtime() - start) / REPS;
+	MPI_Reduce(&elapsed, &seconds_1d, 1, MPI_DOUBLE, MPI_MAX, 0, grid.comm);
+
+	MPI_Barrier(grid.comm);
+	start = MPI_Wtime();
+	for( rep = 0 ; rep < REPS ; rep++ )
+	{
+		Mat_vec_2d(A_2d, local_m_2d, local_n_2d, x_2d, partial_y, y_2d, &grid);
+	}
+	elapsed = (MPI_Wtime() - start) / REPS;
+	MPI_Reduce(&elapsed, &seconds_2d, 1, MPI_DOUBLE, MPI_MAX, 0, grid.comm);
+
+	max_difference = Gather_and_compare(y_1d, local_m_1d, y_2d, local_m_2d, m, &grid);
+
+	if( grid.my_rank == 0 )
+	{
+		printf("m = %d , n = %d , p = %d , grid %d x %d \n", m, n, grid.p, grid.rows, grid.cols);
+		printf("1-D : %8d floats moved per process , %e s per product \n", n - local_n_1d, seconds_1d);
+		printf("2-D : %8d floats moved per process , %e s per product \n",
+				(grid.rows > 1 ? (n + grid.cols - 1) / grid.cols : 0)
+				+ (grid.cols > 1 ? (m + grid.rows - 1) / grid.rows : 0), seconds_2d);
+		printf("Largest difference between the two y = %g \n", max_difference);
+	}
+
+	free(A_1d);
+	free(x_1d);
+	free(global_x);
+	free(y_1d);
+	free(x_counts);
+	free(x_displacements);
+	free(A_2d);
+	free(x_2d);
+	free(partial_y);
+	free(y_2d);
+	MPI_Comm_free(&grid.row_comm);
+	MPI_Comm_free(&grid.col_comm);
+	MPI_Comm_free(&grid.comm);
+	MPI_Finalize();
+
+	return 0;
+}
+
+/*********************************************************/
+/* Function Setup_grid
+ * As in chap07/fox.c, but MPI_Dims_create chooses a rows x cols
+ * grid, so p need not be a perfect square.
+ *********************************************************/
+void Setup_grid(GRID_INFO_T *grid	/* out */)
+{
+	int dimensions[2] = { 0, 0 };
+	int wrap_around[2] = { 0, 0 };
+	int coordinates[2];
+	int free_coords[2];
+
+	MPI_Comm_size(MPI_COMM_WORLD, &(grid->p));
+	MPI_Dims_create(grid->p, 2, dimensions);
+	grid->rows = dimensions[0];
+	grid->cols = dimensions[1];
+
+	MPI_Cart_create(MPI_COMM_WORLD, 2, dimensions, wrap_around, 1, &(grid->comm));
+	MPI_Comm_rank(grid->comm, &(grid->my_rank));
+	MPI_Cart_coords(grid->comm, grid->my_rank, 2, coordinates);
+	grid->my_row = coordinates[0];
+	grid->my_col = coordinates[1];
+
+	/* Set up row communicators */
+	free_coords[0] = 0;
+	free_coords[1] = 1;
+	MPI_Cart_sub(grid->comm, free_coords, &(grid->row_comm));
+
+	/* Set up column communicators */
+	free_coords[0] = 1;
+	free_coords[1] = 0;
+	MPI_Cart_sub(grid->comm, free_coords, &(grid->col_comm));
+}
+
+/*
+ * Process 0 of the grid reads the order of the matrix and broadcasts it
+ */
+void Get_data(int *m_ptr,		/* out */
+			int *n_ptr,			/* out */
+			GRID_INFO_T *grid	/* in */
+			)
+{
+	if( grid->my_rank == 0 )
+	{
+		printf("Enter the order of the matrix (m x n)\n");
+		scanf("%d %d", m_ptr, n_ptr);
+	}
+
+	MPI_Bcast(m_ptr, 1, MPI_INT, 0, grid->comm);
+	MPI_Bcast(n_ptr, 1, MPI_INT, 0, grid->comm);
+}
+
+/*
+ * First index and length of block number block of n split into no_of_blocks.
+ * The first n % no_of_blocks blocks get one more.
+ */
+void Block_range(int n,			/* in */
+			int no_of_blocks,	/* in */
+			int block,			/* in */
+			int *first_ptr,		/* out */
+			int *count_ptr		/* out */
+			)
+{
+	int quotient = n / no_of_blocks;
+	int remainder = n % no_of_blocks;
+
+	*count_ptr = quotient + (block < remainder ? 1 : 0);
+	*first_ptr = block * quotient + (block < remainder ? block : remainder);
+}
+
+/*
+ * Rows first_row.. and columns first_col.. of A, stored by rows
+ */
+void Fill_matrix(float A[],	/* out */
+			int first_row,	/* in */
+			int no_of_rows,	/* in */
+			int first_col,	/* in */
+			int no_of_cols	/* in */
+			)
+{
+	int i, j;
+
+	for( i = 0 ; i < no_of_rows ; i++ )
+	{
+		for( j = 0 ; j < no_of_cols ; j++ )
+		{
+			A[(size_t) i * no_of_cols + j] = (float) ((first_row + i + 2 * (first_col + j)) % 7 - 3);
+		}
+	}
+}
+
+/*
+ * Elements first.. of x
+ */
+void Fill_vector(float x[],	/* out */
+			int first,		/* in */
+			int count		/* in */
+			)
+{
+	int j;
+
+	for( j = 0 ; j < count ; j++ )
+	{
+		x[j] = (float) ((first + j) % 5 - 2);
+	}
+}
+
+/*
+ * y = A x for a no_of_rows x no_of_cols block stored by rows
+ */
+void Local_mat_vec(const float A[],	/* in */
+			int no_of_rows,			/* in */
+			int no_of_cols,			/* in */
+			const float x[],		/* in */
+			float y[]				/* out */
+			)
+{
+	int i, j;
+
+	for( i = 0 ; i < no_of_rows ; i++ )
+	{
+		y[i] = 0.0;
+		for( j = 0 ; j < no_of_cols ; j++ )
+		{
+			y[i] += A[(size_t) i * no_of_cols + j] * x[j];
+		}
+	}
+}
+
+/*
+ * Row panel product of parallel_mat_vect.c : gather all of x, do my rows
+ */
+void Mat_vec_1d(const float local_A[],	/* in */
+			int local_m,				/* in */
+			int n,						/* in */
+			const float local_x[],		/* in */
+			int local_n,				/* in */
+			const int x_counts[],		/* in */
+			const int x_displacements[],	/* in */
+			float global_x[],			/* scratch */
+			float local_y[],			/* out */
+			MPI_Comm comm				/* in */
+			)
+{
+	MPI_Allgatherv(local_x, local_n, MPI_FLOAT, global_x, x_counts, x_displacements, MPI_FLOAT, comm);
+	Local_mat_vec(local_A, local_m, n, global_x, local_y);
+}
+
+/********************************************************************/
+/* Function Mat_vec_2d
+ * local_x is block my_col of x, significant on grid row 0 on entry and
+ * filled in everywhere on return. local_y is block my_row of y,
+ * significant on grid column 0 only.
+ * Algorithm:
+ *     1.  Broadcast local_x from row 0 down my column.
+ *     2.  partial_y = my block of A times local_x.
+ *     3.  Add the partial_y of my row onto column 0.
+ ********************************************************************/
+void Mat_vec_2d(const float local_A[],	/* in */
+			int local_m,				/* in */
+			int local_n,				/* in */
+			float local_x[],			/* in/out */
+			float partial_y[],			/* scratch */
+			float local_y[],			/* out */
+			GRID_INFO_T *grid			/* in */
+			)
+{
+	MPI_Bcast(local_x, local_n, MPI_FLOAT, 0, grid->col_comm);
+	Local_mat_vec(local_A, local_m, local_n, local_x, partial_y);
+	MPI_Reduce(partial_y, local_y, local_m, MPI_FLOAT, MPI_SUM, 0, grid->row_comm);
+}
+
+/********************************************************************/
+/* Function Gather_and_compare
+ * Gathers the y of both layouts onto process 0 of the grid, which is
+ * process (0,0), and returns the largest difference there.
+ ********************************************************************/
+float Gather_and_compare(const float y_1d[],	/* in */
+			int local_m_1d,					/* in */
+			const float y_2d[],				/* in */
+			int local_m_2d,					/* in */
+			int m,							/* in */
+			GRID_INFO_T *grid				/* in */
+			)
+{
+	float *full_1d = NULL, *full_2d = NULL;
+	int *counts = NULL, *displacements = NULL;
+	float max_difference = 0.0f;
+	int rank, i;
+
+	if( grid->my_rank == 0 )
+	{
+		full_1d = malloc(m * sizeof(float));
+		full_2d = malloc(m * sizeof(float));
+		counts = malloc(grid->p * sizeof(int));
+		displacements = malloc(grid->p * sizeof(int));
+		for( rank = 0 ; rank < grid->p ; rank++ )
+		{
+			Block_range(m, grid->p, rank, &displacements[rank], &counts[rank]);
+		}
+	}
+	MPI_Gatherv(y_1d, local_m_1d, MPI_FLOAT, full_1d, counts, displacements, MPI_FLOAT, 0, grid->comm);
+
+	if( grid->my_col == 0 )
+	{
+		if( grid->my_rank == 0 )
+		{
+			for( rank = 0 ; rank < grid->rows ; rank++ )
+			{
+				Block_range(m, grid->rows, rank, &displacements[rank], &counts[rank]);
+			}
+		}
+		MPI_Gatherv(y_2d, local_m_2d, MPI_FLOAT, full_2d, counts, displacements, MPI_FLOAT, 0, grid->col_comm);
+	}
+
+	if( grid->my_rank == 0 )
+	{
+		for( i = 0 ; i < m ; i++ )
+		{
+			if( fabsf(full_1d[i] - full_2d[i]) > max_difference )
+			{
+				max_difference = fabsf(full_1d[i] - full_2d[i]);
+			}
+		}
+		free(full_1d);
+		free(full_2d);
+		free(counts);
+		free(displacements);
+	}
+	return max_difference;
+}
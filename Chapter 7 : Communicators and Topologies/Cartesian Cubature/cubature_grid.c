@@ -0,0 +1,340 @@
+/*
+ * cubature_grid.c
+ *
+ *  Created on: 16-Oct-2026
+ *      Author: prateek
+ *      Desc : 2-D and 3-D cubature over a box, decomposed over a Cartesian grid of
+ *      	processes (as Setup_grid in chap07/fox.c).
+ *      Input :
+ *      	dim  : 2 or 3
+ *      	rule : trap or gauss
+ *      	for each dimension : lower bound , upper bound and no of cells
+ *      Output :
+ *      	Estimate of the integral of f over the box, the exact value, the process
+ *      	grid, the no of points per process and the elapsed time.
+ *
+ *      Algorithm:
+ *      1) MPI_Dims_create picks a dim-dimensional grid of processes for p and
+ *         MPI_Cart_create builds it. Any p works, it need not be a perfect square.
+ *      2) In every dimension the cells are split into blocks among the processes
+ *         of that dimension. The first cells % dims processes get one cell more.
+ *      3) Each process builds the 1-D nodes and weights of the rule for its block
+ *         in every dimension. The cubature over its sub-box is the tensor product :
+ *         sum over i, j, k of w0(i) w1(j) w2(k) f(x0(i), x1(j), x2(k)).
+ *      4) The innermost sum runs over blocks of BLOCK_SIZE nodes that stay in L1
+ *         and is vectorized with an OpenMP simd reduction.
+ *      5) The sub-box results are added with MPI_Reduce over the grid communicator.
+ *
+ *      NOTES:
+ *      	1. f is hardwired : f(x,y,z) = exp(-(x^2 + y^2 + z^2)). In 2-D one of them is 0.
+ *      	2. trap : composite trapezoidal rule, one node per cell edge.
+ *      	   gauss : 3-point Gauss-Legendre rule in every cell.
+ *      	3. The Makefile builds with -ffast-math so that exp() in the inner loop can
+ *      	   use the vector math library.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <mpi/mpi.h>
+
+#define MAX_DIM			3
+#define BLOCK_SIZE		1024	/* Innermost nodes handled at a time */
+#define GAUSS_POINTS	3
+
+typedef struct {
+	int p;					/* Total number of processes    */
+	int dim;				/* Dimensions of the grid       */
+	MPI_Comm comm;			/* Communicator for entire grid */
+	int dims[MAX_DIM];		/* Processes in each dimension  */
+	int coords[MAX_DIM];	/* My coordinates               */
+	int my_rank;			/* My rank in the grid comm     */
+} GRID_INFO_T;
+
+/* Nodes and weights of the rule along one dimension of my sub-box */
+typedef struct {
+	int count;
+	double *x;
+	double *w;
+} NODES_T;
+
+void Setup_grid(GRID_INFO_T *grid, int dim);
+void Get_data(int *dim_ptr, int *gauss_ptr, double lower[], double upper[], int cells[], int my_rank);
+void Build_nodes(double lower, double upper, int cells, int no_of_blocks, int my_block, int gauss, NODES_T *nodes);
+double Sub_box_cubature(NODES_T nodes[]);
+double Exact(int dim, double lower[], double upper[]);
+
+int main(int argc, char **argv)
+{
+	int my_rank;				// My rank in MPI_COMM_WORLD
+	GRID_INFO_T grid;
+	int dim;					// 2 or 3
+	int gauss;					// 1 : Gauss rule , 0 : trapezoidal rule
+	double lower[MAX_DIM];		// Box
+	double upper[MAX_DIM];
+	int cells[MAX_DIM];			// Cells in each dimension
+	NODES_T nodes[MAX_DIM];		// My nodes in each dimension
+	double local_integral;
+	double total;
+	double local_points = 1.0;
+	double start, finish;
+	int d, slot;
+
+	MPI_Init(&argc, &argv);
+	MPI_Comm_rank(MPI_COMM_WORLD, &my_rank);
+
+	Get_data(&dim, &gauss, lower, upper, cells, my_rank);
+	Setup_grid(&grid, dim);
+
+	MPI_Barrier(grid.comm);
+	start = MPI_Wtime();
+
+	/* The dimensions used go last, so that the innermost, blocked loop of
+	 * Sub_box_cubature always runs over one of them. f is the same in
+	 * every variable, so which slot a dimension takes does not matter */
+	for( d = 0 ; d < MAX_DIM ; d++ )
+	{
+		if( d >= MAX_DIM - dim )
+		{
+			slot = d - (MAX_DIM - dim);
+			Build_nodes(lower[slot], upper[slot], cells[slot], grid.dims[slot], grid.coords[slot], gauss,
+					&nodes[d]);
+		}
+		else
+		{
+			/* Unused dimension : one node at 0 with weight 1 */
+			nodes[d].count = 1;
+			nodes[d].x = calloc(1, sizeof(double));
+			nodes[d].w = malloc(sizeof(double));
+			nodes[d].w[0] = 1.0;
+		}
+		local_points *= nodes[d].count;
+	}
+
+	local_integral = Sub_box_cubature(nodes);
+	MPI_Reduce(&local_integral, &total, 1, MPI_DOUBLE, MPI_SUM, 0, grid.comm);
+
+	MPI_Barrier(grid.comm);
+	finish = MPI_Wtime();
+
+	if( grid.my_rank == 0 )
+	{
+		printf("Process grid :");
+		for( d = 0 ; d < dim ; d++ )
+		{
+			printf(" %d", grid.dims[d]);
+		}
+		printf(" , rule %s , %.0f points on process 0 \n", gauss ? "gauss" : "trap", local_points);
+		printf("Estimate = %.12f , exact = %.12f , error = %.3e \n", total, Exact(dim, lower, upper),
+				fabs(total - Exact(dim, lower, upper)));
+		printf("Elapsed time in seconds = %e (%e points/s per process) \n", finish - start,
+				local_points / (finish - start));
+	}
+
+	for( d = 0 ; d < MAX_DIM ; d++ )
+	{
+		free(nodes[d].x);
+		free(nodes[d].w);
+	}
+	MPI_Comm_free(&grid.comm);
+	MPI_Finalize();
+
+	return 0;
+}
+
+/*********************************************************/
+/* Function Setup_grid
+ * Builds a dim-dimensional Cartesian communicator out of all the
+ * processes, with MPI_Dims_create choosing the shape.
+ *********************************************************/
+void Setup_grid(GRID_INFO_T *grid,	/* out */
+			int dim					/* in */
+			)
+{
+	int periods[MAX_DIM] = { 0, 0, 0 };	// No wrap around, the box has edges
+	int d;
+
+	MPI_Comm_size(MPI_COMM_WORLD, &(grid->p));
+	grid->dim = dim;
+	for( d = 0 ; d < MAX_DIM ; d++ )
+	{
+		grid->dims[d] = 0;
+		grid->coords[d] = 0;
+	}
+
+	MPI_Dims_create(grid->p, dim, grid->dims);
+	MPI_Cart_create(MPI_COMM_WORLD, dim, grid->dims, periods, 1, &(grid->comm));
+	MPI_Comm_rank(grid->comm, &(grid->my_rank));
+	MPI_Cart_coords(grid->comm, grid->my_rank, dim, grid->coords);
+}
+
+/*
+ * Process 0 reads the input and broadcasts it
+ */
+void Get_data(int *dim_ptr,	/* out */
+			int *gauss_ptr,	/* out */
+			double lower[],	/* out */
+			double upper[],	/* out */
+			int cells[],	/* out */
+			int my_rank		/* in */
+			)
+{
+	char rule[16] = {0};
+	int d;
+
+	if( my_rank == 0 )
+	{
+		printf("Enter dimension (2 or 3) and rule (trap or gauss) \n");
+		scanf("%d %15s", dim_ptr, rule);
+		if( *dim_ptr < 2 || *dim_ptr > MAX_DIM )
+		{
+			*dim_ptr = 2;
+		}
+		*gauss_ptr = (strcmp(rule, "gauss") == 0);
+
+		printf("Enter lower bound , upper bound and no of cells of each dimension \n");
+		for( d = 0 ; d < *dim_ptr ; d++ )
+		{
+			scanf("%lf %lf %d", &lower[d], &upper[d], &cells[d]);
+		}
+	}
+
+	MPI_Bcast(dim_ptr, 1, MPI_INT, 0, MPI_COMM_WORLD);
+	MPI_Bcast(gauss_ptr, 1, MPI_INT, 0, MPI_COMM_WORLD);
+	MPI_Bcast(lower, *dim_ptr, MPI_DOUBLE, 0, MPI_COMM_WORLD);
+	MPI_Bcast(upper, *dim_ptr, MPI_DOUBLE, 0, MPI_COMM_WORLD);
+	MPI_Bcast(cells, *dim_ptr, MPI_INT, 0, MPI_COMM_WORLD);
+}
+
+/********************************************************************/
+/* Function Build_nodes
+ * 1-D nodes and weights for block my_block of no_of_blocks of the
+ * cells of [lower,upper].
+ * trap : the nodes are the cell edges. An edge shared with the next
+ *        block belongs to the next block, the edges of [lower,upper]
+ *        get half weight.
+ * gauss : GAUSS_POINTS nodes in each cell.
+ ********************************************************************/
+void Build_nodes(double lower,	/* in */
+			double upper,		/* in */
+			int cells,			/* in */
+			int no_of_blocks,	/* in */
+			int my_block,		/* in */
+			int gauss,			/* in */
+			NODES_T *nodes		/* out */
+			)
+{
+	const double gauss_x[GAUSS_POINTS] = { -0.7745966692414834, 0.0, 0.7745966692414834 };
+	const double gauss_w[GAUSS_POINTS] = { 0.5555555555555556, 0.8888888888888888, 0.5555555555555556 };
+	double h = (upper - lower) / cells;
+	int quotient = cells / no_of_blocks;
+	int remainder = cells % no_of_blocks;
+	int my_cells = quotient + (my_block < remainder ? 1 : 0);
+	int first = my_block * quotient + (my_block < remainder ? my_block : remainder);
+	int last_block = (my_block == no_of_blocks - 1);
+	int i, k;
+
+	if( gauss )
+	{
+		nodes->count = my_cells * GAUSS_POINTS;
+	}
+	else
+	{
+		/* Left edge of each cell, plus the right edge of the box on the last block */
+		nodes->count = my_cells + (last_block ? 1 : 0);
+	}
+	nodes->x = malloc((nodes->count > 0 ? nodes->count : 1) * sizeof(double));
+	nodes->w = malloc((nodes->count > 0 ? nodes->count : 1) * sizeof(double));
+
+	if( gauss )
+	{
+		for( i = 0 ; i < my_cells ; i++ )
+		{
+			for( k = 0 ; k < GAUSS_POINTS ; k++ )
+			{
+				nodes->x[i * GAUSS_POINTS + k] = lower + (first + i + 0.5) * h + 0.5 * h * gauss_x[k];
+				nodes->w[i * GAUSS_POINTS + k] = 0.5 * h * gauss_w[k];
+			}
+		}
+		return;
+	}
+
+	for( i = 0 ; i < nodes->count ; i++ )
+	{
+		nodes->x[i] = lower + (first + i) * h;
+		nodes->w[i] = h;
+	}
+	if( first == 0 && nodes->count > 0 )
+	{
+		nodes->w[0] = h / 2.0;
+	}
+	if( last_block )
+	{
+		nodes->w[nodes->count - 1] = h / 2.0;
+	}
+}
+
+/********************************************************************/
+/* Function Sub_box_cubature
+ * Tensor product rule over my sub-box. The innermost dimension is done
+ * in blocks of BLOCK_SIZE nodes; each block is reused for every (i, j).
+ * An unused dimension must be nodes[0], never nodes[2], or the simd
+ * loop runs once per (i, j).
+ ********************************************************************/
+double Sub_box_cubature(NODES_T nodes[]	/* in */)
+{
+	double total = 0.0;
+	double outer_r2, outer_w;
+	double row_sum;
+	double *x2, *w2;
+	int start, count;
+	int i, j, k;
+
+	for( start = 0 ; start < nodes[2].count ; start += BLOCK_SIZE )
+	{
+		count = nodes[2].count - start;
+		if( count > BLOCK_SIZE )
+		{
+			count = BLOCK_SIZE;
+		}
+		x2 = &nodes[2].x[start];
+		w2 = &nodes[2].w[start];
+
+		for( i = 0 ; i < nodes[0].count ; i++ )
+		{
+			for( j = 0 ; j < nodes[1].count ; j++ )
+			{
+				outer_r2 = nodes[0].x[i] * nodes[0].x[i] + nodes[1].x[j] * nodes[1].x[j];
+				outer_w = nodes[0].w[i] * nodes[1].w[j];
+
+				row_sum = 0.0;
+#pragma omp simd reduction(+:row_sum)
+				for( k = 0 ; k < count ; k++ )
+				{
+					row_sum += w2[k] * exp(-(outer_r2 + x2[k] * x2[k]));
+				}
+				total += outer_w * row_sum;
+			}
+		}
+	}
+
+	return total;
+}
+
+/*
+ * Exact integral of f over the box : a product of 1-D integrals
+ */
+double Exact(int dim,		/* in */
+			double lower[],	/* in */
+			double upper[]	/* in */
+			)
+{
+	double exact = 1.0;
+	int d;
+
+	for( d = 0 ; d < dim ; d++ )
+	{
+		exact *= sqrt(M_PI) / 2.0 * (erf(upper[d]) - erf(lower[d]));
+	}
+	return exact;
+}
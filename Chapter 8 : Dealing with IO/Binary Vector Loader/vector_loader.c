@@ -0,0 +1,217 @@
+/*
+ * vector_loader.c
+ *
+ *  Created on: 16-Oct-2026
+ *      Author: prateek
+ *      Desc : Loads a block distributed vector from a binary file.
+ *      	Read_vector of the dot product programs has process 0 scanf every element
+ *      	and send each process its block in turn, so the other processes wait one
+ *      	after the other while process 0 parses text. Here process 0 reads raw
+ *      	floats, LOAD_CHUNK at a time, and every chunk goes out with MPI_Iscatterv
+ *      	straight into the blocks of the processes that own its elements. While
+ *      	chunk k is being scattered process 0 is already reading chunk k+1 into the
+ *      	other of its two buffers, so the time is close to that of reading the file.
+ *
+ *      	Chunk k and the blocks ( p = 3 , the chunk covers part of two blocks ) :
+ *
+ *      		| block 0        | block 1        | block 2        |
+ *      		          [ chunk k        ]
+ *      		          counts[0]  counts[1]    counts[2] = 0
+ *
+ *      NOTES:
+ *      	1. Every process takes part in the MPI_Iscatterv of every chunk, with a
+ *      	   count of 0 if none of the chunk is its.
+ *      	2. Process 0 reads a chunk in pieces of READ_PIECE floats and calls MPI_Test
+ *      	   between them, so the scatter in flight keeps moving during the read.
+ */
+#define _FILE_OFFSET_BITS	64
+#include <stdio.h>
+#include <stdlib.h>
+#include "vector_loader.h"
+
+#define READ_PIECE		(256 << 10)		/* Floats per fread : 1 MB */
+
+/*
+ * First element and no of elements of rank's block, as in Vector_alloc
+ */
+static void Block_range(int64_t n,	/* in */
+			int p,					/* in */
+			int rank,				/* in */
+			int64_t *first_ptr,		/* out */
+			int64_t *count_ptr		/* out */
+			)
+{
+	int64_t quotient = n / p;
+	int64_t remainder = n % p;
+
+	*count_ptr = quotient + (rank < remainder ? 1 : 0);
+	*first_ptr = rank * quotient + (rank < remainder ? rank : remainder);
+}
+
+/*
+ * Reads count floats into buffer in pieces, testing request in between.
+ * A short read is padded with zeros. Returns 1 if everything was read.
+ */
+static int Read_chunk(FILE *fp,	/* in */
+			float *buffer,		/* out */
+			int count,			/* in */
+			MPI_Request *request	/* in/out */
+			)
+{
+	int done = 0;
+	int piece;
+	int flag;
+	size_t got;
+	int ok = 1;
+
+	while( done < count )
+	{
+		piece = (count - done < READ_PIECE) ? count - done : READ_PIECE;
+		got = fread(&buffer[done], sizeof(float), piece, fp);
+		if( got < (size_t) piece )
+		{
+			ok = 0;
+			for( ; (int) got < piece ; got++ )
+			{
+				buffer[done + got] = 0.0f;
+			}
+		}
+		done += piece;
+
+		if( *request != MPI_REQUEST_NULL )
+		{
+			MPI_Test(request, &flag, MPI_STATUS_IGNORE);
+		}
+	}
+
+	return ok;
+}
+
+/********************************************************************/
+/* Function Load_vector
+ * Algorithm:
+ *     1.  root finds the order from the size of the file and broadcasts it.
+ *     2.  Every process allocates its block.
+ *     3.  root reads chunk 0. Then for every chunk k :
+ *             start the MPI_Iscatterv of chunk k into the blocks,
+ *             root reads chunk k+1 into its other buffer,
+ *             wait for the scatter of chunk k.
+ *     4.  root broadcasts whether all the reads succeeded.
+ ********************************************************************/
+int Load_vector(const char *file_name,	/* in, significant on root only */
+			int root,					/* in */
+			MPI_Comm comm,				/* in */
+			DIST_VECTOR_T *v			/* out */
+			)
+{
+	int my_rank, p;
+	FILE *fp = NULL;
+	int64_t n = -1;
+	int64_t no_of_chunks, chunk;
+	int64_t chunk_start, chunk_end;
+	int64_t first, count, lo, hi;
+	int *counts, *displacements;
+	float *buffers[2] = { NULL, NULL };
+	MPI_Request request;
+	int read_ok = 1;
+	int ok, all_ok;
+	int rank;
+
+	MPI_Comm_rank(comm, &my_rank);
+	MPI_Comm_size(comm, &p);
+
+	if( my_rank == root )
+	{
+		fp = fopen(file_name, "rb");
+		if( fp != NULL && fseeko(fp, 0, SEEK_END) == 0 )
+		{
+			n = ftello(fp) / (int64_t) sizeof(float);
+			fseeko(fp, 0, SEEK_SET);
+		}
+	}
+	MPI_Bcast(&n, 1, MPI_INT64_T, root, comm);
+	if( n < 0 )
+	{
+		if( fp != NULL )
+		{
+			fclose(fp);
+		}
+		return 0;
+	}
+
+	ok = Vector_alloc(v, n, comm);
+	if( my_rank == root )
+	{
+		buffers[0] = malloc(LOAD_CHUNK * sizeof(float));
+		buffers[1] = malloc(LOAD_CHUNK * sizeof(float));
+		ok = ok && buffers[0] != NULL && buffers[1] != NULL;
+	}
+	MPI_Allreduce(&ok, &all_ok, 1, MPI_INT, MPI_MIN, comm);
+	if( !all_ok )
+	{
+		Vector_free(v);
+		free(buffers[0]);
+		free(buffers[1]);
+		if( fp != NULL )
+		{
+			fclose(fp);
+		}
+		return 0;
+	}
+
+	counts = malloc(p * sizeof(int));
+	displacements = malloc(p * sizeof(int));
+	no_of_chunks = (n + LOAD_CHUNK - 1) / LOAD_CHUNK;
+
+	request = MPI_REQUEST_NULL;
+	if( my_rank == root && no_of_chunks > 0 )
+	{
+		read_ok = Read_chunk(fp, buffers[0], (n < LOAD_CHUNK) ? (int) n : LOAD_CHUNK, &request);
+	}
+
+	for( chunk = 0 ; chunk < no_of_chunks ; chunk++ )
+	{
+		chunk_start = chunk * LOAD_CHUNK;
+		chunk_end = (chunk_start + LOAD_CHUNK < n) ? chunk_start + LOAD_CHUNK : n;
+
+		/* The part of every block that lies in this chunk */
+		for( rank = 0 ; rank < p ; rank++ )
+		{
+			Block_range(n, p, rank, &first, &count);
+			lo = (first > chunk_start) ? first : chunk_start;
+			hi = (first + count < chunk_end) ? first + count : chunk_end;
+			counts[rank] = (hi > lo) ? (int) (hi - lo) : 0;
+			displacements[rank] = (hi > lo) ? (int) (lo - chunk_start) : 0;
+		}
+		lo = (v->first > chunk_start) ? v->first : chunk_start;
+
+		MPI_Iscatterv(buffers[chunk % 2], counts, displacements, MPI_FLOAT,
+				&v->data[(counts[my_rank] > 0) ? lo - v->first : 0], counts[my_rank], MPI_FLOAT,
+				root, comm, &request);
+
+		if( my_rank == root && chunk + 1 < no_of_chunks )
+		{
+			count = (n - chunk_end < LOAD_CHUNK) ? n - chunk_end : LOAD_CHUNK;
+			read_ok &= Read_chunk(fp, buffers[(chunk + 1) % 2], (int) count, &request);
+		}
+
+		MPI_Wait(&request, MPI_STATUS_IGNORE);
+	}
+
+	MPI_Bcast(&read_ok, 1, MPI_INT, root, comm);
+
+	free(counts);
+	free(displacements);
+	free(buffers[0]);
+	free(buffers[1]);
+	if( fp != NULL )
+	{
+		fclose(fp);
+	}
+
+	if( !read_ok )
+	{
+		Vector_free(v);
+	}
+	return read_ok;
+}
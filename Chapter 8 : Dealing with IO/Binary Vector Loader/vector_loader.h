@@ -0,0 +1,31 @@
+/*
+ * vector_loader.h
+ *
+ *  Created on: 16-Oct-2026
+ *      Author: prateek
+ *      Desc : Header for vector_loader.c -- reads a vector of floats from a binary
+ *      	file on one process and scatters it in chunks, overlapping the reading of
+ *      	each chunk with the distribution of the one before.
+ */
+#ifndef VECTOR_LOADER_H
+#define VECTOR_LOADER_H
+
+#include <mpi/mpi.h>
+#include "dist_dot.h"
+
+/* Floats read and scattered at a time : 16 MB */
+#define LOAD_CHUNK		(4 << 20)
+
+/* Load the file file_name, raw floats in native byte order, into v.
+ * Only root opens the file. v is allocated with Vector_alloc over comm,
+ * the order being the size of the file / sizeof(float).
+ * Collective, returns 1 on every process on success and 0 on every
+ * process if the file cannot be read or v cannot be allocated */
+int Load_vector(
+		const char *file_name,		/* in, significant on root only */
+		int root,					/* in */
+		MPI_Comm comm,				/* in */
+		DIST_VECTOR_T *v			/* out */
+		);
+
+#endif /* VECTOR_LOADER_H */
@@ -0,0 +1,175 @@
+/*
+ * vector_loader_test.c
+ *
+ *  Created on: 16-Oct-2026
+ *      Author: prateek
+ *      Desc : Writes a binary vector file, loads it with Load_vector and checks it.
+ *      Input :
+ *      	file_name : file to write the vector to
+ *      	n : order of the vector
+ *      Output :
+ *      	The time process 0 takes just to read the file, the time to load and
+ *      	distribute it with Load_vector, and whether every element arrived in the
+ *      	right place.
+ *
+ *      NOTES:
+ *      	1. x(i) = i % 1000003, which is exact in float.
+ *      	2. The file was just written, so it is probably in the page cache; to time
+ *      	   the disk drop the cache between writing and loading.
+ */
+#define _FILE_OFFSET_BITS	64
+#include <stdio.h>
+#include <stdlib.h>
+#include <mpi/mpi.h>
+#include "vector_loader.h"
+
+void Get_data(char file_name[], int64_t *n_ptr, int my_rank);
+int Write_file(const char file_name[], int64_t n);
+double Read_file(const char file_name[]);
+
+int main(int argc, char **argv)
+{
+	int my_rank;
+	int no_of_process;
+	char file_name[256];
+	int64_t n;
+	DIST_VECTOR_T v;
+	double read_seconds = 0.0;
+	double start, elapsed, load_seconds;
+	int ok, all_ok;
+	int64_t i;
+
+	MPI_Init(&argc, &argv);
+	MPI_Comm_rank(MPI_COMM_WORLD, &my_rank);
+	MPI_Comm_size(MPI_COMM_WORLD, &no_of_process);
+
+	Get_data(file_name, &n, my_rank);
+
+	ok = (my_rank == 0) ? Write_file(file_name, n) : 1;
+	MPI_Bcast(&ok, 1, MPI_INT, 0, MPI_COMM_WORLD);
+	if( !ok )
+	{
+		if( my_rank == 0 )
+		{
+			fprintf(stderr, "Cannot write %s \n", file_name);
+		}
+		MPI_Abort(MPI_COMM_WORLD, 1);
+	}
+
+	/* Read only, no distribution */
+	if( my_rank == 0 )
+	{
+		read_seconds = Read_file(file_name);
+	}
+
+	MPI_Barrier(MPI_COMM_WORLD);
+	start = MPI_Wtime();
+	ok = Load_vector(file_name, 0, MPI_COMM_WORLD, &v);
+	elapsed = MPI_Wtime() - start;
+	MPI_Reduce(&elapsed, &load_seconds, 1, MPI_DOUBLE, MPI_MAX, 0, MPI_COMM_WORLD);
+	if( !ok )
+	{
+		if( my_rank == 0 )
+		{
+			fprintf(stderr, "Cannot load %s \n", file_name);
+		}
+		MPI_Abort(MPI_COMM_WORLD, 1);
+	}
+
+	for( i = 0 ; i < v.local_n ; i++ )
+	{
+		if( v.data[i] != (float) ((v.first + i) % 1000003) )
+		{
+			ok = 0;
+			break;
+		}
+	}
+	MPI_Reduce(&ok, &all_ok, 1, MPI_INT, MPI_MIN, 0, MPI_COMM_WORLD);
+
+	if( my_rank == 0 )
+	{
+		printf("n = %lld , p = %d , %.1f MB \n", (long long) v.global_n, no_of_process,
+				v.global_n * sizeof(float) / 1.0e6);
+		printf("Read only   : %e s , %8.2f MB/s \n", read_seconds, v.global_n * sizeof(float) / read_seconds / 1.0e6);
+		printf("Load_vector : %e s , %8.2f MB/s \n", load_seconds, v.global_n * sizeof(float) / load_seconds / 1.0e6);
+		printf("Every element in place : %s \n", all_ok ? "yes" : "no");
+	}
+
+	Vector_free(&v);
+	MPI_Finalize();
+
+	return 0;
+}
+
+/*
+ * Process 0 reads the file name and the order of the vector
+ */
+void Get_data(char file_name[],	/* out */
+			int64_t *n_ptr,		/* out */
+			int my_rank			/* in */
+			)
+{
+	long long n = 0;
+
+	if( my_rank == 0 )
+	{
+		printf("Enter the file name and the order of the vector\n");
+		scanf("%255s %lld", file_name, &n);
+	}
+
+	MPI_Bcast(file_name, 256, MPI_CHAR, 0, MPI_COMM_WORLD);
+	MPI_Bcast(&n, 1, MPI_LONG_LONG, 0, MPI_COMM_WORLD);
+	*n_ptr = n;
+}
+
+/*
+ * Writes x(i) = i % 1000003 for i < n, LOAD_CHUNK floats at a time
+ */
+int Write_file(const char file_name[],	/* in */
+			int64_t n					/* in */
+			)
+{
+	FILE *fp = fopen(file_name, "wb");
+	float *buffer;
+	int64_t start, i;
+	int count;
+	int ok = 1;
+
+	if( fp == NULL )
+	{
+		return 0;
+	}
+	buffer = malloc(LOAD_CHUNK * sizeof(float));
+
+	for( start = 0 ; start < n && ok ; start += LOAD_CHUNK )
+	{
+		count = (n - start < LOAD_CHUNK) ? (int) (n - start) : LOAD_CHUNK;
+		for( i = 0 ; i < count ; i++ )
+		{
+			buffer[i] = (float) ((start + i) % 1000003);
+		}
+		ok = (fwrite(buffer, sizeof(float), count, fp) == (size_t) count);
+	}
+
+	free(buffer);
+	return (fclose(fp) == 0) && ok;
+}
+
+/*
+ * Time to read the whole file LOAD_CHUNK floats at a time
+ */
+double Read_file(const char file_name[]	/* in */)
+{
+	FILE *fp = fopen(file_name, "rb");
+	float *buffer = malloc(LOAD_CHUNK * sizeof(float));
+	double start = MPI_Wtime();
+
+	while( fread(buffer, sizeof(float), LOAD_CHUNK, fp) == LOAD_CHUNK )
+	{
+		;
+	}
+
+	fclose(fp);
+	free(buffer);
+	return MPI_Wtime() - start;
+}
@@ -0,0 +1,339 @@
+/*
+ * cio.c
+ *
+ *  Created on: 16-Oct-2026
+ *      Author: prateek
+ *      Pg : 142
+ *      Desc : Collective functions for basic I/O operations.
+ *      	The rank of a process that can do I/O is cached with a communicator
+ *      	under IO_KEY. Cscanf reads on that process and broadcasts the line,
+ *      	Cprintf collects the output of every process on it.
+ *
+ *      NOTE : Port of chap08/cio.c. The MPI-1 attribute calls are replaced by their
+ *      	MPI-2 versions, gets() by fgets() and the home made vsscanf by the C library one.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdarg.h>
+#include <string.h>
+#include "cio.h"
+
+/* All process ranks < HUGE */
+#define HUGE 32768
+
+/* Key identifying the I/O rank attribute */
+int IO_KEY = MPI_KEYVAL_INVALID;
+
+/* BUFSIZ is defined in stdio.h */
+static char io_buf[BUFSIZ];
+
+static int *error_buf = NULL;
+static int error_bufsiz = 0;
+
+/*
+ * Create IO_KEY the first time it is needed
+ */
+static void Create_io_key(void)
+{
+	if( IO_KEY == MPI_KEYVAL_INVALID )
+	{
+		MPI_Comm_create_keyval(MPI_COMM_DUP_FN, MPI_COMM_NULL_DELETE_FN, &IO_KEY, NULL);
+	}
+}
+
+/*
+ * Cache io_rank with comm under IO_KEY
+ */
+static void Put_io_rank(MPI_Comm comm,	/* in/out */
+			int io_rank					/* in */
+			)
+{
+	int *io_rank_ptr = malloc(sizeof(int));
+
+	*io_rank_ptr = io_rank;
+	MPI_Comm_set_attr(comm, IO_KEY, io_rank_ptr);
+}
+
+/********************************************************************/
+/* Function Copy_attr
+ * Get the I/O rank cached with comm1 under KEY (IO_KEY or MPI_IO) and
+ * cache the corresponding rank of comm2 with comm2 under IO_KEY.
+ * Returns 0 if a valid rank was cached, else NO_IO_ATTR.
+ * NOTE : Collective over comm2 when comm1 and comm2 differ.
+ ********************************************************************/
+static int Copy_attr(MPI_Comm comm1,	/* in */
+			MPI_Comm comm2,				/* in/out */
+			int KEY						/* in */
+			)
+{
+	int *io_rank_ptr;
+	int flag;
+	int temp_rank;
+	int io_rank;
+	int equal_comm;
+	MPI_Group group1, group2;
+
+	MPI_Comm_get_attr(comm1, KEY, &io_rank_ptr, &flag);
+
+	if( flag == 0 || *io_rank_ptr == MPI_PROC_NULL )
+	{
+		Put_io_rank(comm2, MPI_PROC_NULL);
+		return NO_IO_ATTR;
+	}
+	if( *io_rank_ptr == MPI_ANY_SOURCE )
+	{
+		/* Anyone can do I/O, use process 0 */
+		Put_io_rank(comm2, 0);
+		return 0;
+	}
+
+	MPI_Comm_compare(comm1, comm2, &equal_comm);
+	if( equal_comm == MPI_IDENT )
+	{
+		if( KEY != IO_KEY )
+		{
+			Put_io_rank(comm2, *io_rank_ptr);
+		}
+		return 0;
+	}
+
+	/* Is the rank valid in comm2 ? Different processes may get different answers, take the min */
+	MPI_Comm_group(comm1, &group1);
+	MPI_Comm_group(comm2, &group2);
+	MPI_Group_translate_ranks(group1, 1, io_rank_ptr, group2, &temp_rank);
+	MPI_Group_free(&group1);
+	MPI_Group_free(&group2);
+
+	if( temp_rank == MPI_UNDEFINED )
+	{
+		temp_rank = HUGE;
+	}
+	MPI_Allreduce(&temp_rank, &io_rank, 1, MPI_INT, MPI_MIN, comm2);
+
+	if( io_rank < HUGE )
+	{
+		Put_io_rank(comm2, io_rank);
+		return 0;
+	}
+
+	Put_io_rank(comm2, MPI_PROC_NULL);
+	return NO_IO_ATTR;
+}
+
+/********************************************************************/
+/* Function Cache_io_rank
+ * Find a process of io_comm that can do I/O and cache its rank.
+ * First look for a rank already cached with io_comm or orig_comm, then
+ * fall back on the MPI_IO attribute of MPI_COMM_WORLD.
+ * Returns 0 if a rank was cached, else NO_IO_ATTR.
+ ********************************************************************/
+int Cache_io_rank(MPI_Comm orig_comm,	/* in */
+			MPI_Comm io_comm			/* in/out */
+			)
+{
+	int *io_rank_ptr;
+	int flag;
+
+	Create_io_key();
+
+	MPI_Comm_get_attr(io_comm, IO_KEY, &io_rank_ptr, &flag);
+	if( flag != 0 && *io_rank_ptr != MPI_PROC_NULL )
+	{
+		return 0;
+	}
+
+	if( Copy_attr(orig_comm, io_comm, IO_KEY) == 0 )
+	{
+		return 0;
+	}
+
+	return Copy_attr(MPI_COMM_WORLD, io_comm, MPI_IO);
+}
+
+/*
+ * Get the I/O rank cached with io_comm, caching one from MPI_COMM_WORLD if needed
+ */
+int Get_io_rank(MPI_Comm io_comm,	/* in */
+			int *io_rank_ptr		/* out */
+			)
+{
+	int *temp_ptr;
+	int flag;
+
+	Create_io_key();
+
+	MPI_Comm_get_attr(io_comm, IO_KEY, &temp_ptr, &flag);
+	if( flag == 0 || *temp_ptr == MPI_PROC_NULL )
+	{
+		if( Copy_attr(MPI_COMM_WORLD, io_comm, MPI_IO) == NO_IO_ATTR )
+		{
+			return NO_IO_ATTR;
+		}
+		MPI_Comm_get_attr(io_comm, IO_KEY, &temp_ptr, &flag);
+	}
+
+	*io_rank_ptr = *temp_ptr;
+	return 0;
+}
+
+/********************************************************************/
+/* Function Cscanf
+ * The I/O process prints prompt (if not NULL), reads one line and
+ * broadcasts it. Every process then converts it with format.
+ * Returns the no of items converted ( 0 for a blank line ), EOF only
+ * if the I/O process reached the end of its input, or NO_IO_ATTR.
+ ********************************************************************/
+int Cscanf(MPI_Comm io_comm,	/* in */
+			char *prompt,		/* in */
+			char *format,		/* in */
+			...					/* out */
+			)
+{
+	va_list args;
+	int my_io_rank;
+	int root;
+	int at_end = 0;
+	int count;
+
+	if( Get_io_rank(io_comm, &root) == NO_IO_ATTR )
+	{
+		return NO_IO_ATTR;
+	}
+	MPI_Comm_rank(io_comm, &my_io_rank);
+
+	if( my_io_rank == root )
+	{
+		if( prompt != NULL )
+		{
+			printf("%s\n", prompt);
+			fflush(stdout);
+		}
+		if( fgets(io_buf, BUFSIZ, stdin) == NULL )
+		{
+			at_end = 1;
+		}
+	}
+
+	MPI_Bcast(&at_end, 1, MPI_INT, root, io_comm);
+	if( at_end )
+	{
+		return EOF;
+	}
+	MPI_Bcast(io_buf, BUFSIZ, MPI_CHAR, root, io_comm);
+
+	va_start(args, format);
+	count = vsscanf(io_buf, format, args);
+	va_end(args);
+
+	/* vsscanf gives EOF for a blank line too; that is not the end */
+	return (count == EOF) ? 0 : count;
+}
+
+/********************************************************************/
+/* Function Cprintf
+ * Prints data from all processes in rank order. The format must be
+ * the same on each process.
+ * Returns 0, or NO_IO_ATTR if no I/O rank is cached.
+ ********************************************************************/
+int Cprintf(MPI_Comm io_comm,	/* in */
+			char *title,		/* in */
+			char *format,		/* in */
+			...					/* in */
+			)
+{
+	va_list args;
+	int my_io_rank;
+	int io_p;
+	int root;
+	int q;
+	MPI_Status status;
+
+	if( Get_io_rank(io_comm, &root) == NO_IO_ATTR )
+	{
+		return NO_IO_ATTR;
+	}
+	MPI_Comm_rank(io_comm, &my_io_rank);
+	MPI_Comm_size(io_comm, &io_p);
+
+	if( my_io_rank != root )
+	{
+		va_start(args, format);
+		vsnprintf(io_buf, BUFSIZ, format, args);
+		va_end(args);
+
+		MPI_Send(io_buf, strlen(io_buf) + 1, MPI_CHAR, root, 0, io_comm);
+		return 0;
+	}
+
+	printf("%s\n", title);
+	for( q = 0 ; q < io_p ; q++ )
+	{
+		if( q == root )
+		{
+			va_start(args, format);
+			vsnprintf(io_buf, BUFSIZ, format, args);
+			va_end(args);
+		}
+		else
+		{
+			MPI_Recv(io_buf, BUFSIZ, MPI_CHAR, q, 0, io_comm, &status);
+		}
+		printf("Process %d > %s\n", q, io_buf);
+	}
+	printf("\n");
+	fflush(stdout);
+
+	return 0;
+}
+
+/********************************************************************/
+/* Function Cerror_test
+ * Gathers error codes from all processes. If any is negative the I/O
+ * process reports it and everyone aborts.
+ * Returns 0, or NO_IO_ATTR if no I/O rank is cached.
+ ********************************************************************/
+int Cerror_test(MPI_Comm io_comm,	/* in */
+			char *routine_name,		/* in */
+			int error				/* in */
+			)
+{
+	int io_p;
+	int io_process;
+	int my_io_rank;
+	int error_count = 0;
+	int q;
+
+	if( Get_io_rank(io_comm, &io_process) == NO_IO_ATTR )
+	{
+		return NO_IO_ATTR;
+	}
+	MPI_Comm_size(io_comm, &io_p);
+	MPI_Comm_rank(io_comm, &my_io_rank);
+
+	if( error_bufsiz < io_p )
+	{
+		error_buf = realloc(error_buf, io_p * sizeof(int));
+		error_bufsiz = io_p;
+	}
+
+	MPI_Allgather(&error, 1, MPI_INT, error_buf, 1, MPI_INT, io_comm);
+	for( q = 0 ; q < io_p ; q++ )
+	{
+		if( error_buf[q] < 0 )
+		{
+			error_count++;
+			if( my_io_rank == io_process )
+			{
+				fprintf(stderr, "Error in %s on process %d\n", routine_name, q);
+				fflush(stderr);
+			}
+		}
+	}
+
+	if( error_count > 0 )
+	{
+		MPI_Abort(MPI_COMM_WORLD, -1);
+	}
+
+	return 0;
+}
@@ -0,0 +1,57 @@
+/*
+ * cio.h
+ *
+ *  Created on: 16-Oct-2026
+ *      Author: prateek
+ *      Pg : 142
+ *      Desc : Header for cio.c -- basic collective I/O functions.
+ *      	Port of chap08/cio.h to MPI-2 attribute calls and the C library vsscanf.
+ */
+#ifndef CIO_H
+#define CIO_H
+
+#include <mpi/mpi.h>
+
+#define NO_IO_ATTR -1
+
+/* Key of the I/O rank attribute cached with communicators */
+extern int IO_KEY;
+
+/* Cache the rank of a process that can do I/O with io_comm. Collective over io_comm */
+int Cache_io_rank(
+		MPI_Comm orig_comm,		/* in */
+		MPI_Comm io_comm		/* in/out */
+		);
+
+/* Get the I/O rank cached with io_comm */
+int Get_io_rank(
+		MPI_Comm io_comm,		/* in */
+		int *io_rank_ptr		/* out */
+		);
+
+/* I/O process prints prompt, reads one line and broadcasts it. Returns the
+ * no of items converted ( 0 for a blank line ), EOF only at end of input
+ * or NO_IO_ATTR */
+int Cscanf(
+		MPI_Comm io_comm,		/* in */
+		char *prompt,			/* in */
+		char *format,			/* in */
+		...						/* out */
+		);
+
+/* I/O process prints title and the output of every process in rank order */
+int Cprintf(
+		MPI_Comm io_comm,		/* in */
+		char *title,			/* in */
+		char *format,			/* in */
+		...						/* in */
+		);
+
+/* Abort everyone if any process passes a negative error */
+int Cerror_test(
+		MPI_Comm io_comm,		/* in */
+		char *routine_name,		/* in */
+		int error				/* in */
+		);
+
+#endif /* CIO_H */
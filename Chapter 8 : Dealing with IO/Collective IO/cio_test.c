@@ -0,0 +1,48 @@
+/*
+ * cio_test.c
+ *
+ *  Created on: 16-Oct-2026
+ *      Author: prateek
+ *      Pg : 143
+ *      Desc : Tests the functions in cio.c on MPI_COMM_WORLD and on the even/odd
+ *      	communicators made by MPI_Comm_split.
+ *      Input : An int, a float and a string, three times
+ *      Output : What each process read
+ */
+#include <stdio.h>
+#include <mpi/mpi.h>
+#include "cio.h"
+
+int main(int argc, char **argv)
+{
+	MPI_Comm io_comm;		// Duplicate of MPI_COMM_WORLD used for I/O
+	MPI_Comm split_comm;	// Even or odd ranks
+	int my_rank;
+	int ival;
+	float fval;
+	char sval[100];
+
+	MPI_Init(&argc, &argv);
+	MPI_Comm_rank(MPI_COMM_WORLD, &my_rank);
+
+	MPI_Comm_dup(MPI_COMM_WORLD, &io_comm);
+	Cache_io_rank(MPI_COMM_WORLD, io_comm);
+
+	Cscanf(io_comm, "Enter an int, a float, and a string", "%d %f %99s", &ival, &fval, sval);
+	Cprintf(io_comm, "io_comm read:", "%d %f %s", ival, fval, sval);
+
+	/* The I/O rank of io_comm is carried over to both halves */
+	MPI_Comm_split(io_comm, my_rank % 2, my_rank, &split_comm);
+	Cache_io_rank(io_comm, split_comm);
+
+	Cscanf(split_comm, "Enter an int, a float, and a string", "%d %f %99s", &ival, &fval, sval);
+	Cprintf(split_comm, (my_rank % 2) ? "odd_comm read:" : "even_comm read:", "%d %f %s", ival, fval, sval);
+
+	Cerror_test(io_comm, "main", 0);
+
+	MPI_Comm_free(&split_comm);
+	MPI_Comm_free(&io_comm);
+	MPI_Finalize();
+
+	return 0;
+}
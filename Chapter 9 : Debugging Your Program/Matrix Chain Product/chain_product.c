@@ -0,0 +1,383 @@
+/*
+ * chain_product.c
+ *
+ *  Created on: 16-Oct-2026
+ *      Author: prateek
+ *      Pg : 188
+ *      Desc : The product M_0 M_1 ... M_(p-1) of one k x k matrix from each process.
+ *      	chap09/mat_mult.c receives the factors on process 0 from MPI_ANY_SOURCE,
+ *      	so it multiplies them in whatever order they arrive, and matrix product
+ *      	does not commute. Even in rank order it is p - 1 multiplications one after
+ *      	the other on one process. Here the product is a reduction in O(log p)
+ *      	steps which keeps the order of the factors, done two ways.
+ *      Input :
+ *      	k : order of the matrices
+ *      Output :
+ *      	For the serial product on process 0, MPI_Reduce with a non-commutative
+ *      	MPI_Op and the binomial tree, the time ( slowest process ) and whether the
+ *      	product is right.
+ *
+ *      Algorithm:
+ *      1) serial : process 0 receives M_1, M_2, ... in rank order and multiplies
+ *         them into the product, as mat_mult.c should have done.
+ *      2) reduce : a k x k contiguous datatype and an MPI_Op created with
+ *         commute = 0. MPI then only combines neighbouring ranges of ranks, with
+ *         the lower ranks on the left, so the order is kept whatever the tree.
+ *      3) tree : a binomial tree by hand. After step s process r, if it is a
+ *         multiple of 2^s, holds M_r ... M_(r + 2^s - 1). In step s + 1 the
+ *         processes with bit s set send their product to r - 2^s, which multiplies
+ *         it on the right.
+ *
+ *      NOTES:
+ *      	1. Each factor is a signed permutation matrix : row i of M_r has one
+ *      	   nonzero, +-1, in column perm_r(i), a shift for even r and a reflection
+ *      	   for odd r. These do not commute, so any change in the order of the
+ *      	   factors gives a different product, and every product is exact. The
+ *      	   right product is worked out by following each row through the perms.
+ *      	2. Block_mult does not know the matrices are sparse, it takes k^3
+ *      	   multiply-adds as for any other factors.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <mpi/mpi.h>
+
+#define CHAIN_TAG		7501
+#define MULT_BLOCK		64		/* Rows and columns per block : 3 blocks of 16 KB fit in L2 */
+#define REPS			5
+
+void Get_data(int *k_ptr, int my_rank);
+void Generate_factor(float M[], int k, int rank);
+int Perm(int i, int k, int rank);
+float Sign(int i, int rank);
+void Block_mult(const float A[], const float B[], float C[], int k);
+void Chain_mult_op(void *in, void *inout, int *len, MPI_Datatype *datatype);
+void Chain_serial(float product[], int k, MPI_Comm comm);
+void Chain_tree(float product[], int k, MPI_Comm comm);
+int Check_product(const float product[], int k, int p);
+
+int main(int argc, char **argv)
+{
+	int my_rank;
+	int p;
+	int k;
+	float *factor, *product;
+	MPI_Datatype matrix_mpi_t;
+	MPI_Op chain_mult;
+	double start, elapsed, seconds[3];
+	int right[3];
+	int rep;
+
+	MPI_Init(&argc, &argv);
+	MPI_Comm_size(MPI_COMM_WORLD, &p);
+	MPI_Comm_rank(MPI_COMM_WORLD, &my_rank);
+
+	Get_data(&k, my_rank);
+
+	factor = malloc(((size_t) k * k + 1) * sizeof(float));
+	product = malloc(((size_t) k * k + 1) * sizeof(float));
+	Generate_factor(factor, k, my_rank);
+
+	MPI_Type_contiguous(k * k, MPI_FLOAT, &matrix_mpi_t);
+	MPI_Type_commit(&matrix_mpi_t);
+	MPI_Op_create(Chain_mult_op, 0, &chain_mult);
+
+	/* 1) serial */
+	MPI_Barrier(MPI_COMM_WORLD);
+	start = MPI_Wtime();
+	for( rep = 0 ; rep < REPS ; rep++ )
+	{
+		memcpy(product, factor, (size_t) k * k * sizeof(float));
+		Chain_serial(product, k, MPI_COMM_WORLD);
+	}
+	elapsed = (MPI_Wtime() - start) / REPS;
+	MPI_Reduce(&elapsed, &seconds[0], 1, MPI_DOUBLE, MPI_MAX, 0, MPI_COMM_WORLD);
+	right[0] = (my_rank == 0) ? Check_product(product, k, p) : 0;
+
+	/* 2) reduce */
+	MPI_Barrier(MPI_COMM_WORLD);
+	start = MPI_Wtime();
+	for( rep = 0 ; rep < REPS ; rep++ )
+	{
+		MPI_Reduce(factor, product, 1, matrix_mpi_t, chain_mult, 0, MPI_COMM_WORLD);
+	}
+	elapsed = (MPI_Wtime() - start) / REPS;
+	MPI_Reduce(&elapsed, &seconds[1], 1, MPI_DOUBLE, MPI_MAX, 0, MPI_COMM_WORLD);
+	right[1] = (my_rank == 0) ? Check_product(product, k, p) : 0;
+
+	/* 3) tree */
+	MPI_Barrier(MPI_COMM_WORLD);
+	start = MPI_Wtime();
+	for( rep = 0 ; rep < REPS ; rep++ )
+	{
+		memcpy(product, factor, (size_t) k * k * sizeof(float));
+		Chain_tree(product, k, MPI_COMM_WORLD);
+	}
+	elapsed = (MPI_Wtime() - start) / REPS;
+	MPI_Reduce(&elapsed, &seconds[2], 1, MPI_DOUBLE, MPI_MAX, 0, MPI_COMM_WORLD);
+	right[2] = (my_rank == 0) ? Check_product(product, k, p) : 0;
+
+	if( my_rank == 0 )
+	{
+		printf("k = %d , p = %d \n", k, p);
+		printf("serial : %e s , %d multiplications on process 0 , product %s \n", seconds[0], p - 1,
+				right[0] ? "right" : "WRONG");
+		printf("reduce : %e s , non-commutative MPI_Op , product %s \n", seconds[1],
+				right[1] ? "right" : "WRONG");
+		printf("tree   : %e s , %d steps , product %s \n", seconds[2], (int) ceil(log2(p)),
+				right[2] ? "right" : "WRONG");
+	}
+
+	MPI_Op_free(&chain_mult);
+	MPI_Type_free(&matrix_mpi_t);
+	free(factor);
+	free(product);
+	MPI_Finalize();
+
+	return 0;
+}
+
+/*
+ * Process 0 reads the order of the matrices and broadcasts it
+ */
+void Get_data(int *k_ptr,	/* out */
+			int my_rank		/* in */
+			)
+{
+	if( my_rank == 0 )
+	{
+		printf("Enter the order of the matrices\n");
+		scanf("%d", k_ptr);
+	}
+
+	MPI_Bcast(k_ptr, 1, MPI_INT, 0, MPI_COMM_WORLD);
+}
+
+/*
+ * M_rank ( see NOTES )
+ */
+void Generate_factor(float M[],	/* out */
+			int k,				/* in */
+			int rank			/* in */
+			)
+{
+	int i;
+
+	memset(M, 0, (size_t) k * k * sizeof(float));
+	for( i = 0 ; i < k ; i++ )
+	{
+		M[(size_t) i * k + Perm(i, k, rank)] = Sign(i, rank);
+	}
+}
+
+/*
+ * Column of the nonzero in row i of M_rank
+ */
+int Perm(int i,		/* in */
+			int k,		/* in */
+			int rank	/* in */
+			)
+{
+	return (rank % 2 == 0) ? (i + rank / 2 + 1) % k : (k - 1 - i + rank / 2) % k;
+}
+
+/*
+ * Value of the nonzero in row i of M_rank
+ */
+float Sign(int i,	/* in */
+			int rank	/* in */
+			)
+{
+	return ((i + rank) % 3 == 0) ? -1.0f : 1.0f;
+}
+
+/********************************************************************/
+/* Function Block_mult
+ * C = A B for k x k matrices stored by rows. The loops go over blocks
+ * of MULT_BLOCK x MULT_BLOCK, so the blocks of A, B and C in use stay
+ * in cache. Inside a block the order is i, l, j : A(i,l) is kept in a
+ * register and the innermost loop runs along rows of B and C, which is
+ * one SIMD multiply-add per vector of them.
+ ********************************************************************/
+void Block_mult(const float A[],	/* in */
+			const float B[],		/* in */
+			float C[],				/* out */
+			int k					/* in */
+			)
+{
+	int i_start, l_start, j_start;
+	int i_end, l_end, j_end;
+	int i, l, j;
+	float a;
+
+	memset(C, 0, (size_t) k * k * sizeof(float));
+
+	for( i_start = 0 ; i_start < k ; i_start += MULT_BLOCK )
+	{
+		i_end = (i_start + MULT_BLOCK < k) ? i_start + MULT_BLOCK : k;
+		for( l_start = 0 ; l_start < k ; l_start += MULT_BLOCK )
+		{
+			l_end = (l_start + MULT_BLOCK < k) ? l_start + MULT_BLOCK : k;
+			for( j_start = 0 ; j_start < k ; j_start += MULT_BLOCK )
+			{
+				j_end = (j_start + MULT_BLOCK < k) ? j_start + MULT_BLOCK : k;
+
+				for( i = i_start ; i < i_end ; i++ )
+				{
+					for( l = l_start ; l < l_end ; l++ )
+					{
+						a = A[(size_t) i * k + l];
+#pragma omp simd
+						for( j = j_start ; j < j_end ; j++ )
+						{
+							C[(size_t) i * k + j] += a * B[(size_t) l * k + j];
+						}
+					}
+				}
+			}
+		}
+	}
+}
+
+/********************************************************************/
+/* Function Chain_mult_op
+ * The MPI_Op : inout = in inout for len matrices. For an operator
+ * created with commute = 0, in comes from the lower ranks, so it is
+ * the left factor. k is recovered from the size of the datatype.
+ ********************************************************************/
+void Chain_mult_op(void *in,		/* in */
+			void *inout,			/* in/out */
+			int *len,				/* in */
+			MPI_Datatype *datatype	/* in */
+			)
+{
+	float *in_matrices = (float *) in;
+	float *inout_matrices = (float *) inout;
+	float *temp;
+	int size, k, m;
+
+	MPI_Type_size(*datatype, &size);
+	k = (int) lround(sqrt((double) size / sizeof(float)));
+	temp = malloc(((size_t) k * k + 1) * sizeof(float));
+
+	for( m = 0 ; m < *len ; m++ )
+	{
+		Block_mult(&in_matrices[(size_t) m * k * k], &inout_matrices[(size_t) m * k * k], temp, k);
+		memcpy(&inout_matrices[(size_t) m * k * k], temp, (size_t) k * k * sizeof(float));
+	}
+
+	free(temp);
+}
+
+/*
+ * mat_mult.c done in rank order : process 0 multiplies M_1 .. M_(p-1)
+ * into product one at a time. product holds my factor on entry
+ */
+void Chain_serial(float product[],	/* in/out */
+			int k,					/* in */
+			MPI_Comm comm			/* in */
+			)
+{
+	int p, my_rank;
+	float *factor, *temp;
+	int source;
+
+	MPI_Comm_size(comm, &p);
+	MPI_Comm_rank(comm, &my_rank);
+
+	if( my_rank != 0 )
+	{
+		MPI_Send(product, k * k, MPI_FLOAT, 0, CHAIN_TAG, comm);
+		return;
+	}
+
+	factor = malloc(((size_t) k * k + 1) * sizeof(float));
+	temp = malloc(((size_t) k * k + 1) * sizeof(float));
+	for( source = 1 ; source < p ; source++ )
+	{
+		MPI_Recv(factor, k * k, MPI_FLOAT, source, CHAIN_TAG, comm, MPI_STATUS_IGNORE);
+		Block_mult(product, factor, temp, k);
+		memcpy(product, temp, (size_t) k * k * sizeof(float));
+	}
+	free(factor);
+	free(temp);
+}
+
+/********************************************************************/
+/* Function Chain_tree
+ * product holds my factor on entry and the whole chain on process 0 on
+ * return.
+ * Algorithm:
+ *     for mask = 1, 2, 4, ... < p :
+ *         if my_rank has the bit mask set :
+ *             send my product to my_rank - mask and stop
+ *         else if my_rank + mask < p :
+ *             receive the product of my_rank + mask .. and multiply
+ *             it on the right of mine
+ ********************************************************************/
+void Chain_tree(float product[],	/* in/out */
+			int k,					/* in */
+			MPI_Comm comm			/* in */
+			)
+{
+	int p, my_rank;
+	float *received, *temp;
+	int mask;
+
+	MPI_Comm_size(comm, &p);
+	MPI_Comm_rank(comm, &my_rank);
+
+	received = malloc(((size_t) k * k + 1) * sizeof(float));
+	temp = malloc(((size_t) k * k + 1) * sizeof(float));
+
+	for( mask = 1 ; mask < p ; mask <<= 1 )
+	{
+		if( my_rank & mask )
+		{
+			MPI_Send(product, k * k, MPI_FLOAT, my_rank - mask, CHAIN_TAG, comm);
+			break;
+		}
+		else if( my_rank + mask < p )
+		{
+			MPI_Recv(received, k * k, MPI_FLOAT, my_rank + mask, CHAIN_TAG, comm, MPI_STATUS_IGNORE);
+			Block_mult(product, received, temp, k);
+			memcpy(product, temp, (size_t) k * k * sizeof(float));
+		}
+	}
+
+	free(received);
+	free(temp);
+}
+
+/*
+ * 1 if product is M_0 M_1 ... M_(p-1) exactly
+ */
+int Check_product(const float product[],	/* in */
+			int k,							/* in */
+			int p							/* in */
+			)
+{
+	int i, j, col, rank;
+	float sign, expected;
+
+	for( i = 0 ; i < k ; i++ )
+	{
+		col = i;
+		sign = 1.0f;
+		for( rank = 0 ; rank < p ; rank++ )
+		{
+			sign *= Sign(col, rank);
+			col = Perm(col, k, rank);
+		}
+		for( j = 0 ; j < k ; j++ )
+		{
+			expected = (j == col) ? sign : 0.0f;
+			if( product[(size_t) i * k + j] != expected )
+			{
+				return 0;
+			}
+		}
+	}
+	return 1;
+}